@@ -38,6 +38,7 @@ BEGIN_EVENT_TABLE(editorFrame, wxFrame)
 	EVT_BUTTON(idModuleGenBtn, editorFrame::OnModuleGen)
 	EVT_LISTBOX(idModuleList, editorFrame::OnModuleSelect)
 	EVT_PG_CHANGED(idModuleProperties, editorFrame::OnModuleProperyGridChange)
+	EVT_COMMAND(wxID_ANY, wxEVT_PREVIEW_READY, editorFrame::OnPreviewReady)
 END_EVENT_TABLE()
 
 editorFrame::editorFrame(wxFrame *frame, const wxString& title)
@@ -127,11 +128,16 @@ editorFrame::editorFrame(wxFrame *frame, const wxString& title)
 	Centre ();
 
 	setChanged (false);
+
+	// if the thread can't be started the previews are rendered synchronously
+	mPreview = new EditorPreviewRenderer(this);
+	mPreview->start ();
 }
 
 
 editorFrame::~editorFrame()
 {
+	delete mPreview;
 }
 
 void editorFrame::OnClose(wxCloseEvent &event)
@@ -203,6 +209,7 @@ void editorFrame::newDoc ()
 	mFileName.Clear();
 	mModuleProps->Clear();
 	mModuleList->Clear();
+	mPreview->cancelAll ();
 	EditorModuleManager::getInstance().clearModules ();
 	updateModuleSelection ();
 	setChanged (false);
@@ -364,6 +371,9 @@ void editorFrame::OnModuleDel(wxCommandEvent& event)
 		{
 			setChanged ();
 			// remove the module
+			EditorModule *module = EditorModuleManager::getInstance().getModule(mModuleList->GetString(id));
+			if (module)
+				mPreview->cancel (module);
 			EditorModuleManager::getInstance().removeModule(mModuleList->GetString(id));
 			// remove it from list
 			mModuleList->Delete (id);
@@ -388,9 +398,9 @@ void editorFrame::OnModuleGen(wxCommandEvent& event)
 			assert (module->validate(mModuleProps));
 			for (int i=0;i<module->getNumberOfSourceModules();++i)
 			{
-				module->getSourceModule(i)->generate (0, 0, 1, 1, 200, 200);
+				mPreview->request (module->getSourceModule(i), 0, 0, 1, 1, 200, 200);
 			}
-			module->generate (0, 0, 1, 1, 200, 200);
+			mPreview->request (module, 0, 0, 1, 1, 200, 200);
 			mCanvas->Refresh ();
 		}
 	}
@@ -446,17 +456,26 @@ void editorFrame::OnModuleProperyGridChange(wxPropertyGridEvent& event)
 	if (module)
 	{
 		setChanged ();
+		// the running preview would read the module while it changes
+		mPreview->cancel (module);
 		module->changeProperty(mModuleProps, event);
 		bool valid = module->validate (mModuleProps);
 		mGenerateBtn->Enable (valid);
 		if (valid)
 		{
-			module->generate (0, 0, 1, 1, 200, 200);
+			mPreview->request (module, 0, 0, 1, 1, 200, 200);
 			mCanvas->Refresh ();
 		}
 	}
 }
 
+void editorFrame::OnPreviewReady(wxCommandEvent& event)
+{
+	EditorPreviewResult *result = (EditorPreviewResult *)event.GetClientData();
+	if (mPreview->accept (result))
+		mCanvas->Refresh ();
+}
+
 EditorModule *editorFrame::forceModuleSelected ()
 {
 	EditorModule *module = EditorModuleManager::getInstance().getModule(mModuleList->GetStringSelection());
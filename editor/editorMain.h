@@ -34,6 +34,7 @@
 #include "editorCanvas.h"
 #include "editorGLCanvas.h"
 #include "editorSizeDlg.h"
+#include "editorPreview.h"
 
 class editorFrame: public wxFrame
 {
@@ -54,6 +55,7 @@ class editorFrame: public wxFrame
 		wxButton *mRenameBtn;
 		wxButton *mRemoveBtn;
 		wxButton *mGenerateBtn;
+		EditorPreviewRenderer *mPreview;
 		wxString mFileName;
 		wxString mSelectedModule;
 		bool mChanged;
@@ -103,6 +105,7 @@ class editorFrame: public wxFrame
 			updateModuleSelection();
 		}
 		void OnModuleProperyGridChange(wxPropertyGridEvent& event);
+		void OnPreviewReady(wxCommandEvent& event);
 		EditorModule *forceModuleSelected ();
 		DECLARE_EVENT_TABLE()
 };
@@ -16,6 +16,7 @@
 //
 
 #include <GL/glew.h>
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 #include <wx/wx.h>
@@ -79,52 +80,9 @@ bool EditorModule::setValid (wxPropertyGrid *pg, const char *name, bool valid)
 	return valid;
 }
 
-void EditorModule::generate (double x, double y, double width, double height, int w, int h)
+void EditorModule::setPreview (int w, int h, unsigned char *pixels)
 {
 	freeImage ();
-	if (!mData)
-	{
-		mData = new double[w*h];
-		try
-		{
-			noisepp::utils::PlaneBuilder2D builder;
-			builder.setDestination(mData);
-			builder.setModule (&getModule());
-			builder.setSize (w, h);
-			builder.setBounds(0, 0, width, height);
-			builder.build ();
-		}
-		catch (std::exception &e)
-		{
-			std::cout << "exception: " << e.what() << std::endl;
-		}
-	}
-
-	unsigned char *pixels = (unsigned char *)malloc(w*h*3);
-
-	noisepp::utils::Image img;
-	img.create (w, h);
-
-	noisepp::utils::GradientRenderer gradients;
-	gradients.addGradient (-1.0, noisepp::utils::ColourValue(0.0f, 0.0f, 0.0f));
-	gradients.addGradient ( 1.0, noisepp::utils::ColourValue(1.0f, 1.0f, 1.0f));
-	/*gradients.addGradient (-1.0, noisepp::utils::ColourValue(0.0f, 0.0f, 0.2f));
-	gradients.addGradient (-0.8, noisepp::utils::ColourValue(0.0f, 0.0f, 0.6f));
-	gradients.addGradient ( 0.0, noisepp::utils::ColourValue(1.0f, 0.0f, 0.0f));
-	gradients.addGradient ( 0.6, noisepp::utils::ColourValue(1.0f, 1.0f, 0.0f));
-	gradients.addGradient ( 1.0, noisepp::utils::ColourValue(1.0f, 1.0f, 1.0f));*/
-	/*gradients.addGradient (-1.0000, noisepp::utils::ColourValue (  0,   0, 128)/255.f); // deeps
-	gradients.addGradient (-0.2500, noisepp::utils::ColourValue (  0,   0, 255)/255.f); // shallow
-	gradients.addGradient ( 0.0000, noisepp::utils::ColourValue (  0, 128, 255)/255.f); // shore
-	gradients.addGradient ( 0.0625, noisepp::utils::ColourValue (240, 240,  64)/255.f); // sand
-	gradients.addGradient ( 0.1250, noisepp::utils::ColourValue ( 32, 160,   0)/255.f); // grass
-	gradients.addGradient ( 0.3750, noisepp::utils::ColourValue (224, 224,   0)/255.f); // dirt
-	gradients.addGradient ( 0.7500, noisepp::utils::ColourValue (128, 128, 128)/255.f); // rock
-	gradients.addGradient ( 1.0000, noisepp::utils::ColourValue (255, 255, 255)/255.f); // snow*/
-	gradients.renderImage (img, mData);
-
-	std::memcpy (pixels, img.getPixelData(), w*h*3);
-
 	mImage = new wxImage (w, h, pixels);
 	mBitmap = new wxBitmap (*mImage);
 	/*glGenTextures (1, &mTexture);
@@ -144,6 +102,20 @@ void EditorModule::generate (double x, double y, double width, double height, in
 	glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP);*/
 }
 
+bool EditorModule::hasData (const double *bounds, int w, int h) const
+{
+	return mData && mWidth == w && mHeight == h && std::equal (bounds, bounds+4, mBounds);
+}
+
+void EditorModule::setData (double *data, const double *bounds, int w, int h)
+{
+	freeData ();
+	mData = data;
+	mWidth = w;
+	mHeight = h;
+	std::copy (bounds, bounds+4, mBounds);
+}
+
 void EditorModule::appendQualityProperty (wxPropertyGrid *pg, int quality)
 {
 	wxArrayString qualityArr;
@@ -218,9 +190,8 @@ void EditorModule::onPropertyChange (wxPropertyGrid *pg, wxPropertyGridEvent& ev
 
 void EditorModule::changeProperty (wxPropertyGrid *pg, wxPropertyGridEvent& event)
 {
-	freeData ();
 	freeImage ();
-	EditorModuleManager::getInstance().freeChildrenData (this);
+	EditorModuleManager::getInstance().markDirty (this);
 	onPropertyChange (pg, event);
 }
 
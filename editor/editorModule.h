@@ -28,10 +28,12 @@
 #include <xml/tinyxml.h>
 
 class EditorModuleManager;
+class EditorPreviewRenderer;
 
 class EditorModule
 {
 	friend class EditorModuleManager;
+	friend class EditorPreviewRenderer;
 
 	public:
 		EditorModule(int sourceModules=0);
@@ -43,7 +45,6 @@ class EditorModule
 		virtual bool readProperties (TiXmlElement *element) = 0;
 		virtual ~EditorModule();
 
-		void generate (double x, double y, double width, double height, int w, int h);
 		wxImage *getImage () const
 		{
 			return mImage;
@@ -92,6 +93,7 @@ class EditorModule
 		int mSourceModuleCount;
 	private:
 		int mWidth, mHeight;
+		double mBounds[4];
 		wxImage *mImage;
 		wxBitmap *mBitmap;
 		GLuint mTexture;
@@ -100,6 +102,9 @@ class EditorModule
 
 		void freeData ();
 		void freeImage ();
+		void setPreview (int w, int h, unsigned char *pixels);
+		bool hasData (const double *bounds, int w, int h) const;
+		void setData (double *data, const double *bounds, int w, int h);
 };
 
 #endif // EDITORMODULE_H
@@ -242,15 +242,20 @@ bool EditorModuleManager::readDoc (TiXmlElement *root)
 	return true;
 }
 
-void EditorModuleManager::freeChildrenData (EditorModule *module)
+void EditorModuleManager::markDirty (EditorModule *module)
 {
+	// the data of a module is only kept while it's up to date, so freeing it marks the module dirty
+	module->freeData ();
 	for (ModuleMap::iterator it=mModules.begin();it!=mModules.end();++it)
 	{
 		assert (it->second);
 		for (size_t i=0;i<it->second->getModule().getSourceModuleCount();++i)
 		{
 			if (it->second->getModule().getSourceModule (i) == &module->getModule())
-				it->second->freeData ();
+			{
+				markDirty (it->second);
+				break;
+			}
 		}
 	}
 }
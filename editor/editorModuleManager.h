@@ -67,7 +67,7 @@ class EditorModuleManager
 		void writeToDoc (TiXmlElement *root);
 		bool readDoc (TiXmlElement *root);
 
-		void freeChildrenData (EditorModule *module);
+		void markDirty (EditorModule *module);
 };
 
 #endif // EDITORMODULEMANAGER_H
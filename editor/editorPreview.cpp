@@ -0,0 +1,507 @@
+// This file is part of the Noise++ Editor.
+// Copyright (c) 2008, Urs C. Hanselmann
+//
+// The Noise++ Editor is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Noise++ Editor is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Noise++ Editor.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "editorPreview.h"
+#include "editorModule.h"
+#include "NoiseUtils.h"
+
+DEFINE_EVENT_TYPE(wxEVT_PREVIEW_READY)
+
+// Returns the cached data of a source module, the coordinates are the pixel position.
+class EditorPreviewDataElement : public noisepp::PipelineElement2D
+{
+	private:
+		const double *mData;
+		int mWidth;
+
+	public:
+		EditorPreviewDataElement (const double *data, int width) : mData(data), mWidth(width)
+		{
+		}
+		virtual bool checkColumnar () const
+		{
+			return true;
+		}
+		virtual noisepp::Real getValue (noisepp::Real x, noisepp::Real y, noisepp::Cache *cache) const
+		{
+			return noisepp::Real(mData[int(y)*mWidth + int(x)]);
+		}
+};
+
+// Stands in for a source module while the pipeline of a pointwise module is built.
+class EditorPreviewDataModule : public noisepp::Module
+{
+	private:
+		const double *mData;
+		int mWidth;
+
+	public:
+		EditorPreviewDataModule (const double *data, int width) : Module(0), mData(data), mWidth(width)
+		{
+		}
+		noisepp::ElementID addToPipeline (noisepp::Pipeline1D *pipe) const
+		{
+			throw noisepp::NotImplementedException (NOISEPP_CURRENT_FUNCTION);
+		}
+		noisepp::ElementID addToPipeline (noisepp::Pipeline2D *pipe) const
+		{
+			return pipe->addElement (this, new EditorPreviewDataElement(mData, mWidth));
+		}
+		noisepp::ElementID addToPipeline (noisepp::Pipeline3D *pipe) const
+		{
+			throw noisepp::NotImplementedException (NOISEPP_CURRENT_FUNCTION);
+		}
+		// never serialized, there is no module type for it
+		noisepp::ModuleTypeId getType() const { return noisepp::ModuleTypeId(~0); }
+};
+
+EditorPreviewRenderer::EditorPreviewRenderer (wxEvtHandler *handler) : wxThread(wxTHREAD_JOINABLE), mHandler(handler), mJobsAvailable(mMutex), mJobDone(mMutex), mRunningJob(NULL), mExit(false), mStarted(false), mJobCounter(0)
+{
+	assert (mHandler);
+}
+
+EditorPreviewRenderer::~EditorPreviewRenderer ()
+{
+	stop ();
+}
+
+bool EditorPreviewRenderer::start ()
+{
+	assert (!mStarted);
+	if (Create () != wxTHREAD_NO_ERROR || Run () != wxTHREAD_NO_ERROR)
+		return false;
+	mStarted = true;
+	return true;
+}
+
+void EditorPreviewRenderer::stop ()
+{
+	cancelAll ();
+	if (mStarted)
+	{
+		{
+			wxMutexLocker lock(mMutex);
+			mExit = true;
+			mJobsAvailable.Signal ();
+		}
+		Wait ();
+		mStarted = false;
+	}
+}
+
+void EditorPreviewRenderer::request (EditorModule *module, double x, double y, double width, double height, int w, int h)
+{
+	Request request;
+	request.bounds[0] = x;
+	request.bounds[1] = y;
+	request.bounds[2] = width;
+	request.bounds[3] = height;
+	request.w = w;
+	request.h = h;
+	this->request (module, request);
+}
+
+void EditorPreviewRenderer::request (EditorModule *module, const Request &request)
+{
+	assert (module);
+	assert (request.w > 0 && request.h > 0);
+	// a new request makes the previous one of the same module stale
+	cancelJobs (module, false);
+
+	if (module->hasData (request.bounds, request.w, request.h))
+	{
+		module->setPreview (request.w, request.h, colourize (module->mData, request.w, request.h));
+		return;
+	}
+	module->freeData ();
+
+	bool fromSourceData = isPointwise (module);
+	if (fromSourceData)
+	{
+		bool wait = false;
+		for (int i=0;i<module->getNumberOfSourceModules();++i)
+		{
+			EditorModule *source = module->getSourceModule (i);
+			const bool linked = source && &source->getModule() == module->getModule().getSourceModule (i);
+			if (linked && source->hasData (request.bounds, request.w, request.h))
+				continue;
+			fromSourceData = false;
+			wait = linked && isPending (source);
+			if (!wait)
+				break;
+		}
+		if (wait)
+		{
+			mDeferredRequests[module] = request;
+			return;
+		}
+	}
+
+	Job *job = new Job;
+	job->module = module;
+	job->pipeline = NULL;
+	job->request = request;
+	job->cancelled = false;
+	if (!buildPipeline (job, fromSourceData))
+	{
+		freeJob (job);
+		return;
+	}
+	job->id = ++mJobCounter;
+	mCurrentJobs[module] = job->id;
+
+	if (!mStarted)
+	{
+		render (job);
+		freeJob (job);
+		return;
+	}
+
+	wxMutexLocker lock(mMutex);
+	mJobs.push_back (job);
+	mJobsAvailable.Signal ();
+}
+
+bool EditorPreviewRenderer::buildPipeline (Job *job, bool fromSourceData)
+{
+	noisepp::Module &module = job->module->getModule ();
+	const size_t sourceCount = module.getSourceModuleCount ();
+	std::vector<const noisepp::Module*> sources(sourceCount);
+	std::vector<EditorPreviewDataModule*> dataModules;
+	if (fromSourceData)
+	{
+		// the worker gets copies, the cached data of the sources may be freed while it runs
+		const size_t size = size_t(job->request.w) * job->request.h;
+		for (size_t i=0;i<sourceCount;++i)
+		{
+			EditorModule *source = job->module->getSourceModule (int(i));
+			double *data = new double[size];
+			std::memcpy (data, source->mData, size*sizeof(double));
+			job->sourceData.push_back (data);
+			dataModules.push_back (new EditorPreviewDataModule(data, job->request.w));
+			sources[i] = module.getSourceModule (i);
+			module.setSourceModule (i, dataModules[i]);
+		}
+	}
+
+	bool built = true;
+	try
+	{
+		// the pipeline is a copy of the module tree, so the worker never touches the modules
+		job->pipeline = new noisepp::Pipeline2D;
+		noisepp::ElementID id = module.addToPipe (*job->pipeline);
+		job->element = job->pipeline->getElement (id);
+	}
+	catch (std::exception &e)
+	{
+		std::cout << "exception: " << e.what() << std::endl;
+		built = false;
+	}
+
+	for (size_t i=0;i<dataModules.size();++i)
+	{
+		module.setSourceModule (i, sources[i]);
+		delete dataModules[i];
+	}
+	return built;
+}
+
+bool EditorPreviewRenderer::isPending (EditorModule *module) const
+{
+	return mCurrentJobs.find (module) != mCurrentJobs.end() || mDeferredRequests.find (module) != mDeferredRequests.end();
+}
+
+void EditorPreviewRenderer::startDeferredRequests ()
+{
+	for (RequestMap::iterator it=mDeferredRequests.begin();it!=mDeferredRequests.end();)
+	{
+		EditorModule *module = it->first;
+		bool ready = true;
+		for (int i=0;i<module->getNumberOfSourceModules() && ready;++i)
+			ready = !isPending (module->getSourceModule (i));
+		if (ready)
+		{
+			// request() may defer again or start new jobs, so restart the search
+			const Request request = it->second;
+			mDeferredRequests.erase (it);
+			this->request (module, request);
+			it = mDeferredRequests.begin ();
+		}
+		else
+			++it;
+	}
+}
+
+void EditorPreviewRenderer::cancel (EditorModule *module)
+{
+	assert (module);
+	cancelJobs (module, true);
+}
+
+void EditorPreviewRenderer::cancelAll ()
+{
+	cancelJobs (NULL, true);
+}
+
+bool EditorPreviewRenderer::isAffected (EditorModule *jobModule, EditorModule *module, bool dependents) const
+{
+	if (module == NULL || jobModule == module)
+		return true;
+	return dependents && jobModule->getModule().walkTree (&module->getModule());
+}
+
+void EditorPreviewRenderer::cancelJobs (EditorModule *module, bool dependents)
+{
+	for (JobMap::iterator it=mCurrentJobs.begin();it!=mCurrentJobs.end();)
+	{
+		if (isAffected (it->first, module, dependents))
+			mCurrentJobs.erase (it++);
+		else
+			++it;
+	}
+	for (RequestMap::iterator it=mDeferredRequests.begin();it!=mDeferredRequests.end();)
+	{
+		if (isAffected (it->first, module, dependents))
+			mDeferredRequests.erase (it++);
+		else
+			++it;
+	}
+
+	wxMutexLocker lock(mMutex);
+	for (JobQueue::iterator it=mJobs.begin();it!=mJobs.end();)
+	{
+		if (isAffected ((*it)->module, module, dependents))
+		{
+			freeJob (*it);
+			it = mJobs.erase (it);
+		}
+		else
+			++it;
+	}
+	Job *running = mRunningJob;
+	if (running && isAffected (running->module, module, dependents))
+	{
+		// the worker checks the flag after each row, wait until it left the job
+		running->cancelled = true;
+		while (mRunningJob == running)
+			mJobDone.Wait ();
+	}
+}
+
+bool EditorPreviewRenderer::accept (EditorPreviewResult *result)
+{
+	assert (result);
+	JobMap::iterator it = mCurrentJobs.find (result->module);
+	const bool current = (it != mCurrentJobs.end() && it->second == result->job);
+	if (current)
+	{
+		result->module->setPreview (result->width, result->height, result->pixels);
+		result->pixels = NULL;
+		if (result->data)
+		{
+			result->module->setData (result->data, result->bounds, result->width, result->height);
+			result->data = NULL;
+			mCurrentJobs.erase (it);
+			startDeferredRequests ();
+		}
+	}
+	free (result->pixels);
+	delete[] result->data;
+	delete result;
+	return current;
+}
+
+unsigned char *EditorPreviewRenderer::colourize (const double *data, int w, int h)
+{
+	noisepp::utils::Image img;
+	img.create (w, h);
+
+	noisepp::utils::GradientRenderer gradients;
+	gradients.addGradient (-1.0, noisepp::utils::ColourValue(0.0f, 0.0f, 0.0f));
+	gradients.addGradient ( 1.0, noisepp::utils::ColourValue(1.0f, 1.0f, 1.0f));
+	/*gradients.addGradient (-1.0, noisepp::utils::ColourValue(0.0f, 0.0f, 0.2f));
+	gradients.addGradient (-0.8, noisepp::utils::ColourValue(0.0f, 0.0f, 0.6f));
+	gradients.addGradient ( 0.0, noisepp::utils::ColourValue(1.0f, 0.0f, 0.0f));
+	gradients.addGradient ( 0.6, noisepp::utils::ColourValue(1.0f, 1.0f, 0.0f));
+	gradients.addGradient ( 1.0, noisepp::utils::ColourValue(1.0f, 1.0f, 1.0f));*/
+	/*gradients.addGradient (-1.0000, noisepp::utils::ColourValue (  0,   0, 128)/255.f); // deeps
+	gradients.addGradient (-0.2500, noisepp::utils::ColourValue (  0,   0, 255)/255.f); // shallow
+	gradients.addGradient ( 0.0000, noisepp::utils::ColourValue (  0, 128, 255)/255.f); // shore
+	gradients.addGradient ( 0.0625, noisepp::utils::ColourValue (240, 240,  64)/255.f); // sand
+	gradients.addGradient ( 0.1250, noisepp::utils::ColourValue ( 32, 160,   0)/255.f); // grass
+	gradients.addGradient ( 0.3750, noisepp::utils::ColourValue (224, 224,   0)/255.f); // dirt
+	gradients.addGradient ( 0.7500, noisepp::utils::ColourValue (128, 128, 128)/255.f); // rock
+	gradients.addGradient ( 1.0000, noisepp::utils::ColourValue (255, 255, 255)/255.f); // snow*/
+	gradients.renderImage (img, data);
+
+	unsigned char *pixels = (unsigned char *)malloc(w*h*3);
+	std::memcpy (pixels, img.getPixelData(), w*h*3);
+	return pixels;
+}
+
+bool EditorPreviewRenderer::isPointwise (EditorModule *module)
+{
+	switch (module->getModule().getType())
+	{
+		case noisepp::MODULE_ABSOLUTE:
+		case noisepp::MODULE_ADDITION:
+		case noisepp::MODULE_BLEND:
+		case noisepp::MODULE_CLAMP:
+		case noisepp::MODULE_CURVE:
+		case noisepp::MODULE_EXPONENT:
+		case noisepp::MODULE_INVERT:
+		case noisepp::MODULE_MAXIMUM:
+		case noisepp::MODULE_MINIMUM:
+		case noisepp::MODULE_MULTIPLY:
+		case noisepp::MODULE_POWER:
+		case noisepp::MODULE_SCALEBIAS:
+		case noisepp::MODULE_SELECT:
+		case noisepp::MODULE_TERRACE:
+			return module->getNumberOfSourceModules() > 0;
+		default:
+			return false;
+	}
+}
+
+wxThread::ExitCode EditorPreviewRenderer::Entry ()
+{
+	for (;;)
+	{
+		Job *job;
+		{
+			wxMutexLocker lock(mMutex);
+			while (mJobs.empty() && !mExit)
+				mJobsAvailable.Wait ();
+			if (mExit)
+				break;
+			job = mJobs.front ();
+			mJobs.pop_front ();
+			mRunningJob = job;
+		}
+
+		try
+		{
+			render (job);
+		}
+		catch (std::exception &e)
+		{
+			std::cout << "exception: " << e.what() << std::endl;
+		}
+
+		wxMutexLocker lock(mMutex);
+		freeJob (job);
+		mRunningJob = NULL;
+		mJobDone.Broadcast ();
+	}
+	return 0;
+}
+
+void EditorPreviewRenderer::render (Job *job)
+{
+	const int w = job->request.w;
+	const int h = job->request.h;
+	// pipelines reading the source data work in pixel coordinates and are cheap enough for a single pass
+	const bool pixelCoordinates = !job->sourceData.empty ();
+	const double x0 = pixelCoordinates ? 0.0 : job->request.bounds[0];
+	const double y0 = pixelCoordinates ? 0.0 : job->request.bounds[1];
+	const double xDelta = pixelCoordinates ? 1.0 : job->request.bounds[2] / w;
+	const double yDelta = pixelCoordinates ? 1.0 : job->request.bounds[3] / h;
+	const int coarseStep = pixelCoordinates ? 1 : int(PREVIEW_COARSE_STEP);
+	double *data = new double[w*h];
+	double *display = new double[w*h];
+	std::vector<noisepp::Real> xs(w), ys(w), values(w);
+	std::vector<int> columns(w);
+	noisepp::Cache *cache = job->pipeline->createCache ();
+
+	for (int step=coarseStep;step>=1 && !job->cancelled;step/=2)
+	{
+		// the samples on the grid of the previous pass are already there
+		const int prevStep = (step < coarseStep) ? step*2 : 0;
+		for (int y=0;y<h && !job->cancelled;y+=step)
+		{
+			const bool prevRow = prevStep && (y % prevStep) == 0;
+			int n = 0;
+			for (int x=0;x<w;x+=step)
+			{
+				if (prevRow && (x % prevStep) == 0)
+					continue;
+				columns[n] = x;
+				xs[n] = noisepp::Real(x0 + x * xDelta);
+				ys[n] = noisepp::Real(y0 + y * yDelta);
+				++n;
+			}
+			job->pipeline->cleanCache (cache);
+			job->element->getValues (&xs[0], &ys[0], &values[0], n, cache);
+			double *row = data + y*w;
+			for (int i=0;i<n;++i)
+				row[columns[i]] = values[i];
+		}
+		if (job->cancelled)
+			break;
+
+		if (step == 1)
+		{
+			post (job, colourize (data, w, h), data);
+			data = NULL;
+		}
+		else
+		{
+			// blocky upscale of the coarse samples
+			for (int y=0;y<h;++y)
+			{
+				const double *src = data + (y - y % step)*w;
+				double *dst = display + y*w;
+				for (int x=0;x<w;++x)
+					dst[x] = src[x - x % step];
+			}
+			post (job, colourize (display, w, h), NULL);
+		}
+	}
+
+	job->pipeline->freeCache (cache);
+	delete[] display;
+	delete[] data;
+}
+
+void EditorPreviewRenderer::post (Job *job, unsigned char *pixels, double *data)
+{
+	EditorPreviewResult *result = new EditorPreviewResult;
+	result->module = job->module;
+	result->job = job->id;
+	for (int i=0;i<4;++i)
+		result->bounds[i] = job->request.bounds[i];
+	result->width = job->request.w;
+	result->height = job->request.h;
+	result->pixels = pixels;
+	result->data = data;
+
+	wxCommandEvent event(wxEVT_PREVIEW_READY);
+	event.SetClientData (result);
+	wxPostEvent (mHandler, event);
+}
+
+void EditorPreviewRenderer::freeJob (Job *job)
+{
+	delete job->pipeline;
+	for (size_t i=0;i<job->sourceData.size();++i)
+		delete[] job->sourceData[i];
+	delete job;
+}
@@ -0,0 +1,131 @@
+// This file is part of the Noise++ Editor.
+// Copyright (c) 2008, Urs C. Hanselmann
+//
+// The Noise++ Editor is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Noise++ Editor is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Noise++ Editor.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef EDITORPREVIEW_H
+#define EDITORPREVIEW_H
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <wx/wx.h>
+#include <wx/thread.h>
+#include <Noise.h>
+
+class EditorModule;
+
+/// Posted to the event handler of the preview renderer for each finished pass,
+/// the client data of the event is an EditorPreviewResult which has to be passed to EditorPreviewRenderer::accept().
+DECLARE_EVENT_TYPE(wxEVT_PREVIEW_READY, -1)
+
+/// The result of a preview pass.
+struct EditorPreviewResult
+{
+	EditorModule *module;
+	unsigned long job;
+	/// The area of the preview, as passed to EditorPreviewRenderer::request().
+	double bounds[4];
+	int width, height;
+	/// RGB pixels allocated with malloc(), as wxImage expects them.
+	unsigned char *pixels;
+	/// The values at full resolution, only set by the final pass.
+	double *data;
+};
+
+/// Renders module previews on a worker thread.
+/// Each preview starts at 1/PREVIEW_COARSE_STEP of the resolution and is refined until every pixel is calculated,
+/// every pass is posted back as wxEVT_PREVIEW_READY. The samples of a coarser pass are reused by the finer ones.
+/// Modules which only combine the values of their sources at the same position (see isPointwise()) are
+/// recomputed from the cached data of their sources instead of evaluating the whole tree. If the data of a source
+/// is still being rendered, such a request waits for it.
+class EditorPreviewRenderer : public wxThread
+{
+	public:
+		enum { PREVIEW_COARSE_STEP = 8 };
+
+		EditorPreviewRenderer (wxEvtHandler *handler);
+		~EditorPreviewRenderer ();
+
+		/// Starts the worker thread, without it request() renders synchronously.
+		bool start ();
+		/// Cancels all jobs and stops the worker thread.
+		void stop ();
+
+		/// Requests a preview of the module, a pending or running preview of the same module is cancelled.
+		/// The pipeline is built on the calling thread, if the module already has data of the requested area it is only coloured.
+		void request (EditorModule *module, double x, double y, double width, double height, int w, int h);
+		/// Cancels the previews of the module and of all modules using it as a source.
+		/// Has to be called before the module is changed or removed, returns once the worker doesn't use its pipeline anymore.
+		void cancel (EditorModule *module);
+		/// Cancels all previews.
+		void cancelAll ();
+		/// Applies a result to its module if it's not stale and frees it.
+		/// Returns true if the module got a new preview.
+		bool accept (EditorPreviewResult *result);
+
+		/// Colours the data with the preview gradient, returns RGB pixels allocated with malloc().
+		static unsigned char *colourize (const double *data, int w, int h);
+		/// Returns true if the module only combines the values of its sources at the same position.
+		static bool isPointwise (EditorModule *module);
+	protected:
+		virtual ExitCode Entry ();
+	private:
+		struct Request
+		{
+			double bounds[4];
+			int w, h;
+		};
+		struct Job
+		{
+			EditorModule *module;
+			unsigned long id;
+			noisepp::Pipeline2D *pipeline;
+			noisepp::PipelineElement2D *element;
+			Request request;
+			// copies of the source data if the pipeline reads them instead of the source modules
+			std::vector<double*> sourceData;
+			volatile bool cancelled;
+		};
+		typedef std::deque<Job*> JobQueue;
+		typedef std::map<EditorModule*, unsigned long> JobMap;
+		typedef std::map<EditorModule*, Request> RequestMap;
+
+		wxEvtHandler *mHandler;
+		wxMutex mMutex;
+		wxCondition mJobsAvailable;
+		wxCondition mJobDone;
+		JobQueue mJobs;
+		Job *mRunningJob;
+		bool mExit;
+		bool mStarted;
+		unsigned long mJobCounter;
+		// the latest job of each module, only used on the main thread
+		JobMap mCurrentJobs;
+		// requests waiting for the data of their sources, only used on the main thread
+		RequestMap mDeferredRequests;
+
+		void request (EditorModule *module, const Request &request);
+		bool isPending (EditorModule *module) const;
+		void startDeferredRequests ();
+		bool buildPipeline (Job *job, bool fromSourceData);
+		bool isAffected (EditorModule *jobModule, EditorModule *module, bool dependents) const;
+		void cancelJobs (EditorModule *module, bool dependents);
+		void render (Job *job);
+		void post (Job *job, unsigned char *pixels, double *data);
+		static void freeJob (Job *job);
+};
+
+#endif // EDITORPREVIEW_H
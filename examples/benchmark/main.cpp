@@ -0,0 +1,1042 @@
+/*
+Noise++ benchmark suite.
+
+Runs a fixed set of benchmarks covering every module type in 1D, 2D and 3D, all noise quality levels,
+multi-module graphs, the threaded pipeline, the builders, the gradient renderer and the pipeline serialization.
+Each benchmark is warmed up and then timed for a number of repetitions, the statistics are written as JSON.
+
+usage: benchmark [--filter <substring>] [--repetitions <n>] [--warmup <n>] [--output <file.json>] [--list]
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <time.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include "Noise.h"
+#if NOISEPP_ENABLE_UTILS
+#	include "NoiseUtils.h"
+#endif
+
+using namespace std;
+
+/// Returns a monotonic time stamp in seconds.
+double Timer_getSeconds ()
+{
+#ifdef WIN32
+	LARGE_INTEGER frequency, now;
+	QueryPerformanceFrequency (&frequency);
+	QueryPerformanceCounter (&now);
+	return (double)now.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return (now.tv_sec)+(now.tv_nsec)/1000000000.0;
+#endif
+}
+
+/// Keeps the compiler from optimizing away unused results.
+volatile double gSink = 0;
+
+/// Base class of all benchmarks.
+class Benchmark
+{
+	public:
+		/// Full name of the benchmark, used for filtering.
+		string name;
+		/// Group of the benchmark (module, graph, threads, builder, renderer, serialization).
+		string group;
+		/// Number of dimensions or 0 if not applicable.
+		int dimension;
+		/// Noise quality or -1 if not applicable.
+		int quality;
+		/// Number of threads used.
+		int threads;
+
+		Benchmark (const string &name_, const string &group_, int dimension_=0, int quality_=-1, int threads_=1) :
+			name(name_), group(group_), dimension(dimension_), quality(quality_), threads(threads_)
+		{}
+		virtual ~Benchmark () {}
+		/// Prepares the benchmark, not timed.
+		virtual void setUp () {}
+		/// Runs one repetition and returns the number of processed items.
+		virtual double run () = 0;
+		/// Cleans up after the benchmark, not timed.
+		virtual void tearDown () {}
+};
+
+/// Statistics of a benchmark run in seconds per repetition.
+struct Result
+{
+	const Benchmark *benchmark;
+	double items;
+	double min, max, mean, median, p90, p99, stddev;
+};
+
+/// Returns the specified percentile of sorted samples using linear interpolation.
+double percentile (const vector<double> &sorted, double p)
+{
+	if (sorted.size() == 1)
+		return sorted[0];
+	const double pos = p * (sorted.size()-1);
+	const size_t i = (size_t)pos;
+	if (i+1 >= sorted.size())
+		return sorted.back();
+	const double f = pos - i;
+	return sorted[i] * (1.0-f) + sorted[i+1] * f;
+}
+
+/// Owns a set of modules connected to a graph.
+class ModuleGraph
+{
+	private:
+		vector<noisepp::Module*> mModules;
+
+	public:
+		~ModuleGraph ()
+		{
+			clear ();
+		}
+		/// Takes ownership of a module and returns it.
+		template <class T>
+		T *add (T *module)
+		{
+			mModules.push_back (module);
+			return module;
+		}
+		/// Deletes all modules.
+		void clear ()
+		{
+			for (size_t i=0;i<mModules.size();++i)
+				delete mModules[i];
+			mModules.clear ();
+		}
+};
+
+/// Returns the name of a module type.
+const char *getModuleName (int type)
+{
+	static const char *names[] = { "perlin", "billow", "addition", "absolute", "blend", "checkerboard", "clamp", "constant",
+		"curve", "exponent", "invert", "maximum", "minimum", "multiply", "power", "ridgedmulti", "scalebias", "select",
+		"scalepoint", "turbulence", "terrace", "translatepoint", "voronoi", "transformpoint" };
+	return names[type];
+}
+
+/// Returns true if the module type has a quality setting.
+bool hasQuality (int type)
+{
+	return type == noisepp::MODULE_PERLIN || type == noisepp::MODULE_BILLOW || type == noisepp::MODULE_RIDGEDMULTI || type == noisepp::MODULE_TURBULENCE;
+}
+
+/// Creates a module of the specified type with sensible parameters, its sources are perlin modules.
+noisepp::Module *createModule (ModuleGraph &graph, int type, int quality)
+{
+	noisepp::Module *module = 0;
+	switch (type)
+	{
+		case noisepp::MODULE_PERLIN:
+		{
+			noisepp::PerlinModule *m = graph.add (new noisepp::PerlinModule);
+			m->setQuality (quality);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_BILLOW:
+		{
+			noisepp::BillowModule *m = graph.add (new noisepp::BillowModule);
+			m->setQuality (quality);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_ADDITION: module = graph.add (new noisepp::AdditionModule); break;
+		case noisepp::MODULE_ABSOLUTE: module = graph.add (new noisepp::AbsoluteModule); break;
+		case noisepp::MODULE_BLEND: module = graph.add (new noisepp::BlendModule); break;
+		case noisepp::MODULE_CHECKERBOARD: module = graph.add (new noisepp::CheckerboardModule); break;
+		case noisepp::MODULE_CLAMP: module = graph.add (new noisepp::ClampModule); break;
+		case noisepp::MODULE_CONSTANT: module = graph.add (new noisepp::ConstantModule); break;
+		case noisepp::MODULE_CURVE:
+		{
+			noisepp::CurveModule *m = graph.add (new noisepp::CurveModule);
+			m->addControlPoint (-1.0, -1.0);
+			m->addControlPoint (-0.5, 0.2);
+			m->addControlPoint (0.25, 0.3);
+			m->addControlPoint (0.5, 0.8);
+			m->addControlPoint (1.0, 1.0);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_EXPONENT: module = graph.add (new noisepp::ExponentModule); break;
+		case noisepp::MODULE_INVERT: module = graph.add (new noisepp::InvertModule); break;
+		case noisepp::MODULE_MAXIMUM: module = graph.add (new noisepp::MaximumModule); break;
+		case noisepp::MODULE_MINIMUM: module = graph.add (new noisepp::MinimumModule); break;
+		case noisepp::MODULE_MULTIPLY: module = graph.add (new noisepp::MultiplyModule); break;
+		case noisepp::MODULE_POWER: module = graph.add (new noisepp::PowerModule); break;
+		case noisepp::MODULE_RIDGEDMULTI:
+		{
+			noisepp::RidgedMultiModule *m = graph.add (new noisepp::RidgedMultiModule);
+			m->setQuality (quality);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_SCALEBIAS: module = graph.add (new noisepp::ScaleBiasModule); break;
+		case noisepp::MODULE_SELECT:
+		{
+			noisepp::SelectModule *m = graph.add (new noisepp::SelectModule);
+			m->setLowerBound (-0.25);
+			m->setUpperBound (0.5);
+			m->setEdgeFalloff (0.125);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_SCALEPOINT: module = graph.add (new noisepp::ScalePointModule); break;
+		case noisepp::MODULE_TURBULENCE:
+		{
+			noisepp::TurbulenceModule *m = graph.add (new noisepp::TurbulenceModule);
+			m->setQuality (quality);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_TERRACE:
+		{
+			noisepp::TerraceModule *m = graph.add (new noisepp::TerraceModule);
+			m->addControlPoint (-1.0);
+			m->addControlPoint (-0.25);
+			m->addControlPoint (0.25);
+			m->addControlPoint (1.0);
+			module = m;
+			break;
+		}
+		case noisepp::MODULE_TRANSLATEPOINT: module = graph.add (new noisepp::TranslatePointModule); break;
+		case noisepp::MODULE_VORONOI: module = graph.add (new noisepp::VoronoiModule); break;
+		case noisepp::MODULE_TRANSFORMPOINT:
+		{
+			noisepp::TransformPointModule *m = graph.add (new noisepp::TransformPointModule);
+			m->setRotation (0.3, 0.7, 1.1);
+			module = m;
+			break;
+		}
+	}
+	for (size_t i=0;i<module->getSourceModuleCount();++i)
+	{
+		noisepp::PerlinModule *source = graph.add (new noisepp::PerlinModule);
+		source->setSeed ((int)i+1);
+		source->setFrequency (1.0 + i * 0.5);
+		module->setSourceModule (i, source);
+	}
+	return module;
+}
+
+/// Creates a terrain graph: ridged mountains and billowy plains selected by a perlin control module and perturbed by turbulence.
+noisepp::Module *createTerrainGraph (ModuleGraph &graph)
+{
+	noisepp::RidgedMultiModule *mountains = graph.add (new noisepp::RidgedMultiModule);
+	noisepp::BillowModule *plainsBase = graph.add (new noisepp::BillowModule);
+	plainsBase->setFrequency (2.0);
+	noisepp::ScaleBiasModule *plains = graph.add (new noisepp::ScaleBiasModule);
+	plains->setSourceModule (0, plainsBase);
+	plains->setScale (0.125);
+	plains->setBias (-0.75);
+	noisepp::PerlinModule *control = graph.add (new noisepp::PerlinModule);
+	control->setFrequency (0.5);
+	control->setPersistence (0.25);
+	noisepp::SelectModule *select = graph.add (new noisepp::SelectModule);
+	select->setSourceModule (0, plains);
+	select->setSourceModule (1, mountains);
+	select->setControlModule (control);
+	select->setLowerBound (0.0);
+	select->setUpperBound (1000.0);
+	select->setEdgeFalloff (0.125);
+	noisepp::TurbulenceModule *turbulence = graph.add (new noisepp::TurbulenceModule);
+	turbulence->setSourceModule (0, select);
+	turbulence->setFrequency (4.0);
+	turbulence->setPower (0.125);
+	return turbulence;
+}
+
+/// Creates a deep chain of cheap modules on top of a single perlin module, which mostly measures the per-element overhead.
+noisepp::Module *createChainGraph (ModuleGraph &graph)
+{
+	noisepp::Module *module = graph.add (new noisepp::PerlinModule);
+	for (int i=0;i<16;++i)
+	{
+		noisepp::Module *next;
+		if (i % 2)
+		{
+			noisepp::ScaleBiasModule *m = graph.add (new noisepp::ScaleBiasModule);
+			m->setScale (0.9);
+			m->setBias (0.05);
+			next = m;
+		}
+		else
+			next = graph.add (new noisepp::AbsoluteModule);
+		next->setSourceModule (0, module);
+		module = next;
+	}
+	return module;
+}
+
+/// Creates a graph with many shared sources which makes heavy use of the element cache.
+noisepp::Module *createSharedGraph (ModuleGraph &graph)
+{
+	noisepp::PerlinModule *base = graph.add (new noisepp::PerlinModule);
+	noisepp::Module *module = base;
+	for (int i=0;i<8;++i)
+	{
+		noisepp::AdditionModule *add = graph.add (new noisepp::AdditionModule);
+		add->setSourceModule (0, module);
+		add->setSourceModule (1, base);
+		module = add;
+	}
+	return module;
+}
+
+/// Number of points evaluated per repetition by the pipeline benchmarks.
+const int POINT_GRID_SIZE = 256;
+
+/// Evaluates a module in a default pipeline on a grid of points using the batched interface.
+class PipelineBenchmark : public Benchmark
+{
+	protected:
+		ModuleGraph mGraph;
+		noisepp::Module *mModule;
+		noisepp::Pipeline1D *mPipe1D;
+		noisepp::Pipeline2D *mPipe2D;
+		noisepp::Pipeline3D *mPipe3D;
+		noisepp::ElementID mID;
+		noisepp::Cache *mCache;
+		vector<noisepp::Real> mX, mY, mZ, mValues;
+
+		/// Creates the module to benchmark.
+		virtual noisepp::Module *createModule () = 0;
+
+	public:
+		PipelineBenchmark (const string &name, const string &group, int dimension, int quality=-1) :
+			Benchmark(name, group, dimension, quality), mModule(0), mPipe1D(0), mPipe2D(0), mPipe3D(0), mID(0), mCache(0)
+		{}
+		virtual void setUp ()
+		{
+			mModule = createModule ();
+			const size_t n = noisepp::PIPELINE_BATCH_SIZE;
+			mX.resize (n);
+			mY.resize (n);
+			mZ.resize (n);
+			mValues.resize (n);
+			if (dimension == 1)
+			{
+				mPipe1D = new noisepp::Pipeline1D;
+				mID = mModule->addToPipe (*mPipe1D);
+				mCache = mPipe1D->createCache ();
+			}
+			else if (dimension == 2)
+			{
+				mPipe2D = new noisepp::Pipeline2D;
+				mID = mModule->addToPipe (*mPipe2D);
+				mCache = mPipe2D->createCache ();
+			}
+			else
+			{
+				mPipe3D = new noisepp::Pipeline3D;
+				mID = mModule->addToPipe (*mPipe3D);
+				mCache = mPipe3D->createCache ();
+			}
+		}
+		virtual double run ()
+		{
+			const size_t n = noisepp::PIPELINE_BATCH_SIZE;
+			const int total = POINT_GRID_SIZE * POINT_GRID_SIZE;
+			const noisepp::Real delta = noisepp::Real(0.01);
+			double sum = 0;
+			for (int start=0;start<total;start+=(int)n)
+			{
+				for (size_t i=0;i<n;++i)
+				{
+					const int p = start + (int)i;
+					mX[i] = (p % POINT_GRID_SIZE) * delta;
+					mY[i] = (p / POINT_GRID_SIZE) * delta;
+					mZ[i] = mX[i] * noisepp::Real(0.5);
+				}
+				if (dimension == 1)
+				{
+					// a 1D grid would only repeat the same line, so continue along the x axis
+					for (size_t i=0;i<n;++i)
+						mX[i] = (start + (int)i) * delta;
+					mPipe1D->cleanCache (mCache);
+					mPipe1D->getElement(mID)->getValues (&mX[0], &mValues[0], n, mCache);
+				}
+				else if (dimension == 2)
+				{
+					mPipe2D->cleanCache (mCache);
+					mPipe2D->getElement(mID)->getValues (&mX[0], &mY[0], &mValues[0], n, mCache);
+				}
+				else
+				{
+					mPipe3D->cleanCache (mCache);
+					mPipe3D->getElement(mID)->getValues (&mX[0], &mY[0], &mZ[0], &mValues[0], n, mCache);
+				}
+				sum += mValues[n-1];
+			}
+			gSink = sum;
+			return total;
+		}
+		virtual void tearDown ()
+		{
+			if (mPipe1D)
+				mPipe1D->freeCache (mCache);
+			if (mPipe2D)
+				mPipe2D->freeCache (mCache);
+			if (mPipe3D)
+				mPipe3D->freeCache (mCache);
+			delete mPipe1D;
+			delete mPipe2D;
+			delete mPipe3D;
+			mPipe1D = 0;
+			mPipe2D = 0;
+			mPipe3D = 0;
+			mCache = 0;
+			mGraph.clear ();
+		}
+};
+
+/// Benchmarks a single module type.
+class ModuleBenchmark : public PipelineBenchmark
+{
+	private:
+		int mType;
+
+	protected:
+		virtual noisepp::Module *createModule ()
+		{
+			return ::createModule (mGraph, mType, quality < 0 ? noisepp::NOISE_QUALITY_STD : quality);
+		}
+
+	public:
+		ModuleBenchmark (int type, int dimension, int quality) :
+			PipelineBenchmark(makeName(type, dimension, quality), "module", dimension, quality), mType(type)
+		{}
+		static string makeName (int type, int dimension, int quality)
+		{
+			ostringstream s;
+			s << "module/" << getModuleName(type) << "/" << dimension << "d";
+			if (quality >= 0)
+				s << "/q" << quality;
+			return s.str ();
+		}
+};
+
+/// Graph types used by the graph benchmarks.
+enum GraphType { GRAPH_TERRAIN, GRAPH_CHAIN, GRAPH_SHARED };
+
+/// Returns the name of a graph type.
+const char *getGraphName (int type)
+{
+	static const char *names[] = { "terrain", "chain", "shared" };
+	return names[type];
+}
+
+/// Creates a graph of the specified type.
+noisepp::Module *createGraph (ModuleGraph &graph, int type)
+{
+	if (type == GRAPH_CHAIN)
+		return createChainGraph (graph);
+	if (type == GRAPH_SHARED)
+		return createSharedGraph (graph);
+	return createTerrainGraph (graph);
+}
+
+/// Benchmarks a multi-module graph.
+class GraphBenchmark : public PipelineBenchmark
+{
+	private:
+		int mType;
+
+	protected:
+		virtual noisepp::Module *createModule ()
+		{
+			return createGraph (mGraph, mType);
+		}
+
+	public:
+		GraphBenchmark (int type, int dimension) :
+			PipelineBenchmark(makeName(type, dimension), "graph", dimension), mType(type)
+		{}
+		static string makeName (int type, int dimension)
+		{
+			ostringstream s;
+			s << "graph/" << getGraphName(type) << "/" << dimension << "d";
+			return s.str ();
+		}
+};
+
+/// Benchmarks the single point interface of the default pipeline for comparison with the batched one.
+class PointBenchmark : public Benchmark
+{
+	private:
+		ModuleGraph mGraph;
+		noisepp::Pipeline2D *mPipe;
+		noisepp::ElementID mID;
+		noisepp::Cache *mCache;
+
+	public:
+		PointBenchmark () : Benchmark("graph/terrain/2d/point", "graph", 2), mPipe(0), mID(0), mCache(0)
+		{}
+		virtual void setUp ()
+		{
+			mPipe = new noisepp::Pipeline2D;
+			mID = createTerrainGraph(mGraph)->addToPipe (*mPipe);
+			mCache = mPipe->createCache ();
+		}
+		virtual double run ()
+		{
+			const noisepp::Real delta = noisepp::Real(0.01);
+			noisepp::PipelineElement2D *element = mPipe->getElement (mID);
+			double sum = 0;
+			for (int y=0;y<POINT_GRID_SIZE;++y)
+			{
+				for (int x=0;x<POINT_GRID_SIZE;++x)
+				{
+					mPipe->cleanCache (mCache);
+					sum += element->getValue (x * delta, y * delta, mCache);
+				}
+			}
+			gSink = sum;
+			return POINT_GRID_SIZE * POINT_GRID_SIZE;
+		}
+		virtual void tearDown ()
+		{
+			mPipe->freeCache (mCache);
+			delete mPipe;
+			mPipe = 0;
+			mGraph.clear ();
+		}
+};
+
+#if NOISEPP_ENABLE_UTILS
+/// Static expression of the terrain graph.
+typedef noisepp::utils::TurbulenceExpression<noisepp::utils::SelectExpression<
+	noisepp::utils::ScaleBiasExpression<noisepp::utils::BillowExpression<6> >,
+	noisepp::utils::RidgedMultiExpression<6>,
+	noisepp::utils::PerlinExpression<6> > > TerrainExpression;
+
+/// Creates the static expression equivalent to createTerrainGraph().
+TerrainExpression createTerrainExpression ()
+{
+	using namespace noisepp::utils;
+	TerrainExpression terrain = turbulence (select (scaleBias (billow<6> ().setFrequency (2.0), 0.125, -0.75), ridgedMulti<6> (),
+		perlin<6> ().setFrequency (0.5).setPersistence (0.25), 0.0, 1000.0, 0.125), 0.125);
+	terrain.setFrequency (4.0);
+	return terrain;
+}
+
+/// Benchmarks the terrain graph compiled into a static expression at the points of PointBenchmark.
+class StaticBenchmark : public Benchmark
+{
+	private:
+		TerrainExpression mTerrain;
+
+	public:
+		StaticBenchmark () : Benchmark("graph/terrain/2d/static", "graph", 2), mTerrain(createTerrainExpression ())
+		{}
+		virtual double run ()
+		{
+			const noisepp::Real delta = noisepp::Real(0.01);
+			double sum = 0;
+			for (int y=0;y<POINT_GRID_SIZE;++y)
+			{
+				for (int x=0;x<POINT_GRID_SIZE;++x)
+				{
+					sum += mTerrain.getValue (x * delta, y * delta);
+				}
+			}
+			gSink = sum;
+			return POINT_GRID_SIZE * POINT_GRID_SIZE;
+		}
+};
+#endif
+
+#if NOISEPP_ENABLE_THREADS
+/// Size of the area generated by the threaded pipeline benchmarks.
+const int THREADED_SIZE = 512;
+
+/// Benchmarks the threaded pipeline with a fixed number of threads.
+class ThreadedBenchmark : public Benchmark
+{
+	private:
+		ModuleGraph mGraph;
+		noisepp::ThreadedPipeline2D *mPipe;
+		noisepp::ElementID mID;
+		vector<noisepp::Real> mBuffer;
+
+	public:
+		ThreadedBenchmark (int threadCount) : Benchmark(makeName(threadCount), "threads", 2, -1, threadCount), mPipe(0), mID(0)
+		{}
+		static string makeName (int threadCount)
+		{
+			ostringstream s;
+			s << "threads/terrain/2d/" << threadCount;
+			return s.str ();
+		}
+		virtual void setUp ()
+		{
+			mPipe = new noisepp::ThreadedPipeline2D (threads);
+			mID = createTerrainGraph(mGraph)->addToPipe (*mPipe);
+			mBuffer.resize (THREADED_SIZE * THREADED_SIZE);
+		}
+		virtual double run ()
+		{
+			const noisepp::Real delta = noisepp::Real(0.01);
+			noisepp::PipelineElement2D *element = mPipe->getElement (mID);
+			for (int y=0;y<THREADED_SIZE;++y)
+				mPipe->addJob (new noisepp::LineJob2D(mPipe, element, 0, y * delta, THREADED_SIZE, delta, &mBuffer[y*THREADED_SIZE]));
+			mPipe->executeJobs ();
+			gSink = mBuffer[THREADED_SIZE/2];
+			return THREADED_SIZE * THREADED_SIZE;
+		}
+		virtual void tearDown ()
+		{
+			delete mPipe;
+			mPipe = 0;
+			mGraph.clear ();
+		}
+};
+#endif
+
+#if NOISEPP_ENABLE_UTILS
+/// Benchmarks the plane builder.
+class PlaneBuilderBenchmark : public Benchmark
+{
+	private:
+		ModuleGraph mGraph;
+		noisepp::Module *mModule;
+		vector<noisepp::Real> mBuffer;
+		int mSize;
+
+	public:
+		PlaneBuilderBenchmark (int size) : Benchmark(makeName(size), "builder", 2), mModule(0), mSize(size)
+		{}
+		static string makeName (int size)
+		{
+			ostringstream s;
+			s << "builder/plane/" << size;
+			return s.str ();
+		}
+		virtual void setUp ()
+		{
+			mModule = createTerrainGraph (mGraph);
+			mBuffer.resize (mSize * mSize);
+		}
+		virtual double run ()
+		{
+			noisepp::utils::PlaneBuilder2D builder;
+			builder.setModule (mModule);
+			builder.setSize (mSize, mSize);
+			builder.setBounds (0, 0, 4, 4);
+			builder.setDestination (&mBuffer[0]);
+			builder.build ();
+			gSink = mBuffer[0];
+			return (double)mSize * mSize;
+		}
+		virtual void tearDown ()
+		{
+			mGraph.clear ();
+		}
+};
+
+/// Benchmarks the volume builder with and without region rejection.
+class VolumeBuilderBenchmark : public Benchmark
+{
+	private:
+		ModuleGraph mGraph;
+		noisepp::Module *mModule;
+		vector<noisepp::Real> mBuffer;
+		int mSize;
+		bool mRejection;
+
+	public:
+		VolumeBuilderBenchmark (int size, bool rejection) : Benchmark(makeName(size, rejection), "builder", 3), mModule(0), mSize(size), mRejection(rejection)
+		{}
+		static string makeName (int size, bool rejection)
+		{
+			ostringstream s;
+			s << "builder/volume/" << size << (rejection ? "/rejection" : "");
+			return s.str ();
+		}
+		virtual void setUp ()
+		{
+			mModule = createTerrainGraph (mGraph);
+			mBuffer.resize (mSize * mSize * mSize);
+		}
+		virtual double run ()
+		{
+			noisepp::utils::VolumeBuilder3D builder;
+			builder.setModule (mModule);
+			builder.setSize (mSize, mSize);
+			builder.setDepth (mSize);
+			builder.setBounds (0, 0, 0, 4, 4, 4);
+			builder.setDestination (&mBuffer[0]);
+			builder.setRegionRejection (mRejection);
+			builder.setThreshold (0);
+			builder.build ();
+			gSink = mBuffer[0];
+			return (double)mSize * mSize * mSize;
+		}
+		virtual void tearDown ()
+		{
+			mGraph.clear ();
+		}
+};
+
+/// Benchmarks the gradient renderer with and without the baked lookup table.
+class GradientRendererBenchmark : public Benchmark
+{
+	private:
+		vector<noisepp::Real> mData;
+		noisepp::utils::Image mImage;
+		int mSize;
+		int mLookupTableSize;
+		noisepp::utils::PixelFormat mFormat;
+
+	public:
+		GradientRendererBenchmark (int size, int lookupTableSize, noisepp::utils::PixelFormat format, const char *formatName) :
+			Benchmark(makeName(size, lookupTableSize, formatName), "renderer", 2), mSize(size), mLookupTableSize(lookupTableSize), mFormat(format)
+		{}
+		static string makeName (int size, int lookupTableSize, const char *formatName)
+		{
+			ostringstream s;
+			s << "renderer/gradient/" << formatName << "/" << size << (lookupTableSize > 0 ? "/lut" : "");
+			return s.str ();
+		}
+		virtual void setUp ()
+		{
+			ModuleGraph graph;
+			noisepp::Module *module = createTerrainGraph (graph);
+			mData.resize (mSize * mSize);
+			noisepp::utils::PlaneBuilder2D builder;
+			builder.setModule (module);
+			builder.setSize (mSize, mSize);
+			builder.setBounds (0, 0, 4, 4);
+			builder.setDestination (&mData[0]);
+			builder.build ();
+			mImage.create (mSize, mSize, mFormat);
+		}
+		virtual double run ()
+		{
+			noisepp::utils::GradientRenderer renderer;
+			renderer.addGradient (-1.0, noisepp::utils::ColourValue(0.0f, 0.0f, 0.5f));
+			renderer.addGradient (-0.2, noisepp::utils::ColourValue(0.0f, 0.5f, 1.0f));
+			renderer.addGradient (0.0, noisepp::utils::ColourValue(0.9f, 0.85f, 0.5f));
+			renderer.addGradient (0.1, noisepp::utils::ColourValue(0.1f, 0.6f, 0.1f));
+			renderer.addGradient (0.5, noisepp::utils::ColourValue(0.4f, 0.3f, 0.2f));
+			renderer.addGradient (1.0, noisepp::utils::ColourValue(1.0f, 1.0f, 1.0f));
+			renderer.setLookupTableSize (mLookupTableSize);
+			renderer.renderImage (mImage, &mData[0]);
+			return (double)mSize * mSize;
+		}
+};
+
+/// Benchmarks writing and reading a pipeline in the specified file format version.
+class SerializationBenchmark : public Benchmark
+{
+	private:
+		ModuleGraph mGraph;
+		noisepp::Module *mModule;
+		noisepp::utils::MemoryOutStream mData;
+		bool mRead;
+		unsigned char mVersion;
+
+	public:
+		/// Number of pipelines written or read per repetition.
+		static const int PIPELINE_COUNT = 1000;
+
+		SerializationBenchmark (bool read, unsigned char version) : Benchmark(makeName(read, version), "serialization"), mModule(0), mRead(read), mVersion(version)
+		{}
+		static string makeName (bool read, unsigned char version)
+		{
+			ostringstream s;
+			s << "serialization/" << (read ? "read" : "write") << "/v" << (int)version;
+			return s.str ();
+		}
+		virtual void setUp ()
+		{
+			mModule = createTerrainGraph (mGraph);
+			mData.clear ();
+			noisepp::utils::Writer writer(mData);
+			writer.addModule (mModule);
+			writer.writePipeline (mVersion);
+		}
+		virtual double run ()
+		{
+			if (mRead)
+			{
+				for (int i=0;i<PIPELINE_COUNT;++i)
+				{
+					noisepp::utils::MemoryInStream stream;
+					stream.open (mData.getBuffer(), mData.getBufferSize());
+					noisepp::utils::Reader reader(stream);
+					gSink = reader.getModule() != 0;
+				}
+			}
+			else
+			{
+				noisepp::utils::MemoryOutStream stream;
+				for (int i=0;i<PIPELINE_COUNT;++i)
+				{
+					stream.clear ();
+					noisepp::utils::Writer writer(stream);
+					writer.addModule (mModule);
+					writer.writePipeline (mVersion);
+				}
+				gSink = (double)stream.getBufferSize ();
+			}
+			return PIPELINE_COUNT;
+		}
+		virtual void tearDown ()
+		{
+			mData.clear ();
+			mGraph.clear ();
+		}
+};
+#endif
+
+/// Returns the number of CPUs used for the threaded benchmarks.
+int getCPUCount ()
+{
+#if NOISEPP_ENABLE_UTILS
+	return noisepp::utils::System::getNumberOfCPUs ();
+#else
+	return 2;
+#endif
+}
+
+/// Creates all benchmarks.
+void createBenchmarks (vector<Benchmark*> &benchmarks)
+{
+	for (int type=noisepp::MODULE_PERLIN;type<=noisepp::MODULE_TRANSFORMPOINT;++type)
+	{
+		for (int dimension=1;dimension<=3;++dimension)
+		{
+			// voronoi noise has no 1D implementation
+			if (type == noisepp::MODULE_VORONOI && dimension == 1)
+				continue;
+			if (hasQuality(type))
+			{
+				for (int quality=noisepp::NOISE_QUALITY_LOW;quality<=noisepp::NOISE_QUALITY_FAST_HIGH;++quality)
+					benchmarks.push_back (new ModuleBenchmark(type, dimension, quality));
+			}
+			else
+				benchmarks.push_back (new ModuleBenchmark(type, dimension, -1));
+		}
+	}
+	for (int type=GRAPH_TERRAIN;type<=GRAPH_SHARED;++type)
+	{
+		for (int dimension=1;dimension<=3;++dimension)
+			benchmarks.push_back (new GraphBenchmark(type, dimension));
+	}
+	benchmarks.push_back (new PointBenchmark);
+#if NOISEPP_ENABLE_UTILS
+	benchmarks.push_back (new StaticBenchmark);
+#endif
+#if NOISEPP_ENABLE_THREADS
+	const int cpus = getCPUCount ();
+	for (int threads=1;threads<=cpus;++threads)
+		benchmarks.push_back (new ThreadedBenchmark(threads));
+#endif
+#if NOISEPP_ENABLE_UTILS
+	benchmarks.push_back (new PlaneBuilderBenchmark(512));
+	benchmarks.push_back (new VolumeBuilderBenchmark(64, false));
+	benchmarks.push_back (new VolumeBuilderBenchmark(64, true));
+	benchmarks.push_back (new GradientRendererBenchmark(1024, 0, noisepp::utils::PIXELFORMAT_RGB8, "rgb8"));
+	benchmarks.push_back (new GradientRendererBenchmark(1024, 4096, noisepp::utils::PIXELFORMAT_RGB8, "rgb8"));
+	benchmarks.push_back (new GradientRendererBenchmark(1024, 4096, noisepp::utils::PIXELFORMAT_RGBA8, "rgba8"));
+	for (unsigned char version=1;version<=2;++version)
+	{
+		benchmarks.push_back (new SerializationBenchmark(false, version));
+		benchmarks.push_back (new SerializationBenchmark(true, version));
+	}
+#endif
+}
+
+/// Runs a benchmark and calculates its statistics.
+Result runBenchmark (Benchmark *benchmark, int warmup, int repetitions)
+{
+	Result result;
+	result.benchmark = benchmark;
+	result.items = 0;
+	benchmark->setUp ();
+	for (int i=0;i<warmup;++i)
+		benchmark->run ();
+	vector<double> samples;
+	for (int i=0;i<repetitions;++i)
+	{
+		const double start = Timer_getSeconds ();
+		result.items = benchmark->run ();
+		samples.push_back (Timer_getSeconds () - start);
+	}
+	benchmark->tearDown ();
+
+	double sum = 0;
+	for (size_t i=0;i<samples.size();++i)
+		sum += samples[i];
+	result.mean = sum / samples.size();
+	double variance = 0;
+	for (size_t i=0;i<samples.size();++i)
+		variance += (samples[i] - result.mean) * (samples[i] - result.mean);
+	result.stddev = samples.size() > 1 ? sqrt(variance / (samples.size()-1)) : 0;
+	sort (samples.begin(), samples.end());
+	result.min = samples.front ();
+	result.max = samples.back ();
+	result.median = percentile (samples, 0.5);
+	result.p90 = percentile (samples, 0.9);
+	result.p99 = percentile (samples, 0.99);
+	return result;
+}
+
+/// Escapes a string for JSON output.
+string jsonString (const string &s)
+{
+	string out = "\"";
+	for (size_t i=0;i<s.size();++i)
+	{
+		if (s[i] == '"' || s[i] == '\\')
+			out += '\\';
+		out += s[i];
+	}
+	return out + "\"";
+}
+
+/// Writes the results as JSON.
+void writeJSON (ostream &out, const vector<Result> &results, int warmup, int repetitions)
+{
+	out << setprecision(9);
+	out << "{" << endl;
+	out << "  \"context\": {" << endl;
+	out << "    \"library\": \"noisepp\"," << endl;
+	out << "    \"precision\": " << jsonString(NOISEPP_DOUBLE_PRECISION ? "double" : "float") << "," << endl;
+	out << "    \"threads_enabled\": " << (NOISEPP_ENABLE_THREADS ? "true" : "false") << "," << endl;
+	out << "    \"cpus\": " << getCPUCount() << "," << endl;
+	out << "    \"batch_size\": " << noisepp::PIPELINE_BATCH_SIZE << "," << endl;
+	out << "    \"warmup\": " << warmup << "," << endl;
+	out << "    \"repetitions\": " << repetitions << endl;
+	out << "  }," << endl;
+	out << "  \"benchmarks\": [" << endl;
+	for (size_t i=0;i<results.size();++i)
+	{
+		const Result &r = results[i];
+		const Benchmark *b = r.benchmark;
+		out << "    {";
+		out << "\"name\": " << jsonString(b->name);
+		out << ", \"group\": " << jsonString(b->group);
+		out << ", \"dimension\": " << b->dimension;
+		out << ", \"quality\": " << b->quality;
+		out << ", \"threads\": " << b->threads;
+		out << ", \"items\": " << r.items;
+		out << ", \"min\": " << r.min;
+		out << ", \"max\": " << r.max;
+		out << ", \"mean\": " << r.mean;
+		out << ", \"median\": " << r.median;
+		out << ", \"p90\": " << r.p90;
+		out << ", \"p99\": " << r.p99;
+		out << ", \"stddev\": " << r.stddev;
+		out << ", \"items_per_second\": " << (r.median > 0 ? r.items / r.median : 0);
+		out << "}" << (i+1 < results.size() ? "," : "") << endl;
+	}
+	out << "  ]" << endl;
+	out << "}" << endl;
+}
+
+void printUsage ()
+{
+	cerr << "usage: benchmark [--filter <substring>] [--repetitions <n>] [--warmup <n>] [--output <file.json>] [--list]" << endl;
+}
+
+int main (int argc, char **argv)
+{
+	string filter;
+	string output;
+	int repetitions = 10;
+	int warmup = 2;
+	bool list = false;
+	for (int i=1;i<argc;++i)
+	{
+		const string arg = argv[i];
+		if (arg == "--list")
+			list = true;
+		else if (i+1 < argc && arg == "--filter")
+			filter = argv[++i];
+		else if (i+1 < argc && arg == "--output")
+			output = argv[++i];
+		else if (i+1 < argc && arg == "--repetitions")
+			repetitions = atoi(argv[++i]);
+		else if (i+1 < argc && arg == "--warmup")
+			warmup = atoi(argv[++i]);
+		else
+		{
+			printUsage ();
+			return 1;
+		}
+	}
+	if (repetitions < 1 || warmup < 0)
+	{
+		printUsage ();
+		return 1;
+	}
+
+	int ret = 0;
+	vector<Benchmark*> benchmarks;
+	try
+	{
+		createBenchmarks (benchmarks);
+		vector<Result> results;
+		for (size_t i=0;i<benchmarks.size();++i)
+		{
+			Benchmark *benchmark = benchmarks[i];
+			if (!filter.empty() && benchmark->name.find(filter) == string::npos)
+				continue;
+			if (list)
+			{
+				cout << benchmark->name << endl;
+				continue;
+			}
+			cerr << benchmark->name << " ... ";
+			cerr.flush ();
+			results.push_back (runBenchmark(benchmark, warmup, repetitions));
+			cerr << results.back().median * 1000.0 << " ms" << endl;
+		}
+		if (!list)
+		{
+			if (output.empty())
+				writeJSON (cout, results, warmup, repetitions);
+			else
+			{
+				ofstream file(output.c_str());
+				if (!file)
+				{
+					cerr << "unable to open " << output << endl;
+					ret = 1;
+				}
+				else
+					writeJSON (file, results, warmup, repetitions);
+			}
+		}
+	}
+	catch (noisepp::Exception &e)
+	{
+		cerr << "exception thrown: " << e.getDescription() << endl;
+		ret = 1;
+	}
+	for (size_t i=0;i<benchmarks.size();++i)
+		delete benchmarks[i];
+
+	return ret;
+}
@@ -381,11 +381,430 @@ void test (noisepp::Module &module, bool compare)
 	pipeline3D.freeCache(cache3D);
 }
 
+/// 2D pipeline element counting its evaluations
+class CountingElement2D : public noisepp::PipelineElement2D
+{
+	public:
+		static size_t evaluations;
+
+		CountingElement2D ()
+		{
+			mRange = noisepp::Interval (-1.0, 1.0);
+		}
+		virtual bool checkColumnar () const
+		{
+			return true;
+		}
+		virtual noisepp::Real getValue (noisepp::Real x, noisepp::Real y, noisepp::Cache *cache) const
+		{
+			++evaluations;
+			return sin(x * 3.1) * cos(y * 1.7);
+		}
+		virtual void getValues (const noisepp::Real *x, const noisepp::Real *y, noisepp::Real *values, size_t count, noisepp::Cache *cache) const
+		{
+			evaluations += count;
+			for (size_t i=0;i<count;++i)
+				values[i] = sin(x[i] * 3.1) * cos(y[i] * 1.7);
+		}
+};
+
+size_t CountingElement2D::evaluations = 0;
+
+/// Module adding a counting element, only supports 2D pipelines
+class CountingModule : public noisepp::Module
+{
+	public:
+		CountingModule () : noisepp::Module(0)
+		{
+		}
+		virtual noisepp::ElementID addToPipeline (noisepp::Pipeline1D *pipe) const
+		{
+			throw noisepp::NotImplementedException (NOISEPP_CURRENT_FUNCTION);
+		}
+		virtual noisepp::ElementID addToPipeline (noisepp::Pipeline2D *pipe) const
+		{
+			return pipe->addElement (this, new CountingElement2D);
+		}
+		virtual noisepp::ElementID addToPipeline (noisepp::Pipeline3D *pipe) const
+		{
+			throw noisepp::NotImplementedException (NOISEPP_CURRENT_FUNCTION);
+		}
+		virtual noisepp::ModuleTypeId getType () const
+		{
+			return noisepp::MODULE_CONSTANT;
+		}
+};
+
+/// Checks that elements with several consumers are only evaluated once per point
+bool testSharedSources ()
+{
+	const int n = 1000;
+	noisepp::Real x[n], y[n], values[n];
+	for (int i=0;i<n;++i)
+	{
+		x[i] = i * 0.013;
+		y[i] = i * 0.007;
+	}
+
+	// the same module is used as control and as source of a select module
+	CountingModule source;
+	noisepp::ConstantModule constant;
+	constant.setValue (0.5);
+	noisepp::SelectModule select;
+	select.setSourceModule (0, source);
+	select.setSourceModule (1, constant);
+	select.setControlModule (source);
+	select.setLowerBound (-0.2);
+	select.setUpperBound (0.4);
+	select.setEdgeFalloff (0.1);
+
+	// a module with two consumers, its own source only has one
+	CountingModule leaf;
+	noisepp::ScaleBiasModule scaleBias;
+	scaleBias.setSourceModule (0, leaf);
+	noisepp::AdditionModule addition;
+	addition.setSourceModule (0, scaleBias);
+	addition.setSourceModule (1, scaleBias);
+
+	noisepp::Pipeline2D pipeline;
+	noisepp::ElementID selectID = select.addToPipe (pipeline);
+	noisepp::ElementID additionID = addition.addToPipe (pipeline);
+	noisepp::Cache *cache = pipeline.createCache ();
+	bool ok = true;
+
+	CountingElement2D::evaluations = 0;
+	pipeline.cleanCache (cache);
+	pipeline.getElement (selectID)->getValues (x, y, values, n, cache);
+	cout << "select with a shared control and source: " << CountingElement2D::evaluations << " evaluations for " << n << " points" << endl;
+	if (CountingElement2D::evaluations != size_t(n))
+	{
+		cout << "WARNING: shared elements are evaluated more than once!" << endl;
+		ok = false;
+	}
+
+	CountingElement2D::evaluations = 0;
+	pipeline.cleanCache (cache);
+	pipeline.getElement (additionID)->getValues (x, y, values, n, cache);
+	cout << "addition with a shared source: " << CountingElement2D::evaluations << " evaluations for " << n << " points" << endl;
+	if (CountingElement2D::evaluations != size_t(n))
+	{
+		cout << "WARNING: shared elements are evaluated more than once!" << endl;
+		ok = false;
+	}
+	if (!pipeline.getElement (pipeline.getElementID (leaf))->isColumnar ())
+	{
+		cout << "WARNING: the source of a shared module isn't columnar!" << endl;
+		ok = false;
+	}
+
+	pipeline.freeCache (cache);
+	return ok;
+}
+
+/// Checks that the region ranges contain every value sampled inside the region
+bool testRegionRanges ()
+{
+	noisepp::PerlinModule perlin;
+	perlin.setOctaveCount (4);
+	noisepp::ScaleBiasModule scaleBias;
+	scaleBias.setSourceModule (0, perlin);
+	scaleBias.setScale (0.8);
+	scaleBias.setBias (0.3);
+	noisepp::BillowModule billow;
+	billow.setSeed (3);
+	billow.setOctaveCount (3);
+	noisepp::AdditionModule addition;
+	addition.setSourceModule (0, scaleBias);
+	addition.setSourceModule (1, billow);
+
+	noisepp::Pipeline3D pipeline;
+	noisepp::ElementID additionID = addition.addToPipe (pipeline);
+	noisepp::PipelineElement3D *element = pipeline.getElement (additionID);
+	noisepp::Cache *cache = pipeline.createCache ();
+	const noisepp::Interval range = element->getRange ();
+	bool ok = true;
+
+	// sample regions of different size and compare every value against the region range and the global range
+	const int n = 8;
+	int outside = 0;
+	for (int region=0;region<200;++region)
+	{
+		const noisepp::Real x0 = region * 1.37 - 50.0;
+		const noisepp::Real y0 = region * 0.61 - 20.0;
+		const noisepp::Real z0 = region * 0.23;
+		const noisepp::Real delta = (region % 10 + 1) * 0.01;
+		const noisepp::Real extent = delta * (n - 1);
+		const noisepp::Interval regionRange = element->getRegionRange (noisepp::Interval (x0, x0 + extent), noisepp::Interval (y0, y0 + extent), noisepp::Interval (z0, z0 + extent));
+		for (int z=0;z<n;++z)
+		{
+			for (int y=0;y<n;++y)
+			{
+				for (int x=0;x<n;++x)
+				{
+					pipeline.cleanCache (cache);
+					const noisepp::Real value = element->getValue (x0 + x * delta, y0 + y * delta, z0 + z * delta, cache);
+					if (value < regionRange.lower || value > regionRange.upper || value < range.lower || value > range.upper)
+						++outside;
+				}
+			}
+		}
+	}
+	cout << "values outside of their region range: " << outside << endl;
+	if (outside)
+	{
+		cout << "WARNING: the region range doesn't contain all values of the region!" << endl;
+		ok = false;
+	}
+	pipeline.freeCache (cache);
+
+#if NOISEPP_ENABLE_UTILS
+	// tiles rejected by the volume builder have to be on the same side of the threshold as the exact values
+	const int width = 64, height = 64, depth = 32;
+	const noisepp::Real threshold = 3.0;
+	noisepp::Real *exact = new noisepp::Real[width*height*depth];
+	noisepp::Real *rejected = new noisepp::Real[width*height*depth];
+	noisepp::utils::VolumeBuilder3D builder;
+	builder.setModule (addition);
+	builder.setSize (width, height);
+	builder.setDepth (depth);
+	builder.setTileSize (4);
+	builder.setBounds (0.0, 0.0, 0.0, 1.0, 1.0, 0.5);
+	builder.setThreshold (threshold);
+	builder.setDestination (exact);
+	builder.build ();
+	builder.setRegionRejection ();
+	builder.setDestination (rejected);
+	builder.build ();
+	int misclassified = 0;
+	for (int i=0;i<width*height*depth;++i)
+	{
+		if ((exact[i] > threshold) != (rejected[i] > threshold))
+			++misclassified;
+	}
+	cout << "rejected tiles: " << builder.getRejectedTileCount () << " of " << builder.getProgressMaximum () << ", misclassified values: " << misclassified << endl;
+	if (misclassified)
+	{
+		cout << "WARNING: a rejected tile contains values on the wrong side of the threshold!" << endl;
+		ok = false;
+	}
+	if (builder.getRejectedTileCount () == 0)
+	{
+		cout << "WARNING: no tile was rejected!" << endl;
+		ok = false;
+	}
+	delete[] exact;
+	delete[] rejected;
+#endif
+	return ok;
+}
+
+/// Compares an analytic derivative against central differences.
+/// Returns 0 if the one-sided differences disagree, the function has a kink close to the point then.
+double calcDerivativeError (double derivative, double left, double value, double right, double h)
+{
+	const double leftDifference = (value - left) / h;
+	const double rightDifference = (right - value) / h;
+	if (fabs(leftDifference - rightDifference) > 1.0e-3 * (1.0 + fabs(rightDifference)))
+		return 0;
+	const double centralDifference = (right - left) / (2*h);
+	return fabs(derivative - centralDifference) / (1.0 + fabs(centralDifference));
+}
+
+/// Returns the largest difference between the analytic gradients of the module and central differences
+double calcMaxGradientError (noisepp::Module &module)
+{
+	const noisepp::Real h = 1.0e-6;
+	double error = 0;
+
+	noisepp::Pipeline2D pipeline2D;
+	noisepp::PipelineElement2D *element2D = pipeline2D.getElement (module.addToPipe (pipeline2D));
+	noisepp::Cache *cache2D = pipeline2D.createCache ();
+	noisepp::Pipeline3D pipeline3D;
+	noisepp::PipelineElement3D *element3D = pipeline3D.getElement (module.addToPipe (pipeline3D));
+	noisepp::Cache *cache3D = pipeline3D.createCache ();
+	for (int i=0;i<500;++i)
+	{
+		const noisepp::Real x = i * 0.7313 - 150.1713;
+		const noisepp::Real y = i * 0.3971 - 80.2377;
+		const noisepp::Real z = i * 0.1537 + 0.5119;
+		noisepp::Real dx, dy, dz;
+
+		pipeline2D.cleanCache (cache2D);
+		noisepp::Real value = element2D->getValueAndGradient (x, y, dx, dy, cache2D);
+		pipeline2D.cleanCache (cache2D);
+		noisepp::Real exact = element2D->getValue (x, y, cache2D);
+		error = std::max (error, fabs(value - exact));
+		pipeline2D.cleanCache (cache2D);
+		error = std::max (error, calcDerivativeError (dx, element2D->getValue (x-h, y, cache2D), exact, element2D->getValue (x+h, y, cache2D), h));
+		pipeline2D.cleanCache (cache2D);
+		error = std::max (error, calcDerivativeError (dy, element2D->getValue (x, y-h, cache2D), exact, element2D->getValue (x, y+h, cache2D), h));
+
+		pipeline3D.cleanCache (cache3D);
+		value = element3D->getValueAndGradient (x, y, z, dx, dy, dz, cache3D);
+		pipeline3D.cleanCache (cache3D);
+		exact = element3D->getValue (x, y, z, cache3D);
+		error = std::max (error, fabs(value - exact));
+		pipeline3D.cleanCache (cache3D);
+		error = std::max (error, calcDerivativeError (dx, element3D->getValue (x-h, y, z, cache3D), exact, element3D->getValue (x+h, y, z, cache3D), h));
+		pipeline3D.cleanCache (cache3D);
+		error = std::max (error, calcDerivativeError (dy, element3D->getValue (x, y-h, z, cache3D), exact, element3D->getValue (x, y+h, z, cache3D), h));
+		pipeline3D.cleanCache (cache3D);
+		error = std::max (error, calcDerivativeError (dz, element3D->getValue (x, y, z-h, cache3D), exact, element3D->getValue (x, y, z+h, cache3D), h));
+	}
+	pipeline2D.freeCache (cache2D);
+	pipeline3D.freeCache (cache3D);
+	return error;
+}
+
+/// Checks the analytic gradients against central differences
+bool testGradients ()
+{
+	noisepp::PerlinModule perlin;
+	noisepp::PerlinModule fastPerlin;
+	fastPerlin.setQuality (noisepp::NOISE_QUALITY_FAST_STD);
+	noisepp::PerlinModule highPerlin;
+	highPerlin.setQuality (noisepp::NOISE_QUALITY_HIGH);
+	noisepp::BillowModule billow;
+	noisepp::RidgedMultiModule ridged;
+	noisepp::ScaleBiasModule scaleBias;
+	scaleBias.setSourceModule (0, ridged);
+	scaleBias.setScale (0.5);
+	scaleBias.setBias (0.2);
+	noisepp::MultiplyModule multiply;
+	multiply.setSourceModule (0, perlin);
+	multiply.setSourceModule (1, billow);
+	noisepp::BlendModule blend;
+	blend.setSourceModule (0, scaleBias);
+	blend.setSourceModule (1, fastPerlin);
+	blend.setControlModule (highPerlin);
+	noisepp::TransformPointModule transform;
+	transform.setSourceModule (0, blend);
+	transform.setRotation (0.3, 0.7, 1.1);
+
+	const char *names[] = { "perlin", "fast perlin", "high quality perlin", "billow", "ridged multifractal", "scale/bias", "multiply", "blend", "transform" };
+	noisepp::Module *modules[] = { &perlin, &fastPerlin, &highPerlin, &billow, &ridged, &scaleBias, &multiply, &blend, &transform };
+	bool ok = true;
+	for (size_t i=0;i<sizeof(modules)/sizeof(modules[0]);++i)
+	{
+		const double error = calcMaxGradientError (*modules[i]);
+		cout << names[i] << ": maximum gradient error " << error << endl;
+		if (error > 1.0e-3)
+		{
+			cout << "WARNING: the gradient doesn't match the central differences!" << endl;
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+#if NOISEPP_ENABLE_UTILS
+/// Checks that pipelines written in both file format versions read back to the same output
+bool testSerialization ()
+{
+	noisepp::PerlinModule perlin;
+	perlin.setOctaveCount (5);
+	perlin.setSeed (7);
+	noisepp::RidgedMultiModule ridged;
+	ridged.setFrequency (0.7);
+	noisepp::ScaleBiasModule scaleBias;
+	scaleBias.setSourceModule (0, ridged);
+	scaleBias.setScale (0.6);
+	scaleBias.setBias (-0.1);
+	noisepp::SelectModule select;
+	select.setSourceModule (0, perlin);
+	select.setSourceModule (1, scaleBias);
+	select.setControlModule (perlin);
+	select.setLowerBound (-0.2);
+	select.setUpperBound (0.5);
+	select.setEdgeFalloff (0.1);
+	noisepp::TurbulenceModule turbulence;
+	turbulence.setSourceModule (0, select);
+	turbulence.setPower (0.3);
+
+	const int n = 4096;
+	noisepp::Real x[n], y[n], expected[n], values[n];
+	for (int i=0;i<n;++i)
+	{
+		x[i] = (i % 64) * 0.037 - 1.0;
+		y[i] = (i / 64) * 0.029 + 3.0;
+	}
+	noisepp::Pipeline2D pipeline;
+	noisepp::PipelineElement2D *element = pipeline.getElement (turbulence.addToPipe (pipeline));
+	noisepp::Cache *cache = pipeline.createCache ();
+	element->getValues (x, y, expected, n, cache);
+	pipeline.freeCache (cache);
+
+	bool ok = true;
+	for (unsigned char version=1;version<=2;++version)
+	{
+		noisepp::utils::MemoryOutStream data;
+		noisepp::utils::Writer writer(data);
+		writer.addModule (turbulence);
+		writer.writePipeline (version);
+
+		noisepp::utils::MemoryInStream stream;
+		stream.open (data.getBuffer(), data.getBufferSize());
+		noisepp::utils::Reader reader(stream);
+		noisepp::Pipeline2D readPipeline;
+		element = readPipeline.getElement (reader.getModule ()->addToPipe (readPipeline));
+		cache = readPipeline.createCache ();
+		element->getValues (x, y, values, n, cache);
+		readPipeline.freeCache (cache);
+		const double dif = calcMaxDifference (expected, values, n);
+		cout << "version " << (int)version << " round trip: maximum difference " << dif << endl;
+		if (dif != 0)
+		{
+			cout << "WARNING: different result!" << endl;
+			ok = false;
+		}
+
+		if (version == 2)
+		{
+			// a source ID which only becomes valid when narrowed to 16 bits has to be rejected
+			unsigned char *buffer = (unsigned char *)data.getBuffer();
+			const unsigned moduleCount = noisepp::utils::FileFormat::readLE32 (buffer + 8);
+			unsigned char *sources = buffer + NOISE_FILE_V2_HEADER_SIZE + moduleCount * NOISE_FILE_V2_MODULE_SIZE;
+			noisepp::utils::FileFormat::writeLE32 (sources, 0x10000);
+			bool rejected = false;
+			try
+			{
+				stream.open (data.getBuffer(), data.getBufferSize());
+				noisepp::utils::Reader invalidReader(stream);
+			}
+			catch (noisepp::ReaderException &)
+			{
+				rejected = true;
+			}
+			if (!rejected)
+			{
+				cout << "WARNING: an invalid source ID was accepted!" << endl;
+				ok = false;
+			}
+		}
+	}
+	return ok;
+}
+#endif
+
 int main ()
 {
 	int ret = 0;
 	try
 	{
+		cout << "--- CHECKING THE EVALUATION COUNT OF SHARED ELEMENTS ---" << endl;
+		if (!testSharedSources ())
+			ret = 1;
+		cout << "--- CHECKING THE REGION RANGES ---" << endl;
+		if (!testRegionRanges ())
+			ret = 1;
+		cout << "--- CHECKING THE GRADIENTS ---" << endl;
+		if (!testGradients ())
+			ret = 1;
+#if NOISEPP_ENABLE_UTILS
+		cout << "--- CHECKING THE SERIALIZATION ---" << endl;
+		if (!testSerialization ())
+			ret = 1;
+#endif
 		// the Noise++ module
 		noisepp::PerlinModule noiseppPerlin;
 		// run the test with default perlin noise settings (which are compatible to libnoise, so do also compare results)
@@ -54,6 +54,7 @@
 #include "NoiseTurbulence.h"
 #include "NoiseTerrace.h"
 #include "NoiseTranslatePoint.h"
+#include "NoiseTransformPoint.h"
 #include "NoiseVoronoi.h"
 
 #if NOISEPP_ENABLE_THREADS
@@ -41,6 +41,17 @@ namespace noisepp
 			AbsoluteElement1D (const Pipeline1D *pipe, ElementID element) : mElement(element)
 			{
 				mElementPtr = pipe->getElement (element);
+				mRange = mElementPtr->getRange().abs ();
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = std::fabs (values[i]);
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -48,6 +59,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, cache);
 				return std::fabs(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				return std::fabs(value);
+			}
 	};
 
 	class AbsoluteElement2D : public PipelineElement2D
@@ -60,6 +77,21 @@ namespace noisepp
 			AbsoluteElement2D (const Pipeline2D *pipe, ElementID element) : mElement(element)
 			{
 				mElementPtr = pipe->getElement (element);
+				mRange = mElementPtr->getRange().abs ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mElementPtr->getRegionRange (x, y).abs ();
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = std::fabs (values[i]);
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -67,6 +99,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, cache);
 				return std::fabs(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				return std::fabs(value);
+			}
 	};
 
 	class AbsoluteElement3D : public PipelineElement3D
@@ -79,6 +117,21 @@ namespace noisepp
 			AbsoluteElement3D (const Pipeline3D *pipe, ElementID element) : mElement(element)
 			{
 				mElementPtr = pipe->getElement (element);
+				mRange = mElementPtr->getRange().abs ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mElementPtr->getRegionRange (x, y, z).abs ();
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = std::fabs (values[i]);
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -86,6 +139,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, z, cache);
 				return std::fabs(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				return std::fabs(value);
+			}
 	};
 
 	/** Module that outputs the absolute value of the input value from the source module.
@@ -43,6 +43,31 @@ namespace noisepp
 			{
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
+				mRange = mLeftPtr->getRange() + mRightPtr->getRange();
+			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement1D::getValues (x, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] += right[i];
+					x += n;
+					values += n;
+					count -= n;
+				}
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -51,6 +76,13 @@ namespace noisepp
 				value += getElementValue (mRightPtr, mRight, x, cache);
 				return value;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mLeftPtr->getWorldValue (x, cache);
+				value += mRightPtr->getWorldValue (x, cache);
+				return value;
+			}
 	};
 
 	class AdditionElement2D : public PipelineElement2D
@@ -65,6 +97,36 @@ namespace noisepp
 			{
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
+				mRange = mLeftPtr->getRange() + mRightPtr->getRange();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mLeftPtr->getRegionRange (x, y) + mRightPtr->getRegionRange (x, y);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement2D::getValues (x, y, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, y, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, y, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] += right[i];
+					x += n;
+					y += n;
+					values += n;
+					count -= n;
+				}
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -73,6 +135,21 @@ namespace noisepp
 				value += getElementValue (mRightPtr, mRight, x, y, cache);
 				return value;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mLeftPtr->getWorldValue (x, y, cache);
+				value += mRightPtr->getWorldValue (x, y, cache);
+				return value;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				Real ldx, ldy, rdx, rdy;
+				const Real value = mLeftPtr->getValueAndGradient (x, y, ldx, ldy, cache) + mRightPtr->getValueAndGradient (x, y, rdx, rdy, cache);
+				dx = ldx + rdx;
+				dy = ldy + rdy;
+				return value;
+			}
 	};
 
 	class AdditionElement3D : public PipelineElement3D
@@ -87,6 +164,37 @@ namespace noisepp
 			{
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
+				mRange = mLeftPtr->getRange() + mRightPtr->getRange();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mLeftPtr->getRegionRange (x, y, z) + mRightPtr->getRegionRange (x, y, z);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement3D::getValues (x, y, z, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, y, z, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, y, z, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] += right[i];
+					x += n;
+					y += n;
+					z += n;
+					values += n;
+					count -= n;
+				}
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -95,6 +203,22 @@ namespace noisepp
 				value += getElementValue (mRightPtr, mRight, x, y, z, cache);
 				return value;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mLeftPtr->getWorldValue (x, y, z, cache);
+				value += mRightPtr->getWorldValue (x, y, z, cache);
+				return value;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				Real ldx, ldy, ldz, rdx, rdy, rdz;
+				const Real value = mLeftPtr->getValueAndGradient (x, y, z, ldx, ldy, ldz, cache) + mRightPtr->getValueAndGradient (x, y, z, rdx, rdy, rdz, cache);
+				dx = ldx + rdx;
+				dy = ldy + rdy;
+				dz = ldz + rdz;
+				return value;
+			}
 	};
 
 	/** Module for adding the values of two modules together.
@@ -31,6 +31,15 @@
 
 namespace noisepp
 {
+	/// Returns the output range of a blend for the specified source and control ranges.
+	inline Interval calcBlendRange (const Interval &left, const Interval &right, const Interval &control)
+	{
+		const Interval alpha = (control + Real(1.0)) * Real(0.5);
+		if (alpha.isInside (Real(0.0), Real(1.0)))
+			return Interval::Hull (left, right);
+		return left * (-alpha + Real(1.0)) + right * alpha;
+	}
+
 	class BlendElement1D : public PipelineElement1D
 	{
 		private:
@@ -45,6 +54,7 @@ namespace noisepp
 				mLeftPtr = pipe->getElement(mLeft);
 				mRightPtr = pipe->getElement(mRight);
 				mControlPtr = pipe->getElement(mControl);
+				mRange = calcBlendRange (mLeftPtr->getRange(), mRightPtr->getRange(), mControlPtr->getRange());
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -54,6 +64,16 @@ namespace noisepp
 				rightValue = getElementValue (mRightPtr, mRight, x, cache);
 				blendValue = getElementValue (mControlPtr, mControl, x, cache);
 
+				return Math::InterpLinear (leftValue, rightValue, (blendValue + Real(1.0)) / Real(2.0));
+			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real leftValue, rightValue, blendValue;
+
+				leftValue = mLeftPtr->getWorldValue (x, cache);
+				rightValue = mRightPtr->getWorldValue (x, cache);
+				blendValue = mControlPtr->getWorldValue (x, cache);
+
 				return Math::InterpLinear (leftValue, rightValue, (blendValue + Real(1.0)) / Real(2.0));
 			}
 	};
@@ -72,6 +92,11 @@ namespace noisepp
 				mLeftPtr = pipe->getElement(mLeft);
 				mRightPtr = pipe->getElement(mRight);
 				mControlPtr = pipe->getElement(mControl);
+				mRange = calcBlendRange (mLeftPtr->getRange(), mRightPtr->getRange(), mControlPtr->getRange());
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return calcBlendRange (mLeftPtr->getRegionRange (x, y), mRightPtr->getRegionRange (x, y), mControlPtr->getRegionRange (x, y));
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -83,6 +108,28 @@ namespace noisepp
 
 				return Math::InterpLinear (leftValue, rightValue, (blendValue + Real(1.0)) / Real(2.0));
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real leftValue, rightValue, blendValue;
+
+				leftValue = mLeftPtr->getWorldValue (x, y, cache);
+				rightValue = mRightPtr->getWorldValue (x, y, cache);
+				blendValue = mControlPtr->getWorldValue (x, y, cache);
+
+				return Math::InterpLinear (leftValue, rightValue, (blendValue + Real(1.0)) / Real(2.0));
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				Real ldx, ldy, rdx, rdy, cdx, cdy;
+				const Real leftValue = mLeftPtr->getValueAndGradient (x, y, ldx, ldy, cache);
+				const Real rightValue = mRightPtr->getValueAndGradient (x, y, rdx, rdy, cache);
+				const Real blendValue = mControlPtr->getValueAndGradient (x, y, cdx, cdy, cache);
+				const Real a = (blendValue + Real(1.0)) / Real(2.0);
+				const Real difference = (rightValue - leftValue) / Real(2.0);
+				dx = Math::InterpLinear (ldx, rdx, a) + difference * cdx;
+				dy = Math::InterpLinear (ldy, rdy, a) + difference * cdy;
+				return Math::InterpLinear (leftValue, rightValue, a);
+			}
 	};
 
 	class BlendElement3D : public PipelineElement3D
@@ -99,6 +146,11 @@ namespace noisepp
 				mLeftPtr = pipe->getElement(mLeft);
 				mRightPtr = pipe->getElement(mRight);
 				mControlPtr = pipe->getElement(mControl);
+				mRange = calcBlendRange (mLeftPtr->getRange(), mRightPtr->getRange(), mControlPtr->getRange());
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return calcBlendRange (mLeftPtr->getRegionRange (x, y, z), mRightPtr->getRegionRange (x, y, z), mControlPtr->getRegionRange (x, y, z));
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -110,14 +162,85 @@ namespace noisepp
 
 				return Math::InterpLinear (leftValue, rightValue, (blendValue + Real(1.0)) / Real(2.0));
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real leftValue, rightValue, blendValue;
+
+				leftValue = mLeftPtr->getWorldValue (x, y, z, cache);
+				rightValue = mRightPtr->getWorldValue (x, y, z, cache);
+				blendValue = mControlPtr->getWorldValue (x, y, z, cache);
+
+				return Math::InterpLinear (leftValue, rightValue, (blendValue + Real(1.0)) / Real(2.0));
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				Real ldx, ldy, ldz, rdx, rdy, rdz, cdx, cdy, cdz;
+				const Real leftValue = mLeftPtr->getValueAndGradient (x, y, z, ldx, ldy, ldz, cache);
+				const Real rightValue = mRightPtr->getValueAndGradient (x, y, z, rdx, rdy, rdz, cache);
+				const Real blendValue = mControlPtr->getValueAndGradient (x, y, z, cdx, cdy, cdz, cache);
+				const Real a = (blendValue + Real(1.0)) / Real(2.0);
+				const Real difference = (rightValue - leftValue) / Real(2.0);
+				dx = Math::InterpLinear (ldx, rdx, a) + difference * cdx;
+				dy = Math::InterpLinear (ldy, rdy, a) + difference * cdy;
+				dz = Math::InterpLinear (ldz, rdz, a) + difference * cdz;
+				return Math::InterpLinear (leftValue, rightValue, a);
+			}
 	};
 
 	/** Module for blending.
 		Blends the two values of the source modules controlled by the value of the control module.
 	*/
-	class BlendModule : public TripleSourceModule<BlendElement1D, BlendElement2D, BlendElement3D>
+	class BlendModule : public TripleSourceModuleBase
 	{
+		private:
+			/// Returns the source which is always selected for the specified control range,
+			/// or -1 if the sources are blended.
+			int getSelectedSource (const Interval &control) const
+			{
+				if (control.isConstant () && control.lower == Real(-1.0))
+					return 0;
+				if (control.isConstant () && control.lower == Real(1.0))
+					return 1;
+				return -1;
+			}
+
 		public:
+			/// @copydoc noisepp::Module::addToPipeline()
+			virtual ElementID addToPipeline (Pipeline1D *pipe) const
+			{
+				NoiseModuleCheckSourceModules;
+				ElementID third = pipe->addSource(getSourceModule(2));
+				const int selected = getSelectedSource (pipe->getElement(third)->getRange());
+				if (selected >= 0)
+					return pipe->addAlias (this, pipe->addSource(getSourceModule(selected)));
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
+				return pipe->addElement (this, new BlendElement1D(pipe, first, second, third));
+			}
+			/// @copydoc noisepp::Module::addToPipeline()
+			virtual ElementID addToPipeline (Pipeline2D *pipe) const
+			{
+				NoiseModuleCheckSourceModules;
+				ElementID third = pipe->addSource(getSourceModule(2));
+				const int selected = getSelectedSource (pipe->getElement(third)->getRange());
+				if (selected >= 0)
+					return pipe->addAlias (this, pipe->addSource(getSourceModule(selected)));
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
+				return pipe->addElement (this, new BlendElement2D(pipe, first, second, third));
+			}
+			/// @copydoc noisepp::Module::addToPipeline()
+			virtual ElementID addToPipeline (Pipeline3D *pipe) const
+			{
+				NoiseModuleCheckSourceModules;
+				ElementID third = pipe->addSource(getSourceModule(2));
+				const int selected = getSelectedSource (pipe->getElement(third)->getRange());
+				if (selected >= 0)
+					return pipe->addAlias (this, pipe->addSource(getSourceModule(selected)));
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
+				return pipe->addElement (this, new BlendElement3D(pipe, first, second, third));
+			}
 			/// @copydoc noisepp::Module::getType()
 			ModuleTypeId getType() const { return MODULE_BLEND; }
 	};
@@ -34,6 +34,14 @@ namespace noisepp
 	class CheckerboardElement1D : public PipelineElement1D
 	{
 		public:
+			CheckerboardElement1D ()
+			{
+				mRange = Interval (Real(-1.0), Real(1.0));
+			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				const int ix = (int)(floor (Math::MakeInt32Range (x)));
@@ -44,6 +52,14 @@ namespace noisepp
 	class CheckerboardElement2D : public PipelineElement2D
 	{
 		public:
+			CheckerboardElement2D ()
+			{
+				mRange = Interval (Real(-1.0), Real(1.0));
+			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				const int ix = (int)(floor (Math::MakeInt32Range (x)));
@@ -55,6 +71,14 @@ namespace noisepp
 	class CheckerboardElement3D : public PipelineElement3D
 	{
 		public:
+			CheckerboardElement3D ()
+			{
+				mRange = Interval (Real(-1.0), Real(1.0));
+			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				const int ix = (int)(floor (Math::MakeInt32Range (x)));
@@ -42,6 +42,21 @@ namespace noisepp
 			ClampElement1D (const Pipeline1D *pipe, ElementID element, Real lowerBound, Real upperBound) : mElement(element), mLowerBound(lowerBound), mUpperBound(upperBound)
 			{
 				mElementPtr = pipe->getElement(mElement);
+				if (mLowerBound <= mUpperBound)
+					mRange = mElementPtr->getRange().clamp (mLowerBound, mUpperBound);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				for (size_t i=0;i<count;++i)
+				{
+					const Real value = values[i];
+					values[i] = value < mLowerBound ? mLowerBound : (value > mUpperBound ? mUpperBound : value);
+				}
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -53,6 +68,16 @@ namespace noisepp
 					value = mUpperBound;
 				return value;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				if (value < mLowerBound)
+					value = mLowerBound;
+				else if (value > mUpperBound)
+					value = mUpperBound;
+				return value;
+			}
 	};
 
 	class ClampElement2D : public PipelineElement2D
@@ -66,6 +91,27 @@ namespace noisepp
 			ClampElement2D (const Pipeline2D *pipe, ElementID element, Real lowerBound, Real upperBound) : mElement(element), mLowerBound(lowerBound), mUpperBound(upperBound)
 			{
 				mElementPtr = pipe->getElement(mElement);
+				if (mLowerBound <= mUpperBound)
+					mRange = mElementPtr->getRange().clamp (mLowerBound, mUpperBound);
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				if (mLowerBound <= mUpperBound)
+					return mElementPtr->getRegionRange (x, y).clamp (mLowerBound, mUpperBound);
+				return mRange;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				for (size_t i=0;i<count;++i)
+				{
+					const Real value = values[i];
+					values[i] = value < mLowerBound ? mLowerBound : (value > mUpperBound ? mUpperBound : value);
+				}
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -77,6 +123,16 @@ namespace noisepp
 					value = mUpperBound;
 				return value;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				if (value < mLowerBound)
+					value = mLowerBound;
+				else if (value > mUpperBound)
+					value = mUpperBound;
+				return value;
+			}
 	};
 
 	class ClampElement3D : public PipelineElement3D
@@ -90,6 +146,27 @@ namespace noisepp
 			ClampElement3D (const Pipeline3D *pipe, ElementID element, Real lowerBound, Real upperBound) : mElement(element), mLowerBound(lowerBound), mUpperBound(upperBound)
 			{
 				mElementPtr = pipe->getElement(mElement);
+				if (mLowerBound <= mUpperBound)
+					mRange = mElementPtr->getRange().clamp (mLowerBound, mUpperBound);
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				if (mLowerBound <= mUpperBound)
+					return mElementPtr->getRegionRange (x, y, z).clamp (mLowerBound, mUpperBound);
+				return mRange;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				for (size_t i=0;i<count;++i)
+				{
+					const Real value = values[i];
+					values[i] = value < mLowerBound ? mLowerBound : (value > mUpperBound ? mUpperBound : value);
+				}
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -101,6 +178,16 @@ namespace noisepp
 					value = mUpperBound;
 				return value;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				if (value < mLowerBound)
+					value = mLowerBound;
+				else if (value > mUpperBound)
+					value = mUpperBound;
+				return value;
+			}
 	};
 
 	/** Module clamping the value of the source module.
@@ -140,21 +227,27 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				if (pipe->getElement(first)->getRange().isInside (mLowerBound, mUpperBound))
+					return pipe->addAlias (this, first);
 				return pipe->addElement (this, new ClampElement1D(pipe, first, mLowerBound, mUpperBound));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				if (pipe->getElement(first)->getRange().isInside (mLowerBound, mUpperBound))
+					return pipe->addAlias (this, first);
 				return pipe->addElement (this, new ClampElement2D(pipe, first, mLowerBound, mUpperBound));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				if (pipe->getElement(first)->getRange().isInside (mLowerBound, mUpperBound))
+					return pipe->addAlias (this, first);
 				return pipe->addElement (this, new ClampElement3D(pipe, first, mLowerBound, mUpperBound));
 			}
 			/// @copydoc noisepp::Module::getType()
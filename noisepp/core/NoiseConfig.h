@@ -35,6 +35,12 @@
 #define NOISEPP_DOUBLE_PRECISION 0
 #endif
 
+// With double precision, evaluates the noise generators in float after splitting the coordinates
+// into lattice cell and offset in double, which keeps far away coordinates exact at float speed
+#ifndef NOISEPP_MIXED_PRECISION
+#define NOISEPP_MIXED_PRECISION 0
+#endif
+
 #ifndef NOISEPP_BIG_ENDIAN
 #define NOISEPP_BIG_ENDIAN 0
 #endif
@@ -43,4 +49,27 @@
 #define NOISEPP_ENABLE_UTILS 1
 #endif
 
+// Defines whether pipelines count cache hits, cache misses and sampled cycles per element (see Pipeline::getProfile)
+#ifndef NOISEPP_ENABLE_PROFILING
+#define NOISEPP_ENABLE_PROFILING 0
+#endif
+
+// Defines whether threaded pipelines and job queues can record their scheduling (see TraceRecorder)
+#ifndef NOISEPP_ENABLE_TRACING
+#define NOISEPP_ENABLE_TRACING 0
+#endif
+
+// Every n-th calculation of an element is timed when profiling is enabled, must be a power of two
+#ifndef NOISEPP_PROFILING_SAMPLE_INTERVAL
+#define NOISEPP_PROFILING_SAMPLE_INTERVAL 16
+#endif
+#if NOISEPP_PROFILING_SAMPLE_INTERVAL <= 0 || (NOISEPP_PROFILING_SAMPLE_INTERVAL & (NOISEPP_PROFILING_SAMPLE_INTERVAL-1)) != 0
+#error "NOISEPP_PROFILING_SAMPLE_INTERVAL must be a power of two"
+#endif
+
+// Minimum number of control points from which curve and terrace elements use a uniform-bin lookup table
+#ifndef NOISEPP_CONTROLPOINT_LUT_THRESHOLD
+#define NOISEPP_CONTROLPOINT_LUT_THRESHOLD 16
+#endif
+
 #endif
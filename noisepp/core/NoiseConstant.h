@@ -40,6 +40,11 @@ namespace noisepp
 		public:
 			ConstantElement (Real value) : mValue(value)
 			{
+				this->mRange = Interval (value);
+			}
+			virtual bool checkColumnar () const
+			{
+				return true;
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -53,6 +58,16 @@ namespace noisepp
 			{
 				return mValue;
 			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				dx = dy = Real(0.0);
+				return mValue;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				dx = dy = dz = Real(0.0);
+				return mValue;
+			}
 	};
 
 	typedef ConstantElement<PipelineElement1D> ConstantElement1D;
@@ -0,0 +1,139 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEPP_CONTROLPOINTLOOKUP_H
+#define NOISEPP_CONTROLPOINTLOOKUP_H
+
+#include "NoisePrerequisites.h"
+
+namespace noisepp
+{
+	/** Acceleration structure for looking up sorted control points.
+		Finds the index of the first control point greater than a value using a binary search.
+		For larger control point counts an additional uniform-bin lookup table narrows the search
+		down to the few control points inside the bin, so the lookup becomes O(1) on average.
+		The result is always exact, the bins are only used as a starting point.
+	*/
+	class ControlPointLookup
+	{
+		private:
+			Real *mKeys;
+			int mCount;
+			int *mBins;
+			int mBinCount;
+			Real mLower;
+			Real mBinScale;
+
+			NOISEPP_INLINE int search (Real value, int lo, int hi) const
+			{
+				while (lo < hi)
+				{
+					const int mid = (lo + hi) >> 1;
+					if (value < mKeys[mid])
+						hi = mid;
+					else
+						lo = mid + 1;
+				}
+				return lo;
+			}
+
+			ControlPointLookup (const ControlPointLookup &);
+			ControlPointLookup &operator= (const ControlPointLookup &);
+
+		public:
+			/// Constructor.
+			/// @param keys The sorted input values of the control points.
+			/// @param count The number of control points.
+			/// @param stride The distance between two keys in units of Real.
+			ControlPointLookup (const Real *keys, int count, int stride=1) : mKeys(NULL), mCount(count), mBins(NULL), mBinCount(0), mLower(0), mBinScale(0)
+			{
+				NoiseAssert (keys != NULL, keys);
+				NoiseAssert (count > 0, count);
+				mKeys = new Real[mCount];
+				for (int i=0;i<mCount;++i)
+				{
+					mKeys[i] = keys[i*stride];
+				}
+				const Real extent = mKeys[mCount-1] - mKeys[0];
+				if (mCount >= NOISEPP_CONTROLPOINT_LUT_THRESHOLD && extent > Real(0.0))
+				{
+					mBinCount = mCount * 4;
+					mBins = new int[mBinCount+1];
+					mLower = mKeys[0];
+					mBinScale = Real(mBinCount) / extent;
+					const Real binWidth = extent / Real(mBinCount);
+					for (int b=0;b<=mBinCount;++b)
+					{
+						mBins[b] = search (mLower + binWidth * Real(b), 0, mCount);
+					}
+				}
+			}
+			/// Destructor.
+			~ControlPointLookup ()
+			{
+				delete[] mKeys;
+				mKeys = NULL;
+				delete[] mBins;
+				mBins = NULL;
+			}
+			/// Returns true if the uniform-bin lookup table is used.
+			bool hasLookupTable () const
+			{
+				return mBins != NULL;
+			}
+			/// Returns the index of the first control point with an input value greater than the specified value
+			/// or the number of control points if there is none.
+			NOISEPP_INLINE int find (Real value) const
+			{
+				if (!(value < mKeys[mCount-1]))
+					return mCount;
+				if (value < mKeys[0])
+					return 0;
+				if (!mBins)
+					return search (value, 1, mCount-1);
+				int b = (int)((value - mLower) * mBinScale);
+				if (b >= mBinCount)
+					b = mBinCount - 1;
+				int lo = mBins[b];
+				int hi = mBins[b+1];
+				// the bin index may be off by one due to rounding, so widen to the neighbours if required
+				if (lo > 0 && value < mKeys[lo-1])
+					lo = (b > 0) ? mBins[b-1] : 0;
+				if (hi < mCount && !(value < mKeys[hi]))
+					hi = (b+2 <= mBinCount) ? mBins[b+2] : mCount;
+				return search (value, lo, hi);
+			}
+			/// Looks up the indices for a span of values.
+			NOISEPP_INLINE void find (const Real *values, int *indices, size_t count) const
+			{
+				for (size_t i=0;i<count;++i)
+				{
+					indices[i] = find (values[i]);
+				}
+			}
+	};
+};
+
+#endif // NOISEPP_CONTROLPOINTLOOKUP_H
@@ -28,6 +28,7 @@
 
 #include "NoisePipeline.h"
 #include "NoiseModule.h"
+#include "NoiseControlPointLookup.h"
 
 namespace noisepp
 {
@@ -55,6 +56,7 @@ namespace noisepp
 			const PipelineElement *mElementPtr;
 			CurveControlPoint *mControlPoints;
 			int mControlPointCount;
+			ControlPointLookup mLookup;
 
 			NOISEPP_INLINE int clampValue (int i, int lo, int hi) const
 			{
@@ -66,17 +68,25 @@ namespace noisepp
 					return i;
 			}
 
-			NOISEPP_INLINE Real mapValue (Real value) const
+			NOISEPP_INLINE Real interpolate (Real value, int index) const
 			{
-				int index;
-				for (index=0;index<mControlPointCount;++index)
+				const int index0 = clampValue (index-2, 0, mControlPointCount-1);
+				const int index1 = clampValue (index-1, 0, mControlPointCount-1);
+				const int index2 = clampValue (index, 0, mControlPointCount-1);
+				const int index3 = clampValue (index+1, 0, mControlPointCount-1);
+
+				if (index1 == index2)
 				{
-					if (value < mControlPoints[index].inValue)
-					{
-						break;
-					}
+					return mControlPoints[index1].outValue;
 				}
 
+				const Real in0 = mControlPoints[index1].inValue;
+				const Real in1 = mControlPoints[index2].inValue;
+				const Real a = (value - in0) / (in1 - in0);
+				return Math::InterpCubic (mControlPoints[index0].outValue, mControlPoints[index1].outValue, mControlPoints[index2].outValue, mControlPoints[index3].outValue, a);
+			}
+			NOISEPP_INLINE Real interpolate (Real value, int index, Real &slope) const
+			{
 				const int index0 = clampValue (index-2, 0, mControlPointCount-1);
 				const int index1 = clampValue (index-1, 0, mControlPointCount-1);
 				const int index2 = clampValue (index, 0, mControlPointCount-1);
@@ -84,26 +94,74 @@ namespace noisepp
 
 				if (index1 == index2)
 				{
+					slope = Real(0.0);
 					return mControlPoints[index1].outValue;
 				}
 
 				const Real in0 = mControlPoints[index1].inValue;
 				const Real in1 = mControlPoints[index2].inValue;
 				const Real a = (value - in0) / (in1 - in0);
-				return Math::InterpCubic (mControlPoints[index0].outValue, mControlPoints[index1].outValue, mControlPoints[index2].outValue, mControlPoints[index3].outValue, a);
+				const Real v0 = mControlPoints[index0].outValue;
+				const Real v1 = mControlPoints[index1].outValue;
+				const Real v2 = mControlPoints[index2].outValue;
+				const Real v3 = mControlPoints[index3].outValue;
+				slope = Math::InterpCubicDerivative (v0, v1, v2, v3, a) / (in1 - in0);
+				return Math::InterpCubic (v0, v1, v2, v3, a);
+			}
+			NOISEPP_INLINE Real mapValue (Real value) const
+			{
+				return interpolate (value, mLookup.find(value));
+			}
+			NOISEPP_INLINE Real mapValue (Real value, Real &slope) const
+			{
+				return interpolate (value, mLookup.find(value), slope);
 			}
 		public:
-			CurveElementBase (const Pipeline<PipelineElement> *pipe, ElementID element, CurveControlPoint *points, int count) : mElement(element), mControlPoints(points), mControlPointCount(count)
+			CurveElementBase (const Pipeline<PipelineElement> *pipe, ElementID element, CurveControlPoint *points, int count) : mElement(element), mControlPoints(points), mControlPointCount(count), mLookup(&points->inValue, count, sizeof(CurveControlPoint)/sizeof(Real))
 			{
 				NoiseAssert (points != NULL, points);
 				NoiseAssert (count >= 4, count);
 				mElementPtr = pipe->getElement (mElement);
+				// the cubic interpolation may overshoot, so each segment is bounded by the sum of its coefficients
+				Interval range (points[0].outValue);
+				for (int i=0;i<count-1;++i)
+				{
+					const Real v0 = points[clampValue (i-1, 0, count-1)].outValue;
+					const Real v1 = points[i].outValue;
+					const Real v2 = points[i+1].outValue;
+					const Real v3 = points[clampValue (i+2, 0, count-1)].outValue;
+					const Real x = v3 - v2 - v0 + v1;
+					const Real d = std::fabs (x) + std::fabs (v0 - v1 - x) + std::fabs (v2 - v0);
+					range = Interval::Hull (range, Interval (v1 - d, v1 + d));
+				}
+				this->mRange = range;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
 			}
 			virtual ~CurveElementBase ()
 			{
 				delete[] mControlPoints;
 				mControlPoints = NULL;
 			}
+			/// Maps a span of source values onto the curve.
+			void mapValues (const Real *in, Real *out, size_t count) const
+			{
+				int indices[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					mLookup.find (in, indices, n);
+					for (size_t i=0;i<n;++i)
+					{
+						out[i] = interpolate (in[i], indices[i]);
+					}
+					in += n;
+					out += n;
+					count -= n;
+				}
+			}
 	};
 
 	class CurveElement1D : public CurveElementBase<PipelineElement1D>
@@ -112,12 +170,23 @@ namespace noisepp
 			CurveElement1D (const Pipeline1D *pipe, ElementID element, CurveControlPoint *points, int count) : CurveElementBase<PipelineElement1D>(pipe, element, points, count)
 			{
 			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				CurveElementBase<PipelineElement1D>::mapValues (values, values, count);
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				Real value;
 				value = getElementValue (mElementPtr, mElement, x, cache);
 				return CurveElementBase<PipelineElement1D>::mapValue(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				return CurveElementBase<PipelineElement1D>::mapValue(value);
+			}
 	};
 
 	class CurveElement2D : public CurveElementBase<PipelineElement2D>
@@ -126,12 +195,32 @@ namespace noisepp
 			CurveElement2D (const Pipeline2D *pipe, ElementID element, CurveControlPoint *points, int count) : CurveElementBase<PipelineElement2D>(pipe, element, points, count)
 			{
 			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				CurveElementBase<PipelineElement2D>::mapValues (values, values, count);
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real value;
 				value = getElementValue (mElementPtr, mElement, x, y, cache);
 				return CurveElementBase<PipelineElement2D>::mapValue(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				return CurveElementBase<PipelineElement2D>::mapValue(value);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x, y, dx, dy, cache);
+				Real slope;
+				const Real result = CurveElementBase<PipelineElement2D>::mapValue(value, slope);
+				dx *= slope;
+				dy *= slope;
+				return result;
+			}
 	};
 
 	class CurveElement3D : public CurveElementBase<PipelineElement3D>
@@ -140,12 +229,33 @@ namespace noisepp
 			CurveElement3D (const Pipeline3D *pipe, ElementID element, CurveControlPoint *points, int count) : CurveElementBase<PipelineElement3D>(pipe, element, points, count)
 			{
 			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				CurveElementBase<PipelineElement3D>::mapValues (values, values, count);
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real value;
 				value = getElementValue (mElementPtr, mElement, x, y, z, cache);
 				return CurveElementBase<PipelineElement3D>::mapValue(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				return CurveElementBase<PipelineElement3D>::mapValue(value);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x, y, z, dx, dy, dz, cache);
+				Real slope;
+				const Real result = CurveElementBase<PipelineElement3D>::mapValue(value, slope);
+				dx *= slope;
+				dy *= slope;
+				dz *= slope;
+				return result;
+			}
 	};
 
 	/** Module that maps the values from the source module onto a curve.
@@ -184,7 +294,7 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				int count = (int)mControlPoints.size ();
 				NoiseAssert (count >= 4, count);
 				CurveControlPoint *points = new CurveControlPoint[count];
@@ -198,7 +308,7 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				int count = (int)mControlPoints.size ();
 				NoiseAssert (count >= 4, count);
 				CurveControlPoint *points = new CurveControlPoint[count];
@@ -212,7 +322,7 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				int count = (int)mControlPoints.size ();
 				NoiseAssert (count >= 4, count);
 				CurveControlPoint *points = new CurveControlPoint[count];
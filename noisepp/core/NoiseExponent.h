@@ -31,6 +31,16 @@
 
 namespace noisepp
 {
+	/// Returns the output range of the exponent function for the specified input range.
+	/// The exponent must not be negative.
+	inline Interval calcExponentRange (const Interval &range, Real exponent)
+	{
+		if (!range.isBounded ())
+			return Interval (Real(-1.0), std::numeric_limits<Real>::infinity());
+		const Interval base = ((range + Real(1.0)) * Real(0.5)).abs ();
+		return Interval (std::pow (base.lower, exponent) * Real(2.0) - Real(1.0), std::pow (base.upper, exponent) * Real(2.0) - Real(1.0));
+	}
+
 	class ExponentElement1D : public PipelineElement1D
 	{
 		private:
@@ -42,6 +52,18 @@ namespace noisepp
 			ExponentElement1D (const Pipeline1D *pipe, ElementID element, Real exponent) : mElement(element), mExponent(exponent)
 			{
 				mElementPtr = pipe->getElement(element);
+				if (mExponent >= Real(0.0))
+					mRange = calcExponentRange (mElementPtr->getRange(), mExponent);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = std::pow (std::fabs ((values[i] + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0);
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -49,6 +71,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, cache);
 				return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
+			}
 	};
 
 	class ExponentElement2D : public PipelineElement2D
@@ -62,6 +90,24 @@ namespace noisepp
 			ExponentElement2D (const Pipeline2D *pipe, ElementID element, Real exponent) : mElement(element), mExponent(exponent)
 			{
 				mElementPtr = pipe->getElement(element);
+				if (mExponent >= Real(0.0))
+					mRange = calcExponentRange (mElementPtr->getRange(), mExponent);
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				if (mExponent >= Real(0.0))
+					return calcExponentRange (mElementPtr->getRegionRange (x, y), mExponent);
+				return mRange;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = std::pow (std::fabs ((values[i] + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0);
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -69,6 +115,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, cache);
 				return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
+			}
 	};
 
 	class ExponentElement3D : public PipelineElement3D
@@ -82,6 +134,24 @@ namespace noisepp
 			ExponentElement3D (const Pipeline3D *pipe, ElementID element, Real exponent) : mElement(element), mExponent(exponent)
 			{
 				mElementPtr = pipe->getElement(element);
+				if (mExponent >= Real(0.0))
+					mRange = calcExponentRange (mElementPtr->getRange(), mExponent);
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				if (mExponent >= Real(0.0))
+					return calcExponentRange (mElementPtr->getRegionRange (x, y, z), mExponent);
+				return mRange;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = std::pow (std::fabs ((values[i] + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0);
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -89,6 +159,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, z, cache);
 				return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
+			}
 	};
 
 	/** Exponent module.
@@ -118,21 +194,21 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new ExponentElement1D(pipe, first, mExponent));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new ExponentElement2D(pipe, first, mExponent));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new ExponentElement3D(pipe, first, mExponent));
 			}
 			/// @copydoc noisepp::Module::getType()
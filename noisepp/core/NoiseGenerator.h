@@ -28,7 +28,9 @@
 
 #include "NoiseMath.h"
 #include "NoiseVectorTable.h"
+#include "NoiseInterval.h"
 #include "NoisePlatform.h"
+#include "NoiseWorldCoord.h"
 
 namespace noisepp
 {
@@ -64,30 +66,92 @@ namespace noisepp
 
 	const Real FAST_NOISE_SCALE_FACTOR = 0.5;
 
+	/// Maximum number of lattice cells a box may cover for the cell-wise range calculation.
+	const int NOISE_RANGE_MAX_CELLS = 512;
+
+	/// Returns how far the noise functions may differ from their exact value because of rounding.
+	/// The kernels run a few dozen operations in KernelReal precision on values inside the specified bound.
+	inline Real calcKernelRoundingSlack (Real bound)
+	{
+		return bound * Real(std::numeric_limits<KernelReal>::epsilon()) * Real(64.0);
+	}
+
+	/// Returns the lattice cell of the specified coordinate the same way the noise functions do.
+	inline int calcLatticeCell (Real v)
+	{
+		return (v > Real(0.0) ? (int)v : (int)v - 1);
+	}
+
+	/// Returns the interpolation weight of the specified quality for an offset inside a lattice cell and its derivative.
+	inline Real calcInterpolationCurve (Real offset, int quality, Real &derivative)
+	{
+		if (quality == NOISE_QUALITY_HIGH || quality == NOISE_QUALITY_FAST_HIGH)
+		{
+			derivative = Math::CubicCurve5Derivative (offset);
+			return Math::CubicCurve5 (offset);
+		}
+		else if (quality == NOISE_QUALITY_STD || quality == NOISE_QUALITY_FAST_STD)
+		{
+			derivative = Math::CubicCurve3Derivative (offset);
+			return Math::CubicCurve3 (offset);
+		}
+		derivative = Real(1.0);
+		return offset;
+	}
+
+	/// Returns the range of the interpolation weights for the specified range of offsets inside a lattice cell.
+	/// The weights are widened by a few ulps to account for the rounding of the interpolation curves.
+	inline Interval calcInterpolationWeight (const Interval &offset, int quality)
+	{
+		const Real lower = (std::max) (offset.lower, Real(0.0));
+		const Real upper = (std::min) (offset.upper, Real(1.0));
+		const Real slack = std::numeric_limits<Real>::epsilon() * Real(4.0);
+		Real wlower = lower, wupper = upper;
+		if (quality == NOISE_QUALITY_HIGH || quality == NOISE_QUALITY_FAST_HIGH)
+		{
+			wlower = Math::CubicCurve5 (lower);
+			wupper = Math::CubicCurve5 (upper);
+		}
+		else if (quality == NOISE_QUALITY_STD || quality == NOISE_QUALITY_FAST_STD)
+		{
+			wlower = Math::CubicCurve3 (lower);
+			wupper = Math::CubicCurve3 (upper);
+		}
+		wlower = (std::min) ((std::max) (wlower - slack, Real(0.0)), Real(1.0));
+		wupper = (std::max) ((std::min) (wupper + slack, Real(1.0)), wlower);
+		return Interval (wlower, wupper);
+	}
+
+	/// Returns the range of the linear interpolation between the specified ranges.
+	/// The interpolation is linear in the weight, so the extremes are found at the bounds of the weight.
+	inline Interval interpLinearRange (const Interval &left, const Interval &right, const Interval &a)
+	{
+		return Interval::Hull (left * (Real(1.0) - a.lower) + right * a.lower, left * (Real(1.0) - a.upper) + right * a.upper);
+	}
+
 	class Generator1D
 	{
 		private:
-			static NOISEPP_INLINE Real calcGradientNoise (Real fx, int ix, int seed)
+			static NOISEPP_INLINE KernelReal calcGradientNoise (KernelReal xDelta, int ix, int seed)
 			{
 				int vIndex = (NOISE_X_FACTOR * ix + NOISE_SEED_FACTOR * seed) & 0xffffffff;
 				vIndex ^= (vIndex >> NOISE_SHIFT);
 				vIndex &= 0xff;
 
-				const Real xGradient = randomVectors3D[(vIndex<<2)];
+				const KernelReal xGradient = randomVectors3D[(vIndex<<2)];
 
-				const Real xDelta = fx - Real(ix);
 				return xDelta * xGradient;
 			}
 
-			static NOISEPP_INLINE Real interpGradientCoherentNoise (Real x, int x0, int x1, Real xs, int seed, Real scale)
+			static NOISEPP_INLINE KernelReal interpGradientCoherentNoise (KernelReal xf, KernelReal xf1, int x0, int x1, KernelReal xs, int seed, KernelReal scale)
 			{
-				Real n0, n1;
-				n0 = calcGradientNoise(x, x0, seed);
-				n1 = calcGradientNoise(x, x1, seed);
+				KernelReal n0, n1;
+				n0 = calcGradientNoise(xf, x0, seed);
+				n1 = calcGradientNoise(xf1, x1, seed);
 				return Math::InterpLinear (n0, n1, xs) * scale;
 			}
 
-			static NOISEPP_INLINE Real calcGradientFastNoise (Real fx, int ix, int seed)
+			static NOISEPP_INLINE KernelReal calcGradientFastNoise (KernelReal xDelta, int ix, int seed)
 			{
 				int vIndex = (NOISE_X_FACTOR * ix + NOISE_SEED_FACTOR * seed) & 0xffffffff;
 				vIndex ^= (vIndex >> NOISE_SHIFT);
@@ -95,11 +159,11 @@ namespace noisepp
 				return gradientVector[vIndex];
 			}
 
-			static NOISEPP_INLINE Real interpGradientCoherentFastNoise (Real x, int x0, int x1, Real xs, int seed, Real scale)
+			static NOISEPP_INLINE KernelReal interpGradientCoherentFastNoise (KernelReal xf, int x0, int x1, KernelReal xs, int seed, KernelReal scale)
 			{
-				Real n0, n1;
-				n0 = calcGradientFastNoise(x, x0, seed);
-				n1 = calcGradientFastNoise(x, x1, seed);
+				KernelReal n0, n1;
+				n0 = calcGradientFastNoise(xf, x0, seed);
+				n1 = calcGradientFastNoise(xf, x1, seed);
 				return Math::InterpLinear (n0, n1, xs) * scale;
 			}
 
@@ -110,58 +174,98 @@ namespace noisepp
 				return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
 			}
 		public:
+			/// Returns a bound for the absolute value of the gradient coherent noise functions, including their rounding.
+			static NOISEPP_INLINE Real calcGradientCoherentNoiseBound (int quality, Real scale)
+			{
+				const Real bound = std::fabs (scale);
+				return bound + calcKernelRoundingSlack (bound);
+			}
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseHigh (Real x, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_1D;
 
-				const Real xs = Math::CubicCurve5 (x - Real(x0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal xs = Math::CubicCurve5 (xf);
 
-				return interpGradientCoherentNoise (x, x0, x1, xs, seed, scale);
+				return interpGradientCoherentNoise (xf, xf1, x0, x1, xs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseStd (Real x, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_1D;
 
-				const Real xs = Math::CubicCurve3 (x - Real(x0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal xs = Math::CubicCurve3 (xf);
 
-				return interpGradientCoherentNoise (x, x0, x1, xs, seed, scale);
+				return interpGradientCoherentNoise (xf, xf1, x0, x1, xs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseLow (Real x, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_1D;
 
-				const Real xs = x - Real(x0);
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal xs = xf;
 
-				return interpGradientCoherentNoise (x, x0, x1, xs, seed, scale);
+				return interpGradientCoherentNoise (xf, xf1, x0, x1, xs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseHigh (Real x, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_1D;
 
-				const Real xs = Math::CubicCurve5 (x - Real(x0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xs = Math::CubicCurve5 (xf);
 
-				return interpGradientCoherentFastNoise (x, x0, x1, xs, seed, scale);
+				return interpGradientCoherentFastNoise (xf, x0, x1, xs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseStd (Real x, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_1D;
 
-				const Real xs = Math::CubicCurve3 (x - Real(x0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xs = Math::CubicCurve3 (xf);
 
-				return interpGradientCoherentFastNoise (x, x0, x1, xs, seed, scale);
+				return interpGradientCoherentFastNoise (xf, x0, x1, xs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseLow (Real x, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_1D;
 
-				const Real xs = x - Real(x0);
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xs = xf;
 
-				return interpGradientCoherentFastNoise (x, x0, x1, xs, seed, scale);
+				return interpGradientCoherentFastNoise (xf, x0, x1, xs, seed, KernelReal(scale));
+			}
+
+			/// Applies the interpolation curve of the specified quality.
+			static NOISEPP_INLINE KernelReal calcQualityCurve (KernelReal t, int quality)
+			{
+				if (quality == NOISE_QUALITY_HIGH || quality == NOISE_QUALITY_FAST_HIGH)
+					return Math::CubicCurve5 (t);
+				else if (quality == NOISE_QUALITY_STD || quality == NOISE_QUALITY_FAST_STD)
+					return Math::CubicCurve3 (t);
+				else
+					return t;
+			}
+
+			/// Calculates coherent gradient noise of the specified quality at a world coordinate multiplied by frequency.
+			static NOISEPP_INLINE Real calcGradientCoherentNoise (const WorldCoord &x, Real frequency, int seed, int quality, Real scale)
+			{
+				int x0;
+				KernelReal xf, xf1;
+				x.getLattice (frequency, x0, xf, xf1);
+				const int x1 = x0 + 1;
+				const KernelReal xs = calcQualityCurve (xf, quality);
+
+				if (quality > NOISE_QUALITY_HIGH)
+					return interpGradientCoherentFastNoise (xf, x0, x1, xs, seed, KernelReal(scale));
+				return interpGradientCoherentNoise (xf, xf1, x0, x1, xs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcNoise (int x, int seed)
@@ -172,33 +276,31 @@ namespace noisepp
 	class Generator2D
 	{
 		private:
-			static NOISEPP_INLINE Real calcGradientNoise (Real fx, Real fy, int ix, int iy, int seed)
+			static NOISEPP_INLINE KernelReal calcGradientNoise (KernelReal xDelta, KernelReal yDelta, int ix, int iy, int seed)
 			{
 				int vIndex = (NOISE_X_FACTOR * ix + NOISE_Y_FACTOR * iy + NOISE_SEED_FACTOR * seed) & 0xffffffff;
 				vIndex ^= (vIndex >> NOISE_SHIFT);
 				vIndex &= 0xff;
 
-				const Real xGradient = randomVectors3D[(vIndex<<2)];
-				const Real yGradient = randomVectors3D[(vIndex<<2)+1];
+				const KernelReal xGradient = randomVectors3D[(vIndex<<2)];
+				const KernelReal yGradient = randomVectors3D[(vIndex<<2)+1];
 
-				const Real xDelta = fx - Real(ix);
-				const Real yDelta = fy - Real(iy);
 				return (xGradient * xDelta + yGradient * yDelta);
 			}
 
-			static NOISEPP_INLINE Real interpGradientCoherentNoise (Real x, Real y, int x0, int x1, int y0, int y1, Real xs, Real ys, int seed, Real scale)
+			static NOISEPP_INLINE KernelReal interpGradientCoherentNoise (KernelReal xf, KernelReal yf, KernelReal xf1, KernelReal yf1, int x0, int x1, int y0, int y1, KernelReal xs, KernelReal ys, int seed, KernelReal scale)
 			{
-				Real n0, n1, ix0, ix1;
-				n0 = calcGradientNoise(x, y, x0, y0, seed);
-				n1 = calcGradientNoise(x, y, x1, y0, seed);
+				KernelReal n0, n1, ix0, ix1;
+				n0 = calcGradientNoise(xf, yf, x0, y0, seed);
+				n1 = calcGradientNoise(xf1, yf, x1, y0, seed);
 				ix0 = Math::InterpLinear (n0, n1, xs);
-				n0 = calcGradientNoise(x, y, x0, y1, seed);
-				n1 = calcGradientNoise(x, y, x1, y1, seed);
+				n0 = calcGradientNoise(xf, yf1, x0, y1, seed);
+				n1 = calcGradientNoise(xf1, yf1, x1, y1, seed);
 				ix1 = Math::InterpLinear (n0, n1, xs);
 				return Math::InterpLinear (ix0, ix1, ys) * scale;
 			}
 
-			static NOISEPP_INLINE Real calcGradientFastNoise (Real fx, Real fy, int ix, int iy, int seed)
+			static NOISEPP_INLINE KernelReal calcGradientFastNoise (KernelReal xDelta, KernelReal yDelta, int ix, int iy, int seed)
 			{
 				int vIndex = (NOISE_X_FACTOR * ix + NOISE_Y_FACTOR * iy + NOISE_SEED_FACTOR * seed) & 0xffffffff;
 				vIndex ^= (vIndex >> NOISE_SHIFT);
@@ -206,14 +308,14 @@ namespace noisepp
 				return gradientVector[vIndex];
 			}
 
-			static NOISEPP_INLINE Real interpGradientCoherentFastNoise (Real x, Real y, int x0, int x1, int y0, int y1, Real xs, Real ys, int seed, Real scale)
+			static NOISEPP_INLINE KernelReal interpGradientCoherentFastNoise (KernelReal xf, KernelReal yf, int x0, int x1, int y0, int y1, KernelReal xs, KernelReal ys, int seed, KernelReal scale)
 			{
-				Real n0, n1, ix0, ix1;
-				n0 = calcGradientFastNoise(x, y, x0, y0, seed);
-				n1 = calcGradientFastNoise(x, y, x1, y0, seed);
+				KernelReal n0, n1, ix0, ix1;
+				n0 = calcGradientFastNoise(xf, yf, x0, y0, seed);
+				n1 = calcGradientFastNoise(xf, yf, x1, y0, seed);
 				ix0 = Math::InterpLinear (n0, n1, xs);
-				n0 = calcGradientFastNoise(x, y, x0, y1, seed);
-				n1 = calcGradientFastNoise(x, y, x1, y1, seed);
+				n0 = calcGradientFastNoise(xf, yf, x0, y1, seed);
+				n1 = calcGradientFastNoise(xf, yf, x1, y1, seed);
 				ix1 = Math::InterpLinear (n0, n1, xs);
 				return Math::InterpLinear (ix0, ix1, ys) * scale;
 			}
@@ -224,65 +326,198 @@ namespace noisepp
 				n = (n >> 13) ^ n;
 				return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
 			}
+
+			static NOISEPP_INLINE int calcGradientIndex (int ix, int iy, int seed)
+			{
+				int vIndex = (NOISE_X_FACTOR * ix + NOISE_Y_FACTOR * iy + NOISE_SEED_FACTOR * seed) & 0xffffffff;
+				vIndex ^= (vIndex >> NOISE_SHIFT);
+				return vIndex & 0xff;
+			}
+
 		public:
+			/// Returns a bound for the absolute value of the gradient coherent noise functions, including their rounding.
+			/// The standard gradients are scaled by the offset to the lattice point which is at most sqrt(2) long.
+			static NOISEPP_INLINE Real calcGradientCoherentNoiseBound (int quality, Real scale)
+			{
+				const Real bound = (quality > NOISE_QUALITY_HIGH) ? std::fabs (scale) : std::fabs (scale) * Real(1.4142135623730951);
+				return bound + calcKernelRoundingSlack (bound);
+			}
+			/// Returns a conservative range of the gradient coherent noise inside the specified box.
+			/// Inside each lattice cell covered by the box, the ranges of the corner gradient functions are
+			/// interpolated with the range of the interpolation weights.
+			/// Boxes covering more than NOISE_RANGE_MAX_CELLS cells return the global bound.
+			static Interval calcGradientCoherentNoiseRange (const Interval &x, const Interval &y, int seed, int quality, Real scale)
+			{
+				const Real bound = calcGradientCoherentNoiseBound (quality, scale);
+				const int x0 = calcLatticeCell (x.lower);
+				const int x1 = calcLatticeCell (x.upper);
+				const int y0 = calcLatticeCell (y.lower);
+				const int y1 = calcLatticeCell (y.upper);
+				if ((x1 - x0 + 1) * (y1 - y0 + 1) > NOISE_RANGE_MAX_CELLS)
+					return Interval (-bound, bound);
+				const bool fast = (quality > NOISE_QUALITY_HIGH);
+				bool first = true;
+				Interval range;
+				for (int iy=y0;iy<=y1;++iy)
+				{
+					const Interval cellY ((std::max)(y.lower, Real(iy)), (std::min)(y.upper, Real(iy+1)));
+					const Interval ys = calcInterpolationWeight (cellY + Real(-iy), quality);
+					for (int ix=x0;ix<=x1;++ix)
+					{
+						const Interval cellX ((std::max)(x.lower, Real(ix)), (std::min)(x.upper, Real(ix+1)));
+						const Interval xs = calcInterpolationWeight (cellX + Real(-ix), quality);
+						Interval n[4];
+						for (int c=0;c<4;++c)
+						{
+							const int cx = ix + (c & 1);
+							const int cy = iy + (c >> 1);
+							const int vIndex = calcGradientIndex (cx, cy, seed);
+							if (fast)
+								n[c] = Interval (gradientVector[vIndex]);
+							else
+								n[c] = (cellX + Real(-cx)) * randomVectors3D[(vIndex<<2)] + (cellY + Real(-cy)) * randomVectors3D[(vIndex<<2)+1];
+						}
+						const Interval cell = interpLinearRange (interpLinearRange (n[0], n[1], xs), interpLinearRange (n[2], n[3], xs), ys);
+						range = first ? cell : Interval::Hull (range, cell);
+						first = false;
+					}
+				}
+				return Interval::Intersect ((range * scale).widen (calcKernelRoundingSlack (bound)), Interval (-bound, bound));
+			}
+			/// Calculates the gradient coherent noise of the specified quality and its partial derivatives.
+			/// The derivatives are calculated analytically through the interpolation curve.
+			static Real calcGradientCoherentNoiseGradient (Real x, Real y, int seed, int quality, Real scale, Real &dx, Real &dy)
+			{
+				NOISE_GENERATOR_INTEGER_CLAMP_2D;
+
+				Real dxs, dys;
+				const Real xs = calcInterpolationCurve (x - Real(x0), quality, dxs);
+				const Real ys = calcInterpolationCurve (y - Real(y0), quality, dys);
+
+				const bool fast = (quality > NOISE_QUALITY_HIGH);
+				Real n[4], gx[4], gy[4];
+				for (int c=0;c<4;++c)
+				{
+					const int ix = (c & 1) ? x1 : x0;
+					const int iy = (c >> 1) ? y1 : y0;
+					const int vIndex = calcGradientIndex (ix, iy, seed);
+					if (fast)
+					{
+						n[c] = gradientVector[vIndex];
+						gx[c] = gy[c] = Real(0.0);
+					}
+					else
+					{
+						gx[c] = randomVectors3D[(vIndex<<2)];
+						gy[c] = randomVectors3D[(vIndex<<2)+1];
+						n[c] = gx[c] * (x - Real(ix)) + gy[c] * (y - Real(iy));
+					}
+				}
+
+				const Real ix0 = Math::InterpLinear (n[0], n[1], xs);
+				const Real ix1 = Math::InterpLinear (n[2], n[3], xs);
+				const Real dix0 = Math::InterpLinear (gx[0], gx[1], xs) + (n[1] - n[0]) * dxs;
+				const Real dix1 = Math::InterpLinear (gx[2], gx[3], xs) + (n[3] - n[2]) * dxs;
+				const Real diy0 = Math::InterpLinear (gy[0], gy[1], xs);
+				const Real diy1 = Math::InterpLinear (gy[2], gy[3], xs);
+
+				dx = Math::InterpLinear (dix0, dix1, ys) * scale;
+				dy = (Math::InterpLinear (diy0, diy1, ys) + (ix1 - ix0) * dys) * scale;
+				return Math::InterpLinear (ix0, ix1, ys) * scale;
+			}
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseHigh (Real x, Real y, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_2D;
 
-				const Real xs = Math::CubicCurve5 (x - Real(x0));
-				const Real ys = Math::CubicCurve5 (y - Real(y0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal yf1 = KernelReal(y - Real(y1));
+				const KernelReal xs = Math::CubicCurve5 (xf);
+				const KernelReal ys = Math::CubicCurve5 (yf);
 
-				return interpGradientCoherentNoise (x, y, x0, x1, y0, y1, xs, ys, seed, scale);
+				return interpGradientCoherentNoise (xf, yf, xf1, yf1, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseStd (Real x, Real y, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_2D;
 
-				const Real xs = Math::CubicCurve3 (x - Real(x0));
-				const Real ys = Math::CubicCurve3 (y - Real(y0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal yf1 = KernelReal(y - Real(y1));
+				const KernelReal xs = Math::CubicCurve3 (xf);
+				const KernelReal ys = Math::CubicCurve3 (yf);
 
-				return interpGradientCoherentNoise (x, y, x0, x1, y0, y1, xs, ys, seed, scale);
+				return interpGradientCoherentNoise (xf, yf, xf1, yf1, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseLow (Real x, Real y, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_2D;
 
-				const Real xs = x - Real(x0);
-				const Real ys = y - Real(y0);
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal yf1 = KernelReal(y - Real(y1));
+				const KernelReal xs = xf;
+				const KernelReal ys = yf;
 
-				return interpGradientCoherentNoise (x, y, x0, x1, y0, y1, xs, ys, seed, scale);
+				return interpGradientCoherentNoise (xf, yf, xf1, yf1, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseHigh (Real x, Real y, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_2D;
 
-				const Real xs = Math::CubicCurve5 (x - Real(x0));
-				const Real ys = Math::CubicCurve5 (y - Real(y0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal xs = Math::CubicCurve5 (xf);
+				const KernelReal ys = Math::CubicCurve5 (yf);
 
-				return interpGradientCoherentFastNoise (x, y, x0, x1, y0, y1, xs, ys, seed, scale);
+				return interpGradientCoherentFastNoise (xf, yf, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseStd (Real x, Real y, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_2D;
 
-				const Real xs = Math::CubicCurve3 (x - Real(x0));
-				const Real ys = Math::CubicCurve3 (y - Real(y0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal xs = Math::CubicCurve3 (xf);
+				const KernelReal ys = Math::CubicCurve3 (yf);
 
-				return interpGradientCoherentFastNoise (x, y, x0, x1, y0, y1, xs, ys, seed, scale);
+				return interpGradientCoherentFastNoise (xf, yf, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseLow (Real x, Real y, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_2D;
 
-				const Real xs = x - Real(x0);
-				const Real ys = y - Real(y0);
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal xs = xf;
+				const KernelReal ys = yf;
+
+				return interpGradientCoherentFastNoise (xf, yf, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
+			}
+
+			/// Calculates coherent gradient noise of the specified quality at a world coordinate multiplied by frequency.
+			static NOISEPP_INLINE Real calcGradientCoherentNoise (const WorldCoord &x, const WorldCoord &y, Real frequency, int seed, int quality, Real scale)
+			{
+				int x0, y0;
+				KernelReal xf, yf, xf1, yf1;
+				x.getLattice (frequency, x0, xf, xf1);
+				y.getLattice (frequency, y0, yf, yf1);
+				const int x1 = x0 + 1;
+				const int y1 = y0 + 1;
+				const KernelReal xs = Generator1D::calcQualityCurve (xf, quality);
+				const KernelReal ys = Generator1D::calcQualityCurve (yf, quality);
 
-				return interpGradientCoherentFastNoise (x, y, x0, x1, y0, y1, xs, ys, seed, scale);
+				if (quality > NOISE_QUALITY_HIGH)
+					return interpGradientCoherentFastNoise (xf, yf, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
+				return interpGradientCoherentNoise (xf, yf, xf1, yf1, x0, x1, y0, y1, xs, ys, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcNoise (int x, int y, int seed=0)
@@ -293,65 +528,62 @@ namespace noisepp
 	class Generator3D
 	{
 		private:
-			static NOISEPP_INLINE Real calcGradientNoise (Real fx, Real fy, Real fz, int ix, int iy, int iz, int seed)
+			static NOISEPP_INLINE KernelReal calcGradientNoise (KernelReal xDelta, KernelReal yDelta, KernelReal zDelta, int ix, int iy, int iz, int seed)
 			{
 				int vIndex = (NOISE_X_FACTOR * ix + NOISE_Y_FACTOR * iy + NOISE_Z_FACTOR * iz + NOISE_SEED_FACTOR * seed) & 0xffffffff;
 				vIndex ^= (vIndex >> NOISE_SHIFT);
 				vIndex &= 0xff;
 
-				const Real xGradient = randomVectors3D[(vIndex<<2)];
-				const Real yGradient = randomVectors3D[(vIndex<<2)+1];
-				const Real zGradient = randomVectors3D[(vIndex<<2)+2];
+				const KernelReal xGradient = randomVectors3D[(vIndex<<2)];
+				const KernelReal yGradient = randomVectors3D[(vIndex<<2)+1];
+				const KernelReal zGradient = randomVectors3D[(vIndex<<2)+2];
 
-				const Real xDelta = fx - Real(ix);
-				const Real yDelta = fy - Real(iy);
-				const Real zDelta = fz - Real(iz);
 				return (xGradient * xDelta + yGradient * yDelta + zGradient * zDelta);
 			}
 
-			static NOISEPP_INLINE Real interpGradientCoherentNoise (Real x, Real y, Real z, int x0, int x1, int y0, int y1, int z0, int z1, Real xs, Real ys, Real zs, int seed, Real scale)
+			static NOISEPP_INLINE KernelReal interpGradientCoherentNoise (KernelReal xf, KernelReal yf, KernelReal zf, KernelReal xf1, KernelReal yf1, KernelReal zf1, int x0, int x1, int y0, int y1, int z0, int z1, KernelReal xs, KernelReal ys, KernelReal zs, int seed, KernelReal scale)
 			{
-				Real n0, n1, ix0, ix1, iy0, iy1;
-				n0 = calcGradientNoise(x, y, z, x0, y0, z0, seed);
-				n1 = calcGradientNoise(x, y, z, x1, y0, z0, seed);
+				KernelReal n0, n1, ix0, ix1, iy0, iy1;
+				n0 = calcGradientNoise(xf, yf, zf, x0, y0, z0, seed);
+				n1 = calcGradientNoise(xf1, yf, zf, x1, y0, z0, seed);
 				ix0 = Math::InterpLinear (n0, n1, xs);
-				n0 = calcGradientNoise(x, y, z, x0, y1, z0, seed);
-				n1 = calcGradientNoise(x, y, z, x1, y1, z0, seed);
+				n0 = calcGradientNoise(xf, yf1, zf, x0, y1, z0, seed);
+				n1 = calcGradientNoise(xf1, yf1, zf, x1, y1, z0, seed);
 				ix1 = Math::InterpLinear (n0, n1, xs);
 				iy0 = Math::InterpLinear (ix0, ix1, ys);
-				n0 = calcGradientNoise(x, y, z, x0, y0, z1, seed);
-				n1 = calcGradientNoise(x, y, z, x1, y0, z1, seed);
+				n0 = calcGradientNoise(xf, yf, zf1, x0, y0, z1, seed);
+				n1 = calcGradientNoise(xf1, yf, zf1, x1, y0, z1, seed);
 				ix0 = Math::InterpLinear (n0, n1, xs);
-				n0 = calcGradientNoise(x, y, z, x0, y1, z1, seed);
-				n1 = calcGradientNoise(x, y, z, x1, y1, z1, seed);
+				n0 = calcGradientNoise(xf, yf1, zf1, x0, y1, z1, seed);
+				n1 = calcGradientNoise(xf1, yf1, zf1, x1, y1, z1, seed);
 				ix1 = Math::InterpLinear (n0, n1, xs);
 				iy1 = Math::InterpLinear (ix0, ix1, ys);
 
 				return Math::InterpLinear (iy0, iy1, zs) * scale;
 			}
 
-			static NOISEPP_INLINE Real interpGradientCoherentFastNoise (Real x, Real y, Real z, int x0, int x1, int y0, int y1, int z0, int z1, Real xs, Real ys, Real zs, int seed, Real scale)
+			static NOISEPP_INLINE KernelReal interpGradientCoherentFastNoise (KernelReal xf, KernelReal yf, KernelReal zf, int x0, int x1, int y0, int y1, int z0, int z1, KernelReal xs, KernelReal ys, KernelReal zs, int seed, KernelReal scale)
 			{
-				Real n0, n1, ix0, ix1, iy0, iy1;
-				n0 = calcGradientFastNoise(x, y, z, x0, y0, z0, seed);
-				n1 = calcGradientFastNoise(x, y, z, x1, y0, z0, seed);
+				KernelReal n0, n1, ix0, ix1, iy0, iy1;
+				n0 = calcGradientFastNoise(xf, yf, zf, x0, y0, z0, seed);
+				n1 = calcGradientFastNoise(xf, yf, zf, x1, y0, z0, seed);
 				ix0 = Math::InterpLinear (n0, n1, xs);
-				n0 = calcGradientFastNoise(x, y, z, x0, y1, z0, seed);
-				n1 = calcGradientFastNoise(x, y, z, x1, y1, z0, seed);
+				n0 = calcGradientFastNoise(xf, yf, zf, x0, y1, z0, seed);
+				n1 = calcGradientFastNoise(xf, yf, zf, x1, y1, z0, seed);
 				ix1 = Math::InterpLinear (n0, n1, xs);
 				iy0 = Math::InterpLinear (ix0, ix1, ys);
-				n0 = calcGradientFastNoise(x, y, z, x0, y0, z1, seed);
-				n1 = calcGradientFastNoise(x, y, z, x1, y0, z1, seed);
+				n0 = calcGradientFastNoise(xf, yf, zf, x0, y0, z1, seed);
+				n1 = calcGradientFastNoise(xf, yf, zf, x1, y0, z1, seed);
 				ix0 = Math::InterpLinear (n0, n1, xs);
-				n0 = calcGradientFastNoise(x, y, z, x0, y1, z1, seed);
-				n1 = calcGradientFastNoise(x, y, z, x1, y1, z1, seed);
+				n0 = calcGradientFastNoise(xf, yf, zf, x0, y1, z1, seed);
+				n1 = calcGradientFastNoise(xf, yf, zf, x1, y1, z1, seed);
 				ix1 = Math::InterpLinear (n0, n1, xs);
 				iy1 = Math::InterpLinear (ix0, ix1, ys);
 
 				return Math::InterpLinear (iy0, iy1, zs) * scale;
 			}
 
-			static NOISEPP_INLINE Real calcGradientFastNoise (Real fx, Real fy, Real fz, int ix, int iy, int iz, int seed)
+			static NOISEPP_INLINE KernelReal calcGradientFastNoise (KernelReal xDelta, KernelReal yDelta, KernelReal zDelta, int ix, int iy, int iz, int seed)
 			{
 				int vIndex = (NOISE_X_FACTOR * ix + NOISE_Y_FACTOR * iy + NOISE_Z_FACTOR * iz + NOISE_SEED_FACTOR * seed) & 0xffffffff;
 				vIndex ^= (vIndex >> NOISE_SHIFT);
@@ -365,71 +597,244 @@ namespace noisepp
 				n = (n >> 13) ^ n;
 				return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
 			}
+
+			static NOISEPP_INLINE int calcGradientIndex (int ix, int iy, int iz, int seed)
+			{
+				int vIndex = (NOISE_X_FACTOR * ix + NOISE_Y_FACTOR * iy + NOISE_Z_FACTOR * iz + NOISE_SEED_FACTOR * seed) & 0xffffffff;
+				vIndex ^= (vIndex >> NOISE_SHIFT);
+				return vIndex & 0xff;
+			}
+
 		public:
+			/// Returns a bound for the absolute value of the gradient coherent noise functions, including their rounding.
+			/// The standard gradients are scaled by the offset to the lattice point which is at most sqrt(3) long.
+			static NOISEPP_INLINE Real calcGradientCoherentNoiseBound (int quality, Real scale)
+			{
+				const Real bound = (quality > NOISE_QUALITY_HIGH) ? std::fabs (scale) : std::fabs (scale) * Real(1.7320508075688772);
+				return bound + calcKernelRoundingSlack (bound);
+			}
+			/// Returns a conservative range of the gradient coherent noise inside the specified box.
+			/// Inside each lattice cell covered by the box, the ranges of the corner gradient functions are
+			/// interpolated with the range of the interpolation weights.
+			/// Boxes covering more than NOISE_RANGE_MAX_CELLS cells return the global bound.
+			static Interval calcGradientCoherentNoiseRange (const Interval &x, const Interval &y, const Interval &z, int seed, int quality, Real scale)
+			{
+				const Real bound = calcGradientCoherentNoiseBound (quality, scale);
+				const int x0 = calcLatticeCell (x.lower);
+				const int x1 = calcLatticeCell (x.upper);
+				const int y0 = calcLatticeCell (y.lower);
+				const int y1 = calcLatticeCell (y.upper);
+				const int z0 = calcLatticeCell (z.lower);
+				const int z1 = calcLatticeCell (z.upper);
+				if ((x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1) > NOISE_RANGE_MAX_CELLS)
+					return Interval (-bound, bound);
+				const bool fast = (quality > NOISE_QUALITY_HIGH);
+				bool first = true;
+				Interval range;
+				for (int iz=z0;iz<=z1;++iz)
+				{
+					const Interval cellZ ((std::max)(z.lower, Real(iz)), (std::min)(z.upper, Real(iz+1)));
+					const Interval zs = calcInterpolationWeight (cellZ + Real(-iz), quality);
+					for (int iy=y0;iy<=y1;++iy)
+					{
+						const Interval cellY ((std::max)(y.lower, Real(iy)), (std::min)(y.upper, Real(iy+1)));
+						const Interval ys = calcInterpolationWeight (cellY + Real(-iy), quality);
+						for (int ix=x0;ix<=x1;++ix)
+						{
+							const Interval cellX ((std::max)(x.lower, Real(ix)), (std::min)(x.upper, Real(ix+1)));
+							const Interval xs = calcInterpolationWeight (cellX + Real(-ix), quality);
+							Interval n[8];
+							for (int c=0;c<8;++c)
+							{
+								const int cx = ix + (c & 1);
+								const int cy = iy + ((c >> 1) & 1);
+								const int cz = iz + (c >> 2);
+								const int vIndex = calcGradientIndex (cx, cy, cz, seed);
+								if (fast)
+									n[c] = Interval (gradientVector[vIndex]);
+								else
+									n[c] = (cellX + Real(-cx)) * randomVectors3D[(vIndex<<2)] + (cellY + Real(-cy)) * randomVectors3D[(vIndex<<2)+1] + (cellZ + Real(-cz)) * randomVectors3D[(vIndex<<2)+2];
+							}
+							const Interval front = interpLinearRange (interpLinearRange (n[0], n[1], xs), interpLinearRange (n[2], n[3], xs), ys);
+							const Interval back = interpLinearRange (interpLinearRange (n[4], n[5], xs), interpLinearRange (n[6], n[7], xs), ys);
+							const Interval cell = interpLinearRange (front, back, zs);
+							range = first ? cell : Interval::Hull (range, cell);
+							first = false;
+						}
+					}
+				}
+				return Interval::Intersect ((range * scale).widen (calcKernelRoundingSlack (bound)), Interval (-bound, bound));
+			}
+			/// Calculates the gradient coherent noise of the specified quality and its partial derivatives.
+			/// The derivatives are calculated analytically through the interpolation curve.
+			static Real calcGradientCoherentNoiseGradient (Real x, Real y, Real z, int seed, int quality, Real scale, Real &dx, Real &dy, Real &dz)
+			{
+				NOISE_GENERATOR_INTEGER_CLAMP_3D;
+
+				Real dxs, dys, dzs;
+				const Real xs = calcInterpolationCurve (x - Real(x0), quality, dxs);
+				const Real ys = calcInterpolationCurve (y - Real(y0), quality, dys);
+				const Real zs = calcInterpolationCurve (z - Real(z0), quality, dzs);
+
+				const bool fast = (quality > NOISE_QUALITY_HIGH);
+				Real n[8], gx[8], gy[8], gz[8];
+				for (int c=0;c<8;++c)
+				{
+					const int ix = (c & 1) ? x1 : x0;
+					const int iy = (c & 2) ? y1 : y0;
+					const int iz = (c & 4) ? z1 : z0;
+					const int vIndex = calcGradientIndex (ix, iy, iz, seed);
+					if (fast)
+					{
+						n[c] = gradientVector[vIndex];
+						gx[c] = gy[c] = gz[c] = Real(0.0);
+					}
+					else
+					{
+						gx[c] = randomVectors3D[(vIndex<<2)];
+						gy[c] = randomVectors3D[(vIndex<<2)+1];
+						gz[c] = randomVectors3D[(vIndex<<2)+2];
+						n[c] = gx[c] * (x - Real(ix)) + gy[c] * (y - Real(iy)) + gz[c] * (z - Real(iz));
+					}
+				}
+
+				// interpolate along x for each of the four edges
+				Real ix[4], dixx[4], dixy[4], dixz[4];
+				for (int e=0;e<4;++e)
+				{
+					const int c0 = e << 1, c1 = c0 + 1;
+					ix[e] = Math::InterpLinear (n[c0], n[c1], xs);
+					dixx[e] = Math::InterpLinear (gx[c0], gx[c1], xs) + (n[c1] - n[c0]) * dxs;
+					dixy[e] = Math::InterpLinear (gy[c0], gy[c1], xs);
+					dixz[e] = Math::InterpLinear (gz[c0], gz[c1], xs);
+				}
+				// interpolate along y for both faces
+				Real iy[2], diyx[2], diyy[2], diyz[2];
+				for (int f=0;f<2;++f)
+				{
+					const int e0 = f << 1, e1 = e0 + 1;
+					iy[f] = Math::InterpLinear (ix[e0], ix[e1], ys);
+					diyx[f] = Math::InterpLinear (dixx[e0], dixx[e1], ys);
+					diyy[f] = Math::InterpLinear (dixy[e0], dixy[e1], ys) + (ix[e1] - ix[e0]) * dys;
+					diyz[f] = Math::InterpLinear (dixz[e0], dixz[e1], ys);
+				}
+
+				dx = Math::InterpLinear (diyx[0], diyx[1], zs) * scale;
+				dy = Math::InterpLinear (diyy[0], diyy[1], zs) * scale;
+				dz = (Math::InterpLinear (diyz[0], diyz[1], zs) + (iy[1] - iy[0]) * dzs) * scale;
+				return Math::InterpLinear (iy[0], iy[1], zs) * scale;
+			}
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseHigh (Real x, Real y, Real z, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_3D;
 
-				const Real xs = Math::CubicCurve5 (x - Real(x0));
-				const Real ys = Math::CubicCurve5 (y - Real(y0));
-				const Real zs = Math::CubicCurve5 (z - Real(z0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal yf1 = KernelReal(y - Real(y1));
+				const KernelReal zf = KernelReal(z - Real(z0));
+				const KernelReal zf1 = KernelReal(z - Real(z1));
+				const KernelReal xs = Math::CubicCurve5 (xf);
+				const KernelReal ys = Math::CubicCurve5 (yf);
+				const KernelReal zs = Math::CubicCurve5 (zf);
 
-				return interpGradientCoherentNoise(x, y, z, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, scale);
+				return interpGradientCoherentNoise(xf, yf, zf, xf1, yf1, zf1, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseStd (Real x, Real y, Real z, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_3D;
 
-				const Real xs = Math::CubicCurve3 (x - Real(x0));
-				const Real ys = Math::CubicCurve3 (y - Real(y0));
-				const Real zs = Math::CubicCurve3 (z - Real(z0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal yf1 = KernelReal(y - Real(y1));
+				const KernelReal zf = KernelReal(z - Real(z0));
+				const KernelReal zf1 = KernelReal(z - Real(z1));
+				const KernelReal xs = Math::CubicCurve3 (xf);
+				const KernelReal ys = Math::CubicCurve3 (yf);
+				const KernelReal zs = Math::CubicCurve3 (zf);
 
-				return interpGradientCoherentNoise(x, y, z, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, scale);
+				return interpGradientCoherentNoise(xf, yf, zf, xf1, yf1, zf1, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentNoiseLow (Real x, Real y, Real z, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_3D;
 
-				const Real xs = x - Real(x0);
-				const Real ys = y - Real(y0);
-				const Real zs = z - Real(z0);
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal xf1 = KernelReal(x - Real(x1));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal yf1 = KernelReal(y - Real(y1));
+				const KernelReal zf = KernelReal(z - Real(z0));
+				const KernelReal zf1 = KernelReal(z - Real(z1));
+				const KernelReal xs = xf;
+				const KernelReal ys = yf;
+				const KernelReal zs = zf;
 
-				return interpGradientCoherentNoise(x, y, z, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, scale);
+				return interpGradientCoherentNoise(xf, yf, zf, xf1, yf1, zf1, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseHigh (Real x, Real y, Real z, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_3D;
 
-				const Real xs = Math::CubicCurve5 (x - Real(x0));
-				const Real ys = Math::CubicCurve5 (y - Real(y0));
-				const Real zs = Math::CubicCurve5 (z - Real(z0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal zf = KernelReal(z - Real(z0));
+				const KernelReal xs = Math::CubicCurve5 (xf);
+				const KernelReal ys = Math::CubicCurve5 (yf);
+				const KernelReal zs = Math::CubicCurve5 (zf);
 
-				return interpGradientCoherentFastNoise(x, y, z, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, scale);
+				return interpGradientCoherentFastNoise(xf, yf, zf, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseStd (Real x, Real y, Real z, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_3D;
 
-				const Real xs = Math::CubicCurve3 (x - Real(x0));
-				const Real ys = Math::CubicCurve3 (y - Real(y0));
-				const Real zs = Math::CubicCurve3 (z - Real(z0));
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal zf = KernelReal(z - Real(z0));
+				const KernelReal xs = Math::CubicCurve3 (xf);
+				const KernelReal ys = Math::CubicCurve3 (yf);
+				const KernelReal zs = Math::CubicCurve3 (zf);
 
-				return interpGradientCoherentFastNoise(x, y, z, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, scale);
+				return interpGradientCoherentFastNoise(xf, yf, zf, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcGradientCoherentFastNoiseLow (Real x, Real y, Real z, int seed, Real scale)
 			{
 				NOISE_GENERATOR_INTEGER_CLAMP_3D;
 
-				const Real xs = x - Real(x0);
-				const Real ys = y - Real(y0);
-				const Real zs = z - Real(z0);
-
-				return interpGradientCoherentFastNoise(x, y, z, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, scale);
+				const KernelReal xf = KernelReal(x - Real(x0));
+				const KernelReal yf = KernelReal(y - Real(y0));
+				const KernelReal zf = KernelReal(z - Real(z0));
+				const KernelReal xs = xf;
+				const KernelReal ys = yf;
+				const KernelReal zs = zf;
+
+				return interpGradientCoherentFastNoise(xf, yf, zf, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
+			}
+
+			/// Calculates coherent gradient noise of the specified quality at a world coordinate multiplied by frequency.
+			static NOISEPP_INLINE Real calcGradientCoherentNoise (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Real frequency, int seed, int quality, Real scale)
+			{
+				int x0, y0, z0;
+				KernelReal xf, yf, zf, xf1, yf1, zf1;
+				x.getLattice (frequency, x0, xf, xf1);
+				y.getLattice (frequency, y0, yf, yf1);
+				z.getLattice (frequency, z0, zf, zf1);
+				const int x1 = x0 + 1;
+				const int y1 = y0 + 1;
+				const int z1 = z0 + 1;
+				const KernelReal xs = Generator1D::calcQualityCurve (xf, quality);
+				const KernelReal ys = Generator1D::calcQualityCurve (yf, quality);
+				const KernelReal zs = Generator1D::calcQualityCurve (zf, quality);
+
+				if (quality > NOISE_QUALITY_HIGH)
+					return interpGradientCoherentFastNoise (xf, yf, zf, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
+				return interpGradientCoherentNoise (xf, yf, zf, xf1, yf1, zf1, x0, x1, y0, y1, z0, z1, xs, ys, zs, seed, KernelReal(scale));
 			}
 
 			static NOISEPP_INLINE Real calcNoise (int x, int y, int z, int seed=0)
@@ -0,0 +1,191 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEPP_INTERVAL_H
+#define NOISEPP_INTERVAL_H
+
+#include "NoisePrerequisites.h"
+
+namespace noisepp
+{
+	/** Closed interval of real values.
+		Used for the conservative range analysis of pipeline elements.
+		The arithmetic operators move the computed bounds outwards, so rounding can't make an interval
+		too narrow. A default constructed interval is unbounded.
+	*/
+	struct Interval
+	{
+		/// Lower bound.
+		Real lower;
+		/// Upper bound.
+		Real upper;
+
+		/// Constructor for an unbounded interval.
+		Interval () : lower(-std::numeric_limits<Real>::infinity()), upper(std::numeric_limits<Real>::infinity())
+		{
+		}
+		/// Constructor for a single value.
+		explicit Interval (Real v) : lower(v), upper(v)
+		{
+		}
+		/// Constructor.
+		Interval (Real lower, Real upper) : lower(lower), upper(upper)
+		{
+			NoiseAssert (lower <= upper, (lower, upper));
+		}
+		/// Returns true if both bounds are finite.
+		bool isBounded () const
+		{
+			return lower > -std::numeric_limits<Real>::infinity() && upper < std::numeric_limits<Real>::infinity();
+		}
+		/// Returns true if the interval contains a single value only.
+		bool isConstant () const
+		{
+			return lower == upper;
+		}
+		/// Returns true if the interval lies completely inside of the specified bounds.
+		bool isInside (Real lo, Real hi) const
+		{
+			return lower >= lo && upper <= hi;
+		}
+		/// Returns the largest absolute value inside the interval.
+		Real magnitude () const
+		{
+			return (std::max)(std::fabs (lower), std::fabs (upper));
+		}
+		/// Adds two intervals.
+		Interval operator+ (const Interval &v) const
+		{
+			return Interval (Down(lower + v.lower), Up(upper + v.upper));
+		}
+		/// Adds a constant.
+		Interval operator+ (Real v) const
+		{
+			return Interval (Down(lower + v), Up(upper + v));
+		}
+		/// Negates the interval.
+		Interval operator- () const
+		{
+			return Interval (-upper, -lower);
+		}
+		/// Multiplies two intervals.
+		Interval operator* (const Interval &v) const
+		{
+			const Real a = Mul(lower, v.lower);
+			const Real b = Mul(lower, v.upper);
+			const Real c = Mul(upper, v.lower);
+			const Real d = Mul(upper, v.upper);
+			return Interval (Down((std::min)((std::min)(a, b), (std::min)(c, d))), Up((std::max)((std::max)(a, b), (std::max)(c, d))));
+		}
+		/// Multiplies with a constant.
+		Interval operator* (Real v) const
+		{
+			return (*this) * Interval(v);
+		}
+		/// Returns the interval of the absolute values.
+		Interval abs () const
+		{
+			if (lower >= Real(0.0))
+				return *this;
+			if (upper <= Real(0.0))
+				return -(*this);
+			return Interval (Real(0.0), (std::max)(-lower, upper));
+		}
+		/// Returns the interval of the values clamped to the specified bounds.
+		Interval clamp (Real lo, Real hi) const
+		{
+			return Interval (Clamp(lower, lo, hi), Clamp(upper, lo, hi));
+		}
+		/// Returns the interval of the squared values.
+		Interval square () const
+		{
+			const Interval a = abs ();
+			return Interval (Down(Mul(a.lower, a.lower)), Up(Mul(a.upper, a.upper)));
+		}
+		/// Returns the interval widened by the specified amount on both sides.
+		Interval widen (Real delta) const
+		{
+			return Interval (Down(lower - delta), Up(upper + delta));
+		}
+		/// Returns the smallest interval containing both intervals.
+		static Interval Hull (const Interval &a, const Interval &b)
+		{
+			return Interval ((std::min)(a.lower, b.lower), (std::max)(a.upper, b.upper));
+		}
+		/// Returns the intersection of two intervals.
+		/// If rounding errors separate two conservative ranges of the same value, the second interval is returned.
+		static Interval Intersect (const Interval &a, const Interval &b)
+		{
+			const Real lo = (std::max)(a.lower, b.lower);
+			const Real hi = (std::min)(a.upper, b.upper);
+			if (lo > hi)
+				return b;
+			return Interval (lo, hi);
+		}
+		/// Returns the interval of the minimum of two values.
+		static Interval Min (const Interval &a, const Interval &b)
+		{
+			return Interval ((std::min)(a.lower, b.lower), (std::min)(a.upper, b.upper));
+		}
+		/// Returns the interval of the maximum of two values.
+		static Interval Max (const Interval &a, const Interval &b)
+		{
+			return Interval ((std::max)(a.lower, b.lower), (std::max)(a.upper, b.upper));
+		}
+
+		private:
+			// zero times an infinite bound is zero, since the bounded values are finite
+			static Real Mul (Real a, Real b)
+			{
+				if (a == Real(0.0) || b == Real(0.0))
+					return Real(0.0);
+				return a * b;
+			}
+			// moves a rounded bound down by at least one ulp, infinite bounds stay unchanged
+			static Real Down (Real v)
+			{
+				if (std::fabs (v) > (std::numeric_limits<Real>::max)())
+					return v;
+				return v - (std::fabs (v) * std::numeric_limits<Real>::epsilon() + (std::numeric_limits<Real>::min)());
+			}
+			// moves a rounded bound up by at least one ulp, infinite bounds stay unchanged
+			static Real Up (Real v)
+			{
+				if (std::fabs (v) > (std::numeric_limits<Real>::max)())
+					return v;
+				return v + (std::fabs (v) * std::numeric_limits<Real>::epsilon() + (std::numeric_limits<Real>::min)());
+			}
+			static Real Clamp (Real v, Real lo, Real hi)
+			{
+				if (v < lo)
+					return lo;
+				if (v > hi)
+					return hi;
+				return v;
+			}
+	};
+};
+
+#endif // NOISEPP_INTERVAL_H
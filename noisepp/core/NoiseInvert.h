@@ -41,6 +41,17 @@ namespace noisepp
 			InvertElement1D (const Pipeline1D *pipe, ElementID element) : mElement(element)
 			{
 				mElementPtr = pipe->getElement (element);
+				mRange = -mElementPtr->getRange ();
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = -values[i];
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -48,6 +59,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, cache);
 				return -(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				return -(value);
+			}
 	};
 
 	class InvertElement2D : public PipelineElement2D
@@ -60,6 +77,21 @@ namespace noisepp
 			InvertElement2D (const Pipeline2D *pipe, ElementID element) : mElement(element)
 			{
 				mElementPtr = pipe->getElement (element);
+				mRange = -mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return -mElementPtr->getRegionRange (x, y);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = -values[i];
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -67,6 +99,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, cache);
 				return -(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				return -(value);
+			}
 	};
 
 	class InvertElement3D : public PipelineElement3D
@@ -79,6 +117,21 @@ namespace noisepp
 			InvertElement3D (const Pipeline3D *pipe, ElementID element) : mElement(element)
 			{
 				mElementPtr = pipe->getElement (element);
+				mRange = -mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return -mElementPtr->getRegionRange (x, y, z);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = -values[i];
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -86,6 +139,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, z, cache);
 				return -(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				return -(value);
+			}
 	};
 
 	/** Inversion module.
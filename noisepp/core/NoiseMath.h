@@ -59,6 +59,43 @@ namespace noisepp
 				const Real a5 = a4 * a;
 				return Real(10) * a3 - Real(15) * a4 + Real(6) * a5;
 			}
+			/// Calculates the derivative of the cubic interpolation with respect to the weight
+			static NOISEPP_INLINE Real InterpCubicDerivative (Real v0, Real v1, Real v2, Real v3, Real a)
+			{
+				const Real x = v3 - v2 - v0 + v1;
+				return Real(3) * x * a * a + Real(2) * (v0 - v1 - x) * a + (v2 - v0);
+			}
+			/// Calculates the derivative of the third-order interpolant
+			static NOISEPP_INLINE Real CubicCurve3Derivative (Real a)
+			{
+				return Real(6) * a * (Real(1) - a);
+			}
+			/// Calculates the derivative of the fifth-order interpolant
+			static NOISEPP_INLINE Real CubicCurve5Derivative (Real a)
+			{
+				const Real b = a * (Real(1) - a);
+				return Real(30) * b * b;
+			}
+#if NOISEPP_DOUBLE_PRECISION && NOISEPP_MIXED_PRECISION
+			/// @copydoc InterpLinear(Real, Real, Real)
+			static NOISEPP_INLINE KernelReal InterpLinear (KernelReal left, KernelReal right, KernelReal a)
+			{
+				return ((KernelReal(1) - a) * left) + (a * right);
+			}
+			/// @copydoc CubicCurve3(Real)
+			static NOISEPP_INLINE KernelReal CubicCurve3 (KernelReal a)
+			{
+				return (a * a * (KernelReal(3) - KernelReal(2) * a));
+			}
+			/// @copydoc CubicCurve5(Real)
+			static NOISEPP_INLINE KernelReal CubicCurve5 (KernelReal a)
+			{
+				const KernelReal a3 = a * a * a;
+				const KernelReal a4 = a3 * a;
+				const KernelReal a5 = a4 * a;
+				return KernelReal(10) * a3 - KernelReal(15) * a4 + KernelReal(6) * a5;
+			}
+#endif
 			/// Clamps the parameter into integer range
 			static NOISEPP_INLINE Real MakeInt32Range (Real n)
 			{
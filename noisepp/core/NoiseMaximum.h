@@ -43,6 +43,31 @@ namespace noisepp
 			{
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
+				mRange = Interval::Max (mLeftPtr->getRange(), mRightPtr->getRange());
+			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement1D::getValues (x, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] = values[i] > right[i] ? values[i] : right[i];
+					x += n;
+					values += n;
+					count -= n;
+				}
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -54,6 +79,16 @@ namespace noisepp
 				else
 					return right;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real left, right;
+				left = mLeftPtr->getWorldValue (x, cache);
+				right = mRightPtr->getWorldValue (x, cache);
+				if (left > right)
+					return left;
+				else
+					return right;
+			}
 	};
 
 	class MaximumElement2D : public PipelineElement2D
@@ -68,6 +103,36 @@ namespace noisepp
 			{
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
+				mRange = Interval::Max (mLeftPtr->getRange(), mRightPtr->getRange());
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return Interval::Max (mLeftPtr->getRegionRange (x, y), mRightPtr->getRegionRange (x, y));
+			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement2D::getValues (x, y, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, y, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, y, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] = values[i] > right[i] ? values[i] : right[i];
+					x += n;
+					y += n;
+					values += n;
+					count -= n;
+				}
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -79,6 +144,16 @@ namespace noisepp
 				else
 					return right;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real left, right;
+				left = mLeftPtr->getWorldValue (x, y, cache);
+				right = mRightPtr->getWorldValue (x, y, cache);
+				if (left > right)
+					return left;
+				else
+					return right;
+			}
 	};
 
 	class MaximumElement3D : public PipelineElement3D
@@ -93,6 +168,37 @@ namespace noisepp
 			{
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
+				mRange = Interval::Max (mLeftPtr->getRange(), mRightPtr->getRange());
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return Interval::Max (mLeftPtr->getRegionRange (x, y, z), mRightPtr->getRegionRange (x, y, z));
+			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement3D::getValues (x, y, z, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, y, z, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, y, z, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] = values[i] > right[i] ? values[i] : right[i];
+					x += n;
+					y += n;
+					z += n;
+					values += n;
+					count -= n;
+				}
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -104,6 +210,16 @@ namespace noisepp
 				else
 					return right;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real left, right;
+				left = mLeftPtr->getWorldValue (x, y, z, cache);
+				right = mRightPtr->getWorldValue (x, y, z, cache);
+				if (left > right)
+					return left;
+				else
+					return right;
+			}
 	};
 
 	/** Maximum module.
@@ -31,7 +31,6 @@
 
 namespace noisepp
 {
-	typedef unsigned short ModuleTypeId;
 	enum
 	{
 		MODULE_PERLIN=0,
@@ -56,7 +55,8 @@ namespace noisepp
 		MODULE_TURBULENCE=19,
 		MODULE_TERRACE=20,
 		MODULE_TRANSLATEPOINT=21,
-		MODULE_VORONOI=22
+		MODULE_VORONOI=22,
+		MODULE_TRANSFORMPOINT=23
 	};
 
 #if NOISEPP_ENABLE_UTILS
@@ -168,6 +168,27 @@ namespace noisepp
 #endif
 	};
 
+	// defined here because the pipeline only knows the declaration of Module
+	template <class Element>
+	ElementID Pipeline<Element>::addSource (const Module *module)
+	{
+		NoiseAssert (module != NULL, module);
+		std::map<const Module*, ElementID>::iterator it = mElementIDs.find(module);
+		if (it != mElementIDs.end())
+		{
+			setShared (it->second);
+			return it->second;
+		}
+		return module->addToPipeline (this);
+	}
+
+#if NOISEPP_ENABLE_PROFILING
+	inline ModuleTypeId getModuleType (const Module *module)
+	{
+		return module->getType ();
+	}
+#endif
+
 	#define NoiseModuleCheckSourceModules \
 		for (size_t n=0;n<mSourceModuleCount;++n) \
 		{ \
@@ -188,21 +209,21 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new Element1D(pipe, first));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new Element2D(pipe, first));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new Element3D(pipe, first));
 			}
 	};
@@ -220,24 +241,24 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
 				return pipe->addElement (this, new Element1D(pipe, first, second));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
 				return pipe->addElement (this, new Element2D(pipe, first, second));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
 				return pipe->addElement (this, new Element3D(pipe, first, second));
 			}
 	};
@@ -276,27 +297,27 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
-				ElementID third = getSourceModule(2)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
+				ElementID third = pipe->addSource(getSourceModule(2));
 				return pipe->addElement (this, new Element1D(pipe, first, second, third));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
-				ElementID third = getSourceModule(2)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
+				ElementID third = pipe->addSource(getSourceModule(2));
 				return pipe->addElement (this, new Element2D(pipe, first, second, third));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
-				ElementID third = getSourceModule(2)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
+				ElementID third = pipe->addSource(getSourceModule(2));
 				return pipe->addElement (this, new Element3D(pipe, first, second, third));
 			}
 	};
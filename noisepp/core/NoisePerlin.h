@@ -124,7 +124,7 @@ namespace noisepp
 				mScale = v;
 			}
 			/// Returns the noise scale factor.
-			Real getScale ()
+			Real getScale () const
 			{
 				return mScale;
 			}
@@ -184,12 +184,22 @@ namespace noisepp
 					scale *= lacunarity;
 					curPersistence *= persistence;
 				}
+				const Real amplitude = Generator1D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				mRange = Interval (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					mRange = mRange + Interval (-amplitude, amplitude) * mOctaves[o].persistence;
+				}
 			}
 			virtual ~PerlinElement1D ()
 			{
 				delete mOctaves;
 				mOctaves = NULL;
 			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				Real value = 0.0;
@@ -203,6 +213,20 @@ namespace noisepp
 					value += signal * mOctaves[o].persistence;
 				}
 
+				return value;
+			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real signal = 1.0;
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					signal = Generator1D::calcGradientCoherentNoise (x, mOctaves[o].scale, mOctaves[o].seed, mQuality, mScale);
+
+					value += signal * mOctaves[o].persistence;
+				}
+
 				return value;
 			}
 	};
@@ -255,12 +279,40 @@ namespace noisepp
 					scale *= lacunarity;
 					curPersistence *= persistence;
 				}
+				const Real amplitude = Generator2D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				mRange = Interval (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					mRange = mRange + Interval (-amplitude, amplitude) * mOctaves[o].persistence;
+				}
 			}
 			virtual ~PerlinElement2D ()
 			{
 				delete mOctaves;
 				mOctaves = NULL;
 			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				if (!x.isBounded () || !y.isBounded ())
+					return mRange;
+				const Real amplitude = Generator2D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				const Real magnitude = (std::max) (x.magnitude (), y.magnitude ());
+				Interval range (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Real scale = mOctaves[o].scale;
+					Interval signal (-amplitude, amplitude);
+					// coordinates outside of the int32 range are wrapped
+					if (magnitude * std::fabs (scale) < Real(1073741824.0))
+						signal = Generator2D::calcGradientCoherentNoiseRange (x * scale, y * scale, mOctaves[o].seed, mQuality, mScale);
+					range = range + signal * mOctaves[o].persistence;
+				}
+				return Interval::Intersect (range, mRange);
+			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real value = 0.0;
@@ -275,6 +327,42 @@ namespace noisepp
 					value += signal * mOctaves[o].persistence;
 				}
 
+				return value;
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real signal = 1.0;
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					signal = Generator2D::calcGradientCoherentNoise (x, y, mOctaves[o].scale, mOctaves[o].seed, mQuality, mScale);
+
+					value += signal * mOctaves[o].persistence;
+				}
+
+				return value;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				Real value = 0.0;
+				dx = dy = Real(0.0);
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Real scale = mOctaves[o].scale;
+					const Real nx = Math::MakeInt32Range (x * scale);
+					const Real ny = Math::MakeInt32Range (y * scale);
+					Real sdx, sdy;
+					Real signal = Generator2D::calcGradientCoherentNoiseGradient (nx, ny, mOctaves[o].seed, mQuality, mScale, sdx, sdy);
+					// the octave frequency scales the derivatives
+					const Real weight = mOctaves[o].persistence * scale;
+
+					value += signal * mOctaves[o].persistence;
+					dx += sdx * weight;
+					dy += sdy * weight;
+				}
+
 				return value;
 			}
 	};
@@ -327,12 +415,40 @@ namespace noisepp
 					scale *= lacunarity;
 					curPersistence *= persistence;
 				}
+				const Real amplitude = Generator3D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				mRange = Interval (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					mRange = mRange + Interval (-amplitude, amplitude) * mOctaves[o].persistence;
+				}
 			}
 			virtual ~PerlinElement3D ()
 			{
 				delete mOctaves;
 				mOctaves = NULL;
 			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				if (!x.isBounded () || !y.isBounded () || !z.isBounded ())
+					return mRange;
+				const Real amplitude = Generator3D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				const Real magnitude = (std::max) (x.magnitude (), (std::max) (y.magnitude (), z.magnitude ()));
+				Interval range (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Real scale = mOctaves[o].scale;
+					Interval signal (-amplitude, amplitude);
+					// coordinates outside of the int32 range are wrapped
+					if (magnitude * std::fabs (scale) < Real(1073741824.0))
+						signal = Generator3D::calcGradientCoherentNoiseRange (x * scale, y * scale, z * scale, mOctaves[o].seed, mQuality, mScale);
+					range = range + signal * mOctaves[o].persistence;
+				}
+				return Interval::Intersect (range, mRange);
+			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real value = 0.0;
@@ -348,6 +464,44 @@ namespace noisepp
 					value += signal * mOctaves[o].persistence;
 				}
 
+				return value;
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real signal = 1.0;
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					signal = Generator3D::calcGradientCoherentNoise (x, y, z, mOctaves[o].scale, mOctaves[o].seed, mQuality, mScale);
+
+					value += signal * mOctaves[o].persistence;
+				}
+
+				return value;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				Real value = 0.0;
+				dx = dy = dz = Real(0.0);
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Real scale = mOctaves[o].scale;
+					const Real nx = Math::MakeInt32Range (x * scale);
+					const Real ny = Math::MakeInt32Range (y * scale);
+					const Real nz = Math::MakeInt32Range (z * scale);
+					Real sdx, sdy, sdz;
+					Real signal = Generator3D::calcGradientCoherentNoiseGradient (nx, ny, nz, mOctaves[o].seed, mQuality, mScale, sdx, sdy, sdz);
+					// the octave frequency scales the derivatives
+					const Real weight = mOctaves[o].persistence * scale;
+
+					value += signal * mOctaves[o].persistence;
+					dx += sdx * weight;
+					dy += sdy * weight;
+					dz += sdz * weight;
+				}
+
 				return value;
 			}
 	};
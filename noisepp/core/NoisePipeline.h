@@ -27,6 +27,9 @@
 #define NOISEPP_PIPELINE_H
 
 #include "NoisePrerequisites.h"
+#include "NoiseInterval.h"
+#include "NoiseProfiler.h"
+#include "NoiseWorldCoord.h"
 
 namespace noisepp
 {
@@ -45,10 +48,23 @@ namespace noisepp
 		Real y;
 		/// Last z coordinate.
 		Real z;
+#if NOISEPP_ENABLE_PROFILING
+		/// Profiling counters of the element, owned by the pipeline.
+		ElementCounters *counters;
+		/// Constructor.
+		Cache () : value(0), filled(false), counters(0) {}
+#else
 		/// Constructor.
 		Cache () : value(0), filled(false) {}
+#endif
 	};
 
+	/// Maximum number of values an element processes at once in batched evaluation.
+	const size_t PIPELINE_BATCH_SIZE = 256;
+
+	/// Step width of the central differences used by the default gradient calculation.
+	const Real PIPELINE_GRADIENT_STEP = Real(1.0e-3);
+
 	/// A job which can be added to the queue inside a pipeline for multi-threaded execution.
 	class PipelineJob
 	{
@@ -86,6 +102,14 @@ namespace noisepp
 			std::map<const Module*, ElementID> mElementIDs;
 			/// The job queue.
 			PipelineJobQueue mJobs;
+#if NOISEPP_ENABLE_PROFILING
+			/// The module which created each element.
+			std::vector<const Module*> mElementModules;
+			/// Counters of the caches in use.
+			mutable std::vector<std::pair<Cache*, ElementCounters*> > mProfileCounters;
+			/// Sum of the counters of freed caches.
+			mutable std::vector<ElementCounters> mRetiredCounters;
+#endif
 
 		public:
 			/// Constructor.
@@ -118,21 +142,104 @@ namespace noisepp
 			/// You need only one cache per pipeline and thread.
 			/// You have to call this AFTER adding your modules or there will be memory acces errors.
 			/// Don't forget to free the cache.
+			/// With profiling enabled, caches have to be created and freed from one thread at a time.
 			Cache *createCache () const
 			{
-				return new Cache[mElements.size()];
+				Cache *cache = new Cache[mElements.size()];
+#if NOISEPP_ENABLE_PROFILING
+				ElementCounters *counters = new ElementCounters[mElements.size()];
+				for (size_t i=0;i<mElements.size();++i)
+					cache[i].counters = counters + i;
+				mProfileCounters.push_back (std::make_pair(cache, counters));
+#endif
+				return cache;
 			}
 			/// Cleans the specified cache.
 			/// You should call this each time you use it.
 			NOISEPP_INLINE void cleanCache (Cache *cache) const
 			{
+#if NOISEPP_ENABLE_PROFILING
+				for (size_t i=0;i<mElements.size();++i)
+					cache[i].filled = false;
+#else
 				memset (cache, 0, sizeof(Cache)*mElements.size());
+#endif
 			}
 			/// Frees the specified cache.
 			void freeCache (Cache *cache) const
 			{
+#if NOISEPP_ENABLE_PROFILING
+				for (size_t i=0;i<mProfileCounters.size();++i)
+				{
+					if (mProfileCounters[i].first == cache)
+					{
+						ElementCounters *counters = mProfileCounters[i].second;
+						mRetiredCounters.resize (mElements.size());
+						for (size_t j=0;j<mElements.size();++j)
+							mRetiredCounters[j].add (counters[j]);
+						delete[] counters;
+						mProfileCounters.erase (mProfileCounters.begin() + i);
+						break;
+					}
+				}
+#endif
 				delete[] cache;
 			}
+#if NOISEPP_ENABLE_PROFILING
+			/// Merges the profiling counters of all caches, including the ones already freed.
+			/// Don't call this while jobs are executed.
+			/// @param profile Receives one entry per element.
+			void getProfile (PipelineProfile &profile) const
+			{
+				std::vector<ElementCounters> counters(mRetiredCounters);
+				counters.resize (mElements.size());
+				for (size_t i=0;i<mProfileCounters.size();++i)
+				{
+					for (size_t j=0;j<mElements.size();++j)
+						counters[j].add (mProfileCounters[i].second[j]);
+				}
+				profile.resize (mElements.size());
+				for (size_t i=0;i<mElements.size();++i)
+				{
+					ElementProfile &p = profile[i];
+					p.element = i;
+					p.module = mElementModules[i];
+					p.moduleType = getModuleType (mElementModules[i]);
+					p.cacheHits = counters[i].hits;
+					p.cacheMisses = counters[i].misses;
+					p.calls = p.cacheHits + p.cacheMisses;
+					p.sampledCycles = counters[i].cycles;
+					p.samples = counters[i].samples;
+				}
+			}
+			/// Counts the evaluation of a span of values by the root element of a job.
+			/// Jobs call their element directly, so these evaluations don't pass through the cache of another element.
+			/// @param element The ID of the element, nothing is counted for ELEMENTID_INVALID.
+			void countValues (ElementID element, Cache *cache, size_t count) const
+			{
+				if (element != ELEMENTID_INVALID)
+					cache[element].counters->misses += count;
+			}
+			/// Resets the profiling counters of all caches.
+			/// Don't call this while jobs are executed.
+			void resetProfile ()
+			{
+				mRetiredCounters.clear ();
+				for (size_t i=0;i<mProfileCounters.size();++i)
+				{
+					for (size_t j=0;j<mElements.size();++j)
+						mProfileCounters[i].second[j] = ElementCounters();
+				}
+			}
+#endif
+			/// Marks the specified element as used by another consumer.
+			/// Elements are added after their sources, so only the elements following it can depend on it.
+			void setShared (ElementID id)
+			{
+				mElements[id]->setShared ();
+				for (size_t i=id;i<mElements.size();++i)
+					mElements[i]->updateColumnar ();
+			}
 			/// Adds the specified element to the pipeline.
 			/// This is used internally by modules.
 			ElementID addElement (const Module *parent, Element *element)
@@ -143,11 +250,35 @@ namespace noisepp
 				if (it != mElementIDs.end())
 				{
 					delete element;
+					setShared (it->second);
 					return it->second;
 				}
 				ElementID id = mElements.size ();
 				mElementIDs.insert (std::make_pair(parent, id));
 				mElements.push_back(element);
+				element->updateColumnar ();
+#if NOISEPP_ENABLE_PROFILING
+				mElementModules.push_back(parent);
+#endif
+				return id;
+			}
+			/// Adds the specified source module to the pipeline.
+			/// A module which is already in the pipeline isn't added again, only its element is marked as shared.
+			/// This is used internally by modules.
+			ElementID addSource (const Module *module);
+			/// Registers the specified module as an alias of an existing element.
+			/// This is used internally by modules which compile down to one of their source elements.
+			ElementID addAlias (const Module *parent, ElementID id)
+			{
+				NoiseAssert (parent != NULL, parent);
+				NoiseAssertRange (id, mElements.size());
+				std::map<const Module*, ElementID>::iterator it = mElementIDs.find(parent);
+				if (it != mElementIDs.end())
+				{
+					setShared (it->second);
+					return it->second;
+				}
+				mElementIDs.insert (std::make_pair(parent, id));
 				return id;
 			}
 			/// Returns the ID of the element belonging to the specified module or ELEMENTID_INVALID if not found.
@@ -163,6 +294,16 @@ namespace noisepp
 			{
 				return getElementID(&module);
 			}
+			/// Returns the ID of the specified element or ELEMENTID_INVALID if it doesn't belong to this pipeline.
+			ElementID getElementID (const Element *element) const
+			{
+				for (size_t i=0;i<mElements.size();++i)
+				{
+					if (mElements[i] == element)
+						return i;
+				}
+				return ELEMENTID_INVALID;
+			}
 			/// Returns a pointer to the element belonging to the specified module or NULL if not found
 			Element *getElementPtr (const Module *module) const
 			{
@@ -212,6 +353,10 @@ namespace noisepp
 					delete mJobs.front ();
 					mJobs.pop ();
 				}
+#if NOISEPP_ENABLE_PROFILING
+				for (size_t i=0;i<mProfileCounters.size();++i)
+					delete[] mProfileCounters[i].second;
+#endif
 			}
 	};
 
@@ -247,19 +392,111 @@ namespace noisepp
 			{
 				if (cache[element].filled && cache[element].x == x)
 				{
+#if NOISEPP_ENABLE_PROFILING
+					++cache[element].counters->hits;
+#endif
 					return cache[element].value;
 				}
 				else
 				{
 					cache[element].filled = true;
 					cache[element].x = x;
+#if NOISEPP_ENABLE_PROFILING
+					ElementCounters *counters = cache[element].counters;
+					if ((++counters->misses & (NOISEPP_PROFILING_SAMPLE_INTERVAL-1)) == 0)
+					{
+						const unsigned long long start = Profiler_readCycles ();
+						const Real value = elementPtr->getValue(x, cache);
+						counters->cycles += Profiler_readCycles () - start;
+						++counters->samples;
+						return (cache[element].value = value);
+					}
+#endif
 					return (cache[element].value = elementPtr->getValue(x, cache));
 				}
 			}
+			/// Calculates the values of a source element for a span of coordinates.
+			/// Columnar sources evaluate the whole span at once, all others are pulled point by point through the cache.
+			/// The cache only holds the last point, so elements with several sources must not pull more than one of them this way.
+			NOISEPP_INLINE void getElementValues (const PipelineElement1D *elementPtr, ElementID element, const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				if (elementPtr->isColumnar ())
+				{
+					elementPtr->getValues (x, values, count, cache);
+#if NOISEPP_ENABLE_PROFILING
+					cache[element].counters->misses += count;
+#endif
+				}
+				else
+				{
+					for (size_t i=0;i<count;++i)
+						values[i] = getElementValue (elementPtr, element, x[i], cache);
+				}
+			}
 
 			bool mCached;
+			/// Set if more than one consumer uses the value of the element.
+			bool mShared;
+			/// Set if consumers may evaluate the element a whole span at a time.
+			bool mColumnar;
+			/// Conservative range of the output values.
+			Interval mRange;
 		public:
+			/// Constructor.
+			PipelineElement1D () : mShared(false), mColumnar(false) {}
+			/// Returns a conservative range of the values this element can return.
+			const Interval &getRange () const
+			{
+				return mRange;
+			}
 			virtual Real getValue (Real x, Cache *cache) const = 0;
+			/// Returns true if more than one consumer uses the value of the element.
+			bool isShared () const
+			{
+				return mShared;
+			}
+			/// Returns true if consumers may evaluate the element a whole span at a time with getValues(), bypassing the cache.
+			bool isColumnar () const
+			{
+				return mColumnar;
+			}
+			/// Marks the element as shared.
+			/// This is used internally by the pipeline.
+			void setShared ()
+			{
+				mShared = true;
+			}
+			/// Updates the evaluation strategy from the sources.
+			/// This is used internally by the pipeline.
+			void updateColumnar ()
+			{
+				mColumnar = !mShared && checkColumnar ();
+			}
+			/// Returns true if the element and its sources can evaluate whole spans.
+			/// Spans bypass the cache, so this is only used if no element of the subgraph is shared.
+			/// The default implementation returns false, which makes the consumers pull the values point by point.
+			virtual bool checkColumnar () const
+			{
+				return false;
+			}
+			/// Calculates the values for a span of coordinates.
+			/// The default implementation calls getValue() for each coordinate.
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				for (size_t i=0;i<count;++i)
+				{
+					values[i] = getValue (x[i], cache);
+				}
+			}
+			/// Calculates the value at a world coordinate.
+			/// The gradient generators hash the integer cells directly. Combiners, pointwise elements and the scale and
+			/// translate transforms pass the world coordinates on to their sources, without using the cache.
+			/// The default implementation, which the remaining elements use, converts the coordinates to Real
+			/// and is only exact near the origin.
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				return getValue (x.toReal (), cache);
+			}
 			virtual ~PipelineElement1D () {}
 	};
 
@@ -270,6 +507,9 @@ namespace noisepp
 			{
 				if (cache[element].filled && cache[element].x == x && cache[element].y == y)
 				{
+#if NOISEPP_ENABLE_PROFILING
+					++cache[element].counters->hits;
+#endif
 					return cache[element].value;
 				}
 				else
@@ -277,12 +517,117 @@ namespace noisepp
 					cache[element].filled = true;
 					cache[element].x = x;
 					cache[element].y = y;
+#if NOISEPP_ENABLE_PROFILING
+					ElementCounters *counters = cache[element].counters;
+					if ((++counters->misses & (NOISEPP_PROFILING_SAMPLE_INTERVAL-1)) == 0)
+					{
+						const unsigned long long start = Profiler_readCycles ();
+						const Real value = elementPtr->getValue(x, y, cache);
+						counters->cycles += Profiler_readCycles () - start;
+						++counters->samples;
+						return (cache[element].value = value);
+					}
+#endif
 					return (cache[element].value = elementPtr->getValue(x, y, cache));
 				}
 			}
+			/// Calculates the values of a source element for a span of coordinates.
+			/// Columnar sources evaluate the whole span at once, all others are pulled point by point through the cache.
+			/// The cache only holds the last point, so elements with several sources must not pull more than one of them this way.
+			NOISEPP_INLINE void getElementValues (const PipelineElement2D *elementPtr, ElementID element, const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				if (elementPtr->isColumnar ())
+				{
+					elementPtr->getValues (x, y, values, count, cache);
+#if NOISEPP_ENABLE_PROFILING
+					cache[element].counters->misses += count;
+#endif
+				}
+				else
+				{
+					for (size_t i=0;i<count;++i)
+						values[i] = getElementValue (elementPtr, element, x[i], y[i], cache);
+				}
+			}
 
+			/// Set if more than one consumer uses the value of the element.
+			bool mShared;
+			/// Set if consumers may evaluate the element a whole span at a time.
+			bool mColumnar;
+			/// Conservative range of the output values.
+			Interval mRange;
 		public:
+			/// Constructor.
+			PipelineElement2D () : mShared(false), mColumnar(false) {}
+			/// Returns a conservative range of the values this element can return.
+			const Interval &getRange () const
+			{
+				return mRange;
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const = 0;
+			/// Returns true if more than one consumer uses the value of the element.
+			bool isShared () const
+			{
+				return mShared;
+			}
+			/// Returns true if consumers may evaluate the element a whole span at a time with getValues(), bypassing the cache.
+			bool isColumnar () const
+			{
+				return mColumnar;
+			}
+			/// Marks the element as shared.
+			/// This is used internally by the pipeline.
+			void setShared ()
+			{
+				mShared = true;
+			}
+			/// Updates the evaluation strategy from the sources.
+			/// This is used internally by the pipeline.
+			void updateColumnar ()
+			{
+				mColumnar = !mShared && checkColumnar ();
+			}
+			/// Returns true if the element and its sources can evaluate whole spans.
+			/// Spans bypass the cache, so this is only used if no element of the subgraph is shared.
+			/// The default implementation returns false, which makes the consumers pull the values point by point.
+			virtual bool checkColumnar () const
+			{
+				return false;
+			}
+			/// Calculates the values for a span of coordinates.
+			/// The default implementation calls getValue() for each coordinate.
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				for (size_t i=0;i<count;++i)
+				{
+					values[i] = getValue (x[i], y[i], cache);
+				}
+			}
+			/// Returns a conservative range of the values inside the specified box of input coordinates.
+			/// The default implementation returns the static range of the element.
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mRange;
+			}
+			/// Calculates the value and the partial derivatives at the specified coordinates.
+			/// The default implementation uses central differences, elements with an analytic derivative override this.
+			/// Analytic implementations query the gradients of their sources directly, which bypasses the cache.
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				const Real h = PIPELINE_GRADIENT_STEP;
+				dx = (getValue (x + h, y, cache) - getValue (x - h, y, cache)) / (Real(2.0) * h);
+				dy = (getValue (x, y + h, cache) - getValue (x, y - h, cache)) / (Real(2.0) * h);
+				return getValue (x, y, cache);
+			}
+			/// Calculates the value at a world coordinate.
+			/// The gradient generators hash the integer cells directly. Combiners, pointwise elements and the scale and
+			/// translate transforms pass the world coordinates on to their sources, without using the cache.
+			/// The default implementation, which the remaining elements use, converts the coordinates to Real
+			/// and is only exact near the origin.
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				return getValue (x.toReal (), y.toReal (), cache);
+			}
 			virtual ~PipelineElement2D () {}
 	};
 
@@ -293,6 +638,9 @@ namespace noisepp
 			{
 				if (cache[element].filled && cache[element].x == x && cache[element].y == y && cache[element].z == z)
 				{
+#if NOISEPP_ENABLE_PROFILING
+					++cache[element].counters->hits;
+#endif
 					return cache[element].value;
 				}
 				else
@@ -301,12 +649,118 @@ namespace noisepp
 					cache[element].x = x;
 					cache[element].y = y;
 					cache[element].z = z;
+#if NOISEPP_ENABLE_PROFILING
+					ElementCounters *counters = cache[element].counters;
+					if ((++counters->misses & (NOISEPP_PROFILING_SAMPLE_INTERVAL-1)) == 0)
+					{
+						const unsigned long long start = Profiler_readCycles ();
+						const Real value = elementPtr->getValue(x, y, z, cache);
+						counters->cycles += Profiler_readCycles () - start;
+						++counters->samples;
+						return (cache[element].value = value);
+					}
+#endif
 					return (cache[element].value = elementPtr->getValue(x, y, z, cache));
 				}
 			}
+			/// Calculates the values of a source element for a span of coordinates.
+			/// Columnar sources evaluate the whole span at once, all others are pulled point by point through the cache.
+			/// The cache only holds the last point, so elements with several sources must not pull more than one of them this way.
+			NOISEPP_INLINE void getElementValues (const PipelineElement3D *elementPtr, ElementID element, const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				if (elementPtr->isColumnar ())
+				{
+					elementPtr->getValues (x, y, z, values, count, cache);
+#if NOISEPP_ENABLE_PROFILING
+					cache[element].counters->misses += count;
+#endif
+				}
+				else
+				{
+					for (size_t i=0;i<count;++i)
+						values[i] = getElementValue (elementPtr, element, x[i], y[i], z[i], cache);
+				}
+			}
 
+			/// Set if more than one consumer uses the value of the element.
+			bool mShared;
+			/// Set if consumers may evaluate the element a whole span at a time.
+			bool mColumnar;
+			/// Conservative range of the output values.
+			Interval mRange;
 		public:
+			/// Constructor.
+			PipelineElement3D () : mShared(false), mColumnar(false) {}
+			/// Returns a conservative range of the values this element can return.
+			const Interval &getRange () const
+			{
+				return mRange;
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const = 0;
+			/// Returns true if more than one consumer uses the value of the element.
+			bool isShared () const
+			{
+				return mShared;
+			}
+			/// Returns true if consumers may evaluate the element a whole span at a time with getValues(), bypassing the cache.
+			bool isColumnar () const
+			{
+				return mColumnar;
+			}
+			/// Marks the element as shared.
+			/// This is used internally by the pipeline.
+			void setShared ()
+			{
+				mShared = true;
+			}
+			/// Updates the evaluation strategy from the sources.
+			/// This is used internally by the pipeline.
+			void updateColumnar ()
+			{
+				mColumnar = !mShared && checkColumnar ();
+			}
+			/// Returns true if the element and its sources can evaluate whole spans.
+			/// Spans bypass the cache, so this is only used if no element of the subgraph is shared.
+			/// The default implementation returns false, which makes the consumers pull the values point by point.
+			virtual bool checkColumnar () const
+			{
+				return false;
+			}
+			/// Calculates the values for a span of coordinates.
+			/// The default implementation calls getValue() for each coordinate.
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				for (size_t i=0;i<count;++i)
+				{
+					values[i] = getValue (x[i], y[i], z[i], cache);
+				}
+			}
+			/// Returns a conservative range of the values inside the specified box of input coordinates.
+			/// The default implementation returns the static range of the element.
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mRange;
+			}
+			/// Calculates the value and the partial derivatives at the specified coordinates.
+			/// The default implementation uses central differences, elements with an analytic derivative override this.
+			/// Analytic implementations query the gradients of their sources directly, which bypasses the cache.
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				const Real h = PIPELINE_GRADIENT_STEP;
+				dx = (getValue (x + h, y, z, cache) - getValue (x - h, y, z, cache)) / (Real(2.0) * h);
+				dy = (getValue (x, y + h, z, cache) - getValue (x, y - h, z, cache)) / (Real(2.0) * h);
+				dz = (getValue (x, y, z + h, cache) - getValue (x, y, z - h, cache)) / (Real(2.0) * h);
+				return getValue (x, y, z, cache);
+			}
+			/// Calculates the value at a world coordinate.
+			/// The gradient generators hash the integer cells directly. Combiners, pointwise elements and the scale and
+			/// translate transforms pass the world coordinates on to their sources, without using the cache.
+			/// The default implementation, which the remaining elements use, converts the coordinates to Real
+			/// and is only exact near the origin.
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				return getValue (x.toReal (), y.toReal (), z.toReal (), cache);
+			}
 			virtual ~PipelineElement3D () {}
 	};
 };
@@ -37,6 +37,9 @@ class LineJob2D : public PipelineJob
 	private:
 		Pipeline2D *mPipe;
 		PipelineElement2D *mElement;
+#if NOISEPP_ENABLE_PROFILING
+		ElementID mElementID;
+#endif
 		Real x, y;
 		int n;
 		Real xDelta;
@@ -54,18 +57,33 @@ class LineJob2D : public PipelineJob
 		LineJob2D (Pipeline2D *pipe, PipelineElement2D *element, Real x, Real y, int n, Real xDelta, Real *buffer) :
 			mPipe(pipe), mElement(element), x(x), y(y), n(n), xDelta(xDelta), buffer(buffer)
 		{
+#if NOISEPP_ENABLE_PROFILING
+			mElementID = pipe->getElementID (element);
+#endif
 		}
 		/// @copydoc noisepp::PipelineJob::execute()
 		void execute (Cache *cache)
 		{
-			for (int i=0;i<n;++i)
+			Real xs[PIPELINE_BATCH_SIZE];
+			Real ys[PIPELINE_BATCH_SIZE];
+			// cleans the cache
+			mPipe->cleanCache (cache);
+			for (int i=0;i<n;)
 			{
-				// cleans the cache
-				mPipe->cleanCache (cache);
-				// calculates the value
-				buffer[i] = mElement->getValue(x, y, cache);
-				// move on
-				x += xDelta;
+				const int count = (n - i) < int(PIPELINE_BATCH_SIZE) ? (n - i) : int(PIPELINE_BATCH_SIZE);
+				for (int j=0;j<count;++j)
+				{
+					xs[j] = x;
+					ys[j] = y;
+					// move on
+					x += xDelta;
+				}
+				// calculates the values
+				mElement->getValues(xs, ys, buffer+i, count, cache);
+#if NOISEPP_ENABLE_PROFILING
+				mPipe->countValues (mElementID, cache, count);
+#endif
+				i += count;
 			}
 		}
 };
@@ -76,6 +94,9 @@ class LineJob3D : public PipelineJob
 	private:
 		Pipeline3D *mPipe;
 		PipelineElement3D *mElement;
+#if NOISEPP_ENABLE_PROFILING
+		ElementID mElementID;
+#endif
 		Real x, y, z;
 		int n;
 		Real xDelta;
@@ -93,18 +114,36 @@ class LineJob3D : public PipelineJob
 		/// @param buffer A pointer to the output buffer.
 		LineJob3D (noisepp::Pipeline3D *pipe, noisepp::PipelineElement3D *element, Real x, Real y, Real z, int n, Real xDelta, Real *buffer) :
 			mPipe(pipe), mElement(element), x(x), y(y), z(z), n(n), xDelta(xDelta), buffer(buffer)
-		{}
+		{
+#if NOISEPP_ENABLE_PROFILING
+			mElementID = pipe->getElementID (element);
+#endif
+		}
 		/// @copydoc noisepp::PipelineJob::execute()
 		void execute (noisepp::Cache *cache)
 		{
-			for (int i=0;i<n;++i)
+			Real xs[PIPELINE_BATCH_SIZE];
+			Real ys[PIPELINE_BATCH_SIZE];
+			Real zs[PIPELINE_BATCH_SIZE];
+			// cleans the cache
+			mPipe->cleanCache (cache);
+			for (int i=0;i<n;)
 			{
-				// cleans the cache
-				mPipe->cleanCache (cache);
-				// calculates the value
-				buffer[i] = mElement->getValue(x, y, z, cache);
-				// move on
-				x += xDelta;
+				const int count = (n - i) < int(PIPELINE_BATCH_SIZE) ? (n - i) : int(PIPELINE_BATCH_SIZE);
+				for (int j=0;j<count;++j)
+				{
+					xs[j] = x;
+					ys[j] = y;
+					zs[j] = z;
+					// move on
+					x += xDelta;
+				}
+				// calculates the values
+				mElement->getValues(xs, ys, zs, buffer+i, count, cache);
+#if NOISEPP_ENABLE_PROFILING
+				mPipe->countValues (mElementID, cache, count);
+#endif
+				i += count;
 			}
 		}
 };
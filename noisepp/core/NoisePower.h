@@ -44,6 +44,30 @@ namespace noisepp
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
 			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement1D::getValues (x, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] = std::pow (values[i], right[i]);
+					x += n;
+					values += n;
+					count -= n;
+				}
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				Real left, right;
@@ -51,6 +75,13 @@ namespace noisepp
 				right = getElementValue (mRightPtr, mRight, x, cache);
 				return std::pow(left, right);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real left, right;
+				left = mLeftPtr->getWorldValue (x, cache);
+				right = mRightPtr->getWorldValue (x, cache);
+				return std::pow(left, right);
+			}
 	};
 
 	class PowerElement2D : public PipelineElement2D
@@ -66,6 +97,31 @@ namespace noisepp
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
 			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement2D::getValues (x, y, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, y, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, y, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] = std::pow (values[i], right[i]);
+					x += n;
+					y += n;
+					values += n;
+					count -= n;
+				}
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real left, right;
@@ -73,6 +129,26 @@ namespace noisepp
 				right = getElementValue (mRightPtr, mRight, x, y, cache);
 				return std::pow(left, right);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real left, right;
+				left = mLeftPtr->getWorldValue (x, y, cache);
+				right = mRightPtr->getWorldValue (x, y, cache);
+				return std::pow(left, right);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				Real ldx, ldy, rdx, rdy;
+				const Real left = mLeftPtr->getValueAndGradient (x, y, ldx, ldy, cache);
+				const Real right = mRightPtr->getValueAndGradient (x, y, rdx, rdy, cache);
+				const Real value = std::pow(left, right);
+				const Real baseFactor = right * std::pow(left, right - Real(1.0));
+				// the exponent only contributes for positive bases, where the logarithm is defined
+				const Real exponentFactor = (left > Real(0.0)) ? value * std::log(left) : Real(0.0);
+				dx = baseFactor * ldx + exponentFactor * rdx;
+				dy = baseFactor * ldy + exponentFactor * rdy;
+				return value;
+			}
 	};
 
 	class PowerElement3D : public PipelineElement3D
@@ -88,6 +164,32 @@ namespace noisepp
 				mLeftPtr = pipe->getElement (mLeft);
 				mRightPtr = pipe->getElement (mRight);
 			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				if (!mLeftPtr->isColumnar () && !mRightPtr->isColumnar ())
+				{
+					PipelineElement3D::getValues (x, y, z, values, count, cache);
+					return;
+				}
+				Real right[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mLeftPtr, mLeft, x, y, z, values, n, cache);
+					getElementValues (mRightPtr, mRight, x, y, z, right, n, cache);
+					for (size_t i=0;i<n;++i)
+						values[i] = std::pow (values[i], right[i]);
+					x += n;
+					y += n;
+					z += n;
+					values += n;
+					count -= n;
+				}
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real left, right;
@@ -95,6 +197,27 @@ namespace noisepp
 				right = getElementValue (mRightPtr, mRight, x, y, z, cache);
 				return std::pow(left, right);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real left, right;
+				left = mLeftPtr->getWorldValue (x, y, z, cache);
+				right = mRightPtr->getWorldValue (x, y, z, cache);
+				return std::pow(left, right);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				Real ldx, ldy, ldz, rdx, rdy, rdz;
+				const Real left = mLeftPtr->getValueAndGradient (x, y, z, ldx, ldy, ldz, cache);
+				const Real right = mRightPtr->getValueAndGradient (x, y, z, rdx, rdy, rdz, cache);
+				const Real value = std::pow(left, right);
+				const Real baseFactor = right * std::pow(left, right - Real(1.0));
+				// the exponent only contributes for positive bases, where the logarithm is defined
+				const Real exponentFactor = (left > Real(0.0)) ? value * std::log(left) : Real(0.0);
+				dx = baseFactor * ldx + exponentFactor * rdx;
+				dy = baseFactor * ldy + exponentFactor * rdy;
+				dz = baseFactor * ldz + exponentFactor * rdz;
+				return value;
+			}
 	};
 
 	/** Power module.
@@ -39,7 +39,16 @@ namespace noisepp
 	typedef float Real;
 	#endif
 
+	/// Type of the lattice math inside the noise generators.
+	/// The coordinates are split into lattice cell and offset in Real precision, the rest runs in this type.
+	#if NOISEPP_DOUBLE_PRECISION && NOISEPP_MIXED_PRECISION
+	typedef float KernelReal;
+	#else
+	typedef Real KernelReal;
+	#endif
+
 	typedef size_t ElementID;
+	typedef unsigned short ModuleTypeId;
 	const ElementID ELEMENTID_INVALID = (std::numeric_limits<ElementID>::max)();
 
 	class PipelineElement1D;
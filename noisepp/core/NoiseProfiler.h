@@ -0,0 +1,133 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEPP_PROFILER_H
+#define NOISEPP_PROFILER_H
+
+#include "NoisePrerequisites.h"
+
+#if NOISEPP_ENABLE_PROFILING
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#	include <intrin.h>
+#	define NOISEPP_PROFILER_RDTSC 1
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#	include <x86intrin.h>
+#	define NOISEPP_PROFILER_RDTSC 1
+#else
+#	include <time.h>
+#	define NOISEPP_PROFILER_RDTSC 0
+#endif
+
+namespace noisepp
+{
+	class Module;
+
+	/// Returns the type of the specified module, defined in NoiseModule.h.
+	inline ModuleTypeId getModuleType (const Module *module);
+
+	/// Returns a time stamp for the profiler.
+	/// This is the CPU time stamp counter on x86, nanoseconds of a monotonic clock on other unix platforms and clock ticks elsewhere.
+	NOISEPP_INLINE unsigned long long Profiler_readCycles ()
+	{
+#if NOISEPP_PROFILER_RDTSC
+		return __rdtsc ();
+#elif NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+		return (unsigned long long)clock ();
+#else
+		struct timespec now;
+		clock_gettime (CLOCK_MONOTONIC, &now);
+		return now.tv_sec * 1000000000ULL + now.tv_nsec;
+#endif
+	}
+
+	/** Profiling counters of a single element.
+		Every cache has its own set of counters per element, so threads never share counters.
+	*/
+	struct ElementCounters
+	{
+		/// Number of values taken from the cache.
+		unsigned long long hits;
+		/// Number of values which had to be calculated.
+		unsigned long long misses;
+		/// Sum of the cycles of the sampled calculations.
+		unsigned long long cycles;
+		/// Number of sampled calculations.
+		unsigned long long samples;
+		/// Constructor.
+		ElementCounters () : hits(0), misses(0), cycles(0), samples(0) {}
+		/// Adds the specified counters.
+		void add (const ElementCounters &counters)
+		{
+			hits += counters.hits;
+			misses += counters.misses;
+			cycles += counters.cycles;
+			samples += counters.samples;
+		}
+	};
+
+	/** Profile of a single pipeline element, see Pipeline::getProfile().
+		Evaluations requested through the cache of another element, spans evaluated in batches and the
+		spans of the line jobs are counted. Values you request from an element yourself and analytic gradients don't show up.
+		The cycles include the time spent in the source elements.
+	*/
+	struct ElementProfile
+	{
+		/// The element ID.
+		ElementID element;
+		/// The module which created the element.
+		const Module *module;
+		/// The type of the module.
+		ModuleTypeId moduleType;
+		/// Number of requested values.
+		unsigned long long calls;
+		/// Number of values taken from the cache.
+		unsigned long long cacheHits;
+		/// Number of values which had to be calculated.
+		unsigned long long cacheMisses;
+		/// Sum of the cycles of the sampled calculations.
+		unsigned long long sampledCycles;
+		/// Number of sampled calculations.
+		unsigned long long samples;
+
+		/// Returns the average number of cycles per calculation.
+		double getCyclesPerCalculation () const
+		{
+			return samples ? double(sampledCycles) / double(samples) : 0.0;
+		}
+		/// Returns the estimated total number of cycles spent calculating values.
+		double getEstimatedCycles () const
+		{
+			return getCyclesPerCalculation () * double(cacheMisses);
+		}
+	};
+
+	/// Profile of a pipeline, one entry per element in order of the element IDs.
+	typedef std::vector<ElementProfile> PipelineProfile;
+};
+
+#endif
+
+#endif
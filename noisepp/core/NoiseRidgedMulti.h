@@ -83,12 +83,27 @@ namespace noisepp
 					scale *= lacunarity;
 					sw_freq *= lacunarity;
 				}
+				const Real amplitude = Generator1D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				const Interval offsetSignal = (-Interval (Real(0.0), amplitude) + mOffset).square ();
+				Interval weight (Real(1.0));
+				Interval value (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Interval signal = offsetSignal * weight;
+					weight = (signal * mGain).clamp (Real(-1.0), Real(1.0));
+					value = value + signal * mOctaves[o].spectralWeight;
+				}
+				mRange = value * Real(1.25) + Real(-1.0);
 			}
 			virtual ~RidgedMultiElement1D ()
 			{
 				delete mOctaves;
 				mOctaves = NULL;
 			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				Real value = 0.0;
@@ -111,6 +126,29 @@ namespace noisepp
 					value += signal * mOctaves[o].spectralWeight;
 				}
 
+				return (value * Real(1.25)) - Real(1.0);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real signal = 0.0;
+				Real weight = 1.0;
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					signal = Generator1D::calcGradientCoherentNoise (x, mOctaves[o].scale, mOctaves[o].seed, mQuality, mScale);
+					signal = mOffset - std::fabs(signal);
+					signal *= signal;
+					signal *= weight;
+					weight = signal * mGain;
+					if (weight > Real(1.0))
+						weight = Real(1.0);
+					if (weight < Real(-1.0))
+						weight = Real(-1.0);
+
+					value += signal * mOctaves[o].spectralWeight;
+				}
+
 				return (value * Real(1.25)) - Real(1.0);
 			}
 	};
@@ -165,12 +203,27 @@ namespace noisepp
 					scale *= lacunarity;
 					sw_freq *= lacunarity;
 				}
+				const Real amplitude = Generator2D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				const Interval offsetSignal = (-Interval (Real(0.0), amplitude) + mOffset).square ();
+				Interval weight (Real(1.0));
+				Interval value (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Interval signal = offsetSignal * weight;
+					weight = (signal * mGain).clamp (Real(-1.0), Real(1.0));
+					value = value + signal * mOctaves[o].spectralWeight;
+				}
+				mRange = value * Real(1.25) + Real(-1.0);
 			}
 			virtual ~RidgedMultiElement2D ()
 			{
 				delete mOctaves;
 				mOctaves = NULL;
 			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real value = 0.0;
@@ -196,6 +249,70 @@ namespace noisepp
 
 				return (value * Real(1.25)) - Real(1.0);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real signal = 0.0;
+				Real weight = 1.0;
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					signal = Generator2D::calcGradientCoherentNoise (x, y, mOctaves[o].scale, mOctaves[o].seed, mQuality, mScale);
+					signal = mOffset - std::fabs(signal);
+					signal *= signal;
+					signal *= weight;
+					weight = signal * mGain;
+					if (weight > Real(1.0))
+						weight = Real(1.0);
+					if (weight < Real(-1.0))
+						weight = Real(-1.0);
+
+					value += signal * mOctaves[o].spectralWeight;
+				}
+
+				return (value * Real(1.25)) - Real(1.0);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real weight = 1.0;
+				Real weightDx = 0.0, weightDy = 0.0;
+				dx = dy = Real(0.0);
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Real scale = mOctaves[o].scale;
+					const Real nx = Math::MakeInt32Range (x * scale);
+					const Real ny = Math::MakeInt32Range (y * scale);
+					Real sdx, sdy;
+					const Real noise = Generator2D::calcGradientCoherentNoiseGradient (nx, ny, mOctaves[o].seed, mQuality, mScale, sdx, sdy);
+					const Real ridge = mOffset - std::fabs(noise);
+					// derivative of the squared ridge, including the octave frequency
+					const Real ridgeFactor = Real(2.0) * ridge * (noise < Real(0.0) ? scale : -scale);
+					const Real signal = ridge * ridge * weight;
+					const Real signalDx = ridgeFactor * sdx * weight + ridge * ridge * weightDx;
+					const Real signalDy = ridgeFactor * sdy * weight + ridge * ridge * weightDy;
+					weight = signal * mGain;
+					if (weight > Real(1.0) || weight < Real(-1.0))
+					{
+						weight = (weight > Real(1.0)) ? Real(1.0) : Real(-1.0);
+						weightDx = weightDy = Real(0.0);
+					}
+					else
+					{
+						weightDx = signalDx * mGain;
+						weightDy = signalDy * mGain;
+					}
+
+					value += signal * mOctaves[o].spectralWeight;
+					dx += signalDx * mOctaves[o].spectralWeight;
+					dy += signalDy * mOctaves[o].spectralWeight;
+				}
+
+				dx *= Real(1.25);
+				dy *= Real(1.25);
+				return (value * Real(1.25)) - Real(1.0);
+			}
 	};
 
 	class RidgedMultiElement3D : public PipelineElement3D
@@ -248,12 +365,27 @@ namespace noisepp
 					scale *= lacunarity;
 					sw_freq *= lacunarity;
 				}
+				const Real amplitude = Generator3D::calcGradientCoherentNoiseBound (mQuality, mScale);
+				const Interval offsetSignal = (-Interval (Real(0.0), amplitude) + mOffset).square ();
+				Interval weight (Real(1.0));
+				Interval value (Real(0.0));
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Interval signal = offsetSignal * weight;
+					weight = (signal * mGain).clamp (Real(-1.0), Real(1.0));
+					value = value + signal * mOctaves[o].spectralWeight;
+				}
+				mRange = value * Real(1.25) + Real(-1.0);
 			}
 			virtual ~RidgedMultiElement3D ()
 			{
 				delete mOctaves;
 				mOctaves = NULL;
 			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real value = 0.0;
@@ -280,6 +412,75 @@ namespace noisepp
 
 				return (value * Real(1.25)) - Real(1.0);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real signal = 0.0;
+				Real weight = 1.0;
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					signal = Generator3D::calcGradientCoherentNoise (x, y, z, mOctaves[o].scale, mOctaves[o].seed, mQuality, mScale);
+					signal = mOffset - std::fabs(signal);
+					signal *= signal;
+					signal *= weight;
+					weight = signal * mGain;
+					if (weight > Real(1.0))
+						weight = Real(1.0);
+					if (weight < Real(-1.0))
+						weight = Real(-1.0);
+
+					value += signal * mOctaves[o].spectralWeight;
+				}
+
+				return (value * Real(1.25)) - Real(1.0);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				Real value = 0.0;
+				Real weight = 1.0;
+				Real weightDx = 0.0, weightDy = 0.0, weightDz = 0.0;
+				dx = dy = dz = Real(0.0);
+
+				for (size_t o=0;o<mOctaveCount;++o)
+				{
+					const Real scale = mOctaves[o].scale;
+					const Real nx = Math::MakeInt32Range (x * scale);
+					const Real ny = Math::MakeInt32Range (y * scale);
+					const Real nz = Math::MakeInt32Range (z * scale);
+					Real sdx, sdy, sdz;
+					const Real noise = Generator3D::calcGradientCoherentNoiseGradient (nx, ny, nz, mOctaves[o].seed, mQuality, mScale, sdx, sdy, sdz);
+					const Real ridge = mOffset - std::fabs(noise);
+					// derivative of the squared ridge, including the octave frequency
+					const Real ridgeFactor = Real(2.0) * ridge * (noise < Real(0.0) ? scale : -scale);
+					const Real signal = ridge * ridge * weight;
+					const Real signalDx = ridgeFactor * sdx * weight + ridge * ridge * weightDx;
+					const Real signalDy = ridgeFactor * sdy * weight + ridge * ridge * weightDy;
+					const Real signalDz = ridgeFactor * sdz * weight + ridge * ridge * weightDz;
+					weight = signal * mGain;
+					if (weight > Real(1.0) || weight < Real(-1.0))
+					{
+						weight = (weight > Real(1.0)) ? Real(1.0) : Real(-1.0);
+						weightDx = weightDy = weightDz = Real(0.0);
+					}
+					else
+					{
+						weightDx = signalDx * mGain;
+						weightDy = signalDy * mGain;
+						weightDz = signalDz * mGain;
+					}
+
+					value += signal * mOctaves[o].spectralWeight;
+					dx += signalDx * mOctaves[o].spectralWeight;
+					dy += signalDy * mOctaves[o].spectralWeight;
+					dz += signalDz * mOctaves[o].spectralWeight;
+				}
+
+				dx *= Real(1.25);
+				dy *= Real(1.25);
+				dz *= Real(1.25);
+				return (value * Real(1.25)) - Real(1.0);
+			}
 	};
 
 	/** Module for generating ridged-multifractal noise.
@@ -398,7 +599,7 @@ namespace noisepp
 				mScale = v;
 			}
 			/// Returns the noise scale factor.
-			Real getScale ()
+			Real getScale () const
 			{
 				return mScale;
 			}
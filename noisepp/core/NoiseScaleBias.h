@@ -42,6 +42,17 @@ namespace noisepp
 			ScaleBiasElement1D (const Pipeline1D *pipe, ElementID element, Real scale, Real bias) : mElement(element), mScale(scale), mBias(bias)
 			{
 				mElementPtr = pipe->getElement(mElement);
+				mRange = mElementPtr->getRange() * mScale + mBias;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = values[i] * mScale + mBias;
 			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
@@ -49,6 +60,12 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, cache);
 				return value * mScale + mBias;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				return value * mScale + mBias;
+			}
 	};
 
 	class ScaleBiasElement2D : public PipelineElement2D
@@ -62,6 +79,21 @@ namespace noisepp
 			ScaleBiasElement2D (const Pipeline2D *pipe, ElementID element, Real scale, Real bias) : mElement(element), mScale(scale), mBias(bias)
 			{
 				mElementPtr = pipe->getElement(mElement);
+				mRange = mElementPtr->getRange() * mScale + mBias;
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mElementPtr->getRegionRange (x, y) * mScale + mBias;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = values[i] * mScale + mBias;
 			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
@@ -69,6 +101,19 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, cache);
 				return value * mScale + mBias;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				return value * mScale + mBias;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x, y, dx, dy, cache);
+				dx *= mScale;
+				dy *= mScale;
+				return value * mScale + mBias;
+			}
 	};
 
 	class ScaleBiasElement3D : public PipelineElement3D
@@ -82,6 +127,21 @@ namespace noisepp
 			ScaleBiasElement3D (const Pipeline3D *pipe, ElementID element, Real scale, Real bias) : mElement(element), mScale(scale), mBias(bias)
 			{
 				mElementPtr = pipe->getElement(mElement);
+				mRange = mElementPtr->getRange() * mScale + mBias;
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mElementPtr->getRegionRange (x, y, z) * mScale + mBias;
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				for (size_t i=0;i<count;++i)
+					values[i] = values[i] * mScale + mBias;
 			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
@@ -89,6 +149,20 @@ namespace noisepp
 				value = getElementValue (mElementPtr, mElement, x, y, z, cache);
 				return value * mScale + mBias;
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				return value * mScale + mBias;
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x, y, z, dx, dy, dz, cache);
+				dx *= mScale;
+				dy *= mScale;
+				dz *= mScale;
+				return value * mScale + mBias;
+			}
 	};
 
 	/** Module for scaling with bias.
@@ -128,21 +202,21 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new ScaleBiasElement1D(pipe, first, mScale, mBias));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new ScaleBiasElement2D(pipe, first, mScale, mBias));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				return pipe->addElement (this, new ScaleBiasElement3D(pipe, first, mScale, mBias));
 			}
 			/// @copydoc noisepp::Module::getType()
@@ -26,78 +26,14 @@
 #ifndef NOISEPP_SCALEPOINT_H
 #define NOISEPP_SCALEPOINT_H
 
-#include "NoisePipeline.h"
-#include "NoiseModule.h"
+#include "NoiseTransformPoint.h"
 
 namespace noisepp
 {
-	class ScalePointElement1D : public PipelineElement1D
-	{
-		private:
-			ElementID mElement;
-			const PipelineElement1D *mElementPtr;
-			Real mScaleX;
-
-		public:
-			ScalePointElement1D (const Pipeline1D *pipe, ElementID element, Real scaleX) :
-				mElement(element), mScaleX(scaleX)
-			{
-				mElementPtr = pipe->getElement (mElement);
-			}
-			virtual Real getValue (Real x, Cache *cache) const
-			{
-				return getElementValue (mElementPtr, mElement, x*mScaleX, cache);
-			}
-
-	};
-
-	class ScalePointElement2D : public PipelineElement2D
-	{
-		private:
-			ElementID mElement;
-			const PipelineElement2D *mElementPtr;
-			Real mScaleX;
-			Real mScaleY;
-
-		public:
-			ScalePointElement2D (const Pipeline2D *pipe, ElementID element, Real scaleX, Real scaleY) :
-				mElement(element), mScaleX(scaleX), mScaleY(scaleY)
-			{
-				mElementPtr = pipe->getElement (mElement);
-			}
-			virtual Real getValue (Real x, Real y, Cache *cache) const
-			{
-				return getElementValue (mElementPtr, mElement, x*mScaleX, y*mScaleY, cache);
-			}
-
-	};
-
-	class ScalePointElement3D : public PipelineElement3D
-	{
-		private:
-			ElementID mElement;
-			const PipelineElement3D *mElementPtr;
-			Real mScaleX;
-			Real mScaleY;
-			Real mScaleZ;
-
-		public:
-			ScalePointElement3D (const Pipeline3D *pipe, ElementID element, Real scaleX, Real scaleY, Real scaleZ) :
-				mElement(element), mScaleX(scaleX), mScaleY(scaleY), mScaleZ(scaleZ)
-			{
-				mElementPtr = pipe->getElement (mElement);
-			}
-			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
-			{
-				return getElementValue (mElementPtr, mElement, x*mScaleX, y*mScaleY, z*mScaleZ, cache);
-			}
-
-	};
-
 	/** Transform module for scaling.
 		Transforms the source module by scaling the coordinates.
 	*/
-	class ScalePointModule : public Module
+	class ScalePointModule : public PointTransformModule
 	{
 		private:
 			Real mScaleX;
@@ -106,7 +42,7 @@ namespace noisepp
 
 		public:
 			/// Constructor.
-			ScalePointModule() : Module(1), mScaleX(1.0), mScaleY(1.0), mScaleZ(1.0)
+			ScalePointModule() : mScaleX(1.0), mScaleY(1.0), mScaleZ(1.0)
 			{
 			}
 			/// Sets the scaling applied to the x coordinate.
@@ -139,26 +75,13 @@ namespace noisepp
 			{
 				return mScaleZ;
 			}
-			/// @copydoc noisepp::Module::addToPipeline()
-			virtual ElementID addToPipeline (Pipeline1D *pipe) const
-			{
-				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				return pipe->addElement (this, new ScalePointElement1D(pipe, first, mScaleX));
-			}
-			/// @copydoc noisepp::Module::addToPipeline()
-			virtual ElementID addToPipeline (Pipeline2D *pipe) const
-			{
-				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				return pipe->addElement (this, new ScalePointElement2D(pipe, first, mScaleX, mScaleY));
-			}
-			/// @copydoc noisepp::Module::addToPipeline()
-			virtual ElementID addToPipeline (Pipeline3D *pipe) const
+			/// @copydoc noisepp::PointTransformModule::getTransform()
+			virtual void getTransform (TransformMatrix &matrix) const
 			{
-				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				return pipe->addElement (this, new ScalePointElement3D(pipe, first, mScaleX, mScaleY, mScaleZ));
+				matrix.setIdentity ();
+				matrix.m[0] = mScaleX;
+				matrix.m[5] = mScaleY;
+				matrix.m[10] = mScaleZ;
 			}
 			/// @copydoc noisepp::Module::getType()
 			ModuleTypeId getType() const { return MODULE_SCALEPOINT; }
@@ -31,6 +31,141 @@
 
 namespace noisepp
 {
+	/// Returns the source which is always selected for the specified control range,
+	/// or -1 if the selection depends on the control value.
+	inline int calcSelectedSource (const Interval &control, Real lowerBound, Real upperBound, Real edgeFalloff)
+	{
+		if (edgeFalloff > 0.0)
+		{
+			if (control.upper < lowerBound - edgeFalloff || control.lower >= upperBound + edgeFalloff)
+				return 0;
+			if (control.lower >= lowerBound + edgeFalloff && control.upper < upperBound - edgeFalloff)
+				return 1;
+		}
+		else
+		{
+			if (control.upper < lowerBound || control.lower > upperBound)
+				return 0;
+			if (control.isInside (lowerBound, upperBound))
+				return 1;
+		}
+		return -1;
+	}
+
+	/** Partitions a span of control values for batched select evaluation.
+		Each value is assigned to the left source, the right source or a blend of both,
+		so the sources only need to be evaluated for the indices which actually use them.
+	*/
+	class SelectPartition
+	{
+		public:
+			/// Selection modes.
+			enum
+			{
+				/// Left source only.
+				SELECT_LEFT,
+				/// Right source only.
+				SELECT_RIGHT,
+				/// Blend from left to right at the lower bound.
+				SELECT_BLEND_LOWER,
+				/// Blend from right to left at the upper bound.
+				SELECT_BLEND_UPPER
+			};
+
+			/// Indices which need the left source value.
+			int leftIndices[PIPELINE_BATCH_SIZE];
+			/// Number of indices which need the left source value.
+			size_t leftCount;
+			/// Compacted left source values.
+			Real leftValues[PIPELINE_BATCH_SIZE];
+			/// Indices which need the right source value.
+			int rightIndices[PIPELINE_BATCH_SIZE];
+			/// Number of indices which need the right source value.
+			size_t rightCount;
+			/// Compacted right source values.
+			Real rightValues[PIPELINE_BATCH_SIZE];
+			/// The selection mode per index.
+			unsigned char modes[PIPELINE_BATCH_SIZE];
+			/// The blend factor per index.
+			Real alphas[PIPELINE_BATCH_SIZE];
+
+			/// Partitions the specified control values.
+			void partition (const Real *control, size_t count, Real lowerBound, Real upperBound, Real edgeFalloff,
+				Real lowerBoundMinusFalloff, Real lowerBoundPlusFalloff, Real upperBoundMinusFalloff, Real upperBoundPlusFalloff, Real twoEdgeFalloff)
+			{
+				NoiseAssert (count <= PIPELINE_BATCH_SIZE, count);
+				leftCount = rightCount = 0;
+				for (size_t i=0;i<count;++i)
+				{
+					const Real controlValue = control[i];
+					unsigned char mode;
+					if (edgeFalloff > 0.0)
+					{
+						if (controlValue < lowerBoundMinusFalloff)
+							mode = SELECT_LEFT;
+						else if (controlValue < lowerBoundPlusFalloff)
+						{
+							mode = SELECT_BLEND_LOWER;
+							alphas[i] = Math::CubicCurve3 ((controlValue - lowerBoundMinusFalloff) / twoEdgeFalloff);
+						}
+						else if (controlValue < upperBoundMinusFalloff)
+							mode = SELECT_RIGHT;
+						else if (controlValue < upperBoundPlusFalloff)
+						{
+							mode = SELECT_BLEND_UPPER;
+							alphas[i] = Math::CubicCurve3 ((controlValue - upperBoundMinusFalloff) / twoEdgeFalloff);
+						}
+						else
+							mode = SELECT_LEFT;
+					}
+					else
+					{
+						if (controlValue < lowerBound || controlValue > upperBound)
+							mode = SELECT_LEFT;
+						else
+							mode = SELECT_RIGHT;
+					}
+					modes[i] = mode;
+					if (mode != SELECT_RIGHT)
+						leftIndices[leftCount++] = (int)i;
+					if (mode != SELECT_LEFT)
+						rightIndices[rightCount++] = (int)i;
+				}
+			}
+			/// Copies the values at the specified indices into a compacted array.
+			static NOISEPP_INLINE void gather (const Real *src, const int *indices, size_t count, Real *dest)
+			{
+				for (size_t i=0;i<count;++i)
+				{
+					dest[i] = src[indices[i]];
+				}
+			}
+			/// Writes the selected or blended source values to the output.
+			void combine (Real *values) const
+			{
+				for (size_t i=0;i<leftCount;++i)
+				{
+					values[leftIndices[i]] = leftValues[i];
+				}
+				for (size_t i=0;i<rightCount;++i)
+				{
+					const int index = rightIndices[i];
+					switch (modes[index])
+					{
+						case SELECT_BLEND_LOWER:
+							values[index] = Math::InterpLinear (values[index], rightValues[i], alphas[index]);
+							break;
+						case SELECT_BLEND_UPPER:
+							values[index] = Math::InterpLinear (rightValues[i], values[index], alphas[index]);
+							break;
+						default:
+							values[index] = rightValues[i];
+							break;
+					}
+				}
+			}
+	};
+
 	class SelectElement1D : public PipelineElement1D
 	{
 		private:
@@ -51,6 +186,7 @@ namespace noisepp
 				mLeftPtr = pipe->getElement(mLeft);
 				mRightPtr = pipe->getElement(mRight);
 				mControlPtr = pipe->getElement(mControl);
+				mRange = Interval::Hull (mLeftPtr->getRange(), mRightPtr->getRange());
 
 				mLowerBoundPlusFalloff = mLowerBound + mEdgeFalloff;
 				mLowerBoundMinusFalloff = mLowerBound - mEdgeFalloff;
@@ -58,6 +194,43 @@ namespace noisepp
 				mUpperBoundMinusFalloff = mUpperBound - mEdgeFalloff;
 				mTwoEdgeFalloff = Real(2.0) * mEdgeFalloff;
 			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar () && mControlPtr->isColumnar ();
+			}
+			/// Evaluates the control element for the whole span and each source only where it is selected.
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				// inputs which aren't columnar may share elements, only the per-point path evaluates those once
+				if (!mLeftPtr->isColumnar () || !mRightPtr->isColumnar () || !mControlPtr->isColumnar ())
+				{
+					PipelineElement1D::getValues (x, values, count, cache);
+					return;
+				}
+				SelectPartition part;
+				Real xs[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mControlPtr, mControl, x, values, n, cache);
+					part.partition (values, n, mLowerBound, mUpperBound, mEdgeFalloff,
+						mLowerBoundMinusFalloff, mLowerBoundPlusFalloff, mUpperBoundMinusFalloff, mUpperBoundPlusFalloff, mTwoEdgeFalloff);
+					if (part.leftCount > 0)
+					{
+						SelectPartition::gather (x, part.leftIndices, part.leftCount, xs);
+						getElementValues (mLeftPtr, mLeft, xs, part.leftValues, part.leftCount, cache);
+					}
+					if (part.rightCount > 0)
+					{
+						SelectPartition::gather (x, part.rightIndices, part.rightCount, xs);
+						getElementValues (mRightPtr, mRight, xs, part.rightValues, part.rightCount, cache);
+					}
+					part.combine (values);
+					x += n;
+					values += n;
+					count -= n;
+				}
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				Real controlValue = getElementValue (mControlPtr, mControl, x, cache);
@@ -105,6 +278,53 @@ namespace noisepp
 					}
 				}
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real controlValue = mControlPtr->getWorldValue (x, cache);
+				Real alpha;
+				if (mEdgeFalloff > 0.0)
+				{
+					if (controlValue < mLowerBoundMinusFalloff)
+					{
+						return mLeftPtr->getWorldValue (x, cache);
+					}
+					else if (controlValue < mLowerBoundPlusFalloff)
+					{
+						alpha = Math::CubicCurve3 ((controlValue - mLowerBoundMinusFalloff) / mTwoEdgeFalloff);
+						return Math::InterpLinear (
+							mLeftPtr->getWorldValue (x, cache),
+							mRightPtr->getWorldValue (x, cache),
+							alpha);
+					}
+					else if (controlValue < mUpperBoundMinusFalloff)
+					{
+						return mRightPtr->getWorldValue (x, cache);
+					}
+					else if (controlValue < mUpperBoundPlusFalloff)
+					{
+						alpha = Math::CubicCurve3 ((controlValue - mUpperBoundMinusFalloff) / mTwoEdgeFalloff);
+						return Math::InterpLinear (
+							mRightPtr->getWorldValue (x, cache),
+							mLeftPtr->getWorldValue (x, cache),
+							alpha);
+					}
+					else
+					{
+						return mLeftPtr->getWorldValue (x, cache);
+					}
+				}
+				else
+				{
+					if (controlValue < mLowerBound || controlValue > mUpperBound)
+					{
+						return mLeftPtr->getWorldValue (x, cache);
+					}
+					else
+					{
+						return mRightPtr->getWorldValue (x, cache);
+					}
+				}
+			}
 	};
 
 	class SelectElement2D : public PipelineElement2D
@@ -127,6 +347,7 @@ namespace noisepp
 				mLeftPtr = pipe->getElement(mLeft);
 				mRightPtr = pipe->getElement(mRight);
 				mControlPtr = pipe->getElement(mControl);
+				mRange = Interval::Hull (mLeftPtr->getRange(), mRightPtr->getRange());
 
 				mLowerBoundPlusFalloff = mLowerBound + mEdgeFalloff;
 				mLowerBoundMinusFalloff = mLowerBound - mEdgeFalloff;
@@ -134,6 +355,56 @@ namespace noisepp
 				mUpperBoundMinusFalloff = mUpperBound - mEdgeFalloff;
 				mTwoEdgeFalloff = Real(2.0) * mEdgeFalloff;
 			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar () && mControlPtr->isColumnar ();
+			}
+			/// Evaluates the control element for the whole span and each source only where it is selected.
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				// inputs which aren't columnar may share elements, only the per-point path evaluates those once
+				if (!mLeftPtr->isColumnar () || !mRightPtr->isColumnar () || !mControlPtr->isColumnar ())
+				{
+					PipelineElement2D::getValues (x, y, values, count, cache);
+					return;
+				}
+				SelectPartition part;
+				Real xs[PIPELINE_BATCH_SIZE];
+				Real ys[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mControlPtr, mControl, x, y, values, n, cache);
+					part.partition (values, n, mLowerBound, mUpperBound, mEdgeFalloff,
+						mLowerBoundMinusFalloff, mLowerBoundPlusFalloff, mUpperBoundMinusFalloff, mUpperBoundPlusFalloff, mTwoEdgeFalloff);
+					if (part.leftCount > 0)
+					{
+						SelectPartition::gather (x, part.leftIndices, part.leftCount, xs);
+						SelectPartition::gather (y, part.leftIndices, part.leftCount, ys);
+						getElementValues (mLeftPtr, mLeft, xs, ys, part.leftValues, part.leftCount, cache);
+					}
+					if (part.rightCount > 0)
+					{
+						SelectPartition::gather (x, part.rightIndices, part.rightCount, xs);
+						SelectPartition::gather (y, part.rightIndices, part.rightCount, ys);
+						getElementValues (mRightPtr, mRight, xs, ys, part.rightValues, part.rightCount, cache);
+					}
+					part.combine (values);
+					x += n;
+					y += n;
+					values += n;
+					count -= n;
+				}
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				const int selected = calcSelectedSource (mControlPtr->getRegionRange (x, y), mLowerBound, mUpperBound, mEdgeFalloff);
+				if (selected == 0)
+					return mLeftPtr->getRegionRange (x, y);
+				else if (selected == 1)
+					return mRightPtr->getRegionRange (x, y);
+				return Interval::Hull (mLeftPtr->getRegionRange (x, y), mRightPtr->getRegionRange (x, y));
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real controlValue = getElementValue (mControlPtr, mControl, x, y, cache);
@@ -181,6 +452,53 @@ namespace noisepp
 					}
 				}
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real controlValue = mControlPtr->getWorldValue (x, y, cache);
+				Real alpha;
+				if (mEdgeFalloff > 0.0)
+				{
+					if (controlValue < mLowerBoundMinusFalloff)
+					{
+						return mLeftPtr->getWorldValue (x, y, cache);
+					}
+					else if (controlValue < mLowerBoundPlusFalloff)
+					{
+						alpha = Math::CubicCurve3 ((controlValue - mLowerBoundMinusFalloff) / mTwoEdgeFalloff);
+						return Math::InterpLinear (
+							mLeftPtr->getWorldValue (x, y, cache),
+							mRightPtr->getWorldValue (x, y, cache),
+							alpha);
+					}
+					else if (controlValue < mUpperBoundMinusFalloff)
+					{
+						return mRightPtr->getWorldValue (x, y, cache);
+					}
+					else if (controlValue < mUpperBoundPlusFalloff)
+					{
+						alpha = Math::CubicCurve3 ((controlValue - mUpperBoundMinusFalloff) / mTwoEdgeFalloff);
+						return Math::InterpLinear (
+							mRightPtr->getWorldValue (x, y, cache),
+							mLeftPtr->getWorldValue (x, y, cache),
+							alpha);
+					}
+					else
+					{
+						return mLeftPtr->getWorldValue (x, y, cache);
+					}
+				}
+				else
+				{
+					if (controlValue < mLowerBound || controlValue > mUpperBound)
+					{
+						return mLeftPtr->getWorldValue (x, y, cache);
+					}
+					else
+					{
+						return mRightPtr->getWorldValue (x, y, cache);
+					}
+				}
+			}
 	};
 
 	class SelectElement3D : public PipelineElement3D
@@ -203,6 +521,7 @@ namespace noisepp
 				mLeftPtr = pipe->getElement(mLeft);
 				mRightPtr = pipe->getElement(mRight);
 				mControlPtr = pipe->getElement(mControl);
+				mRange = Interval::Hull (mLeftPtr->getRange(), mRightPtr->getRange());
 
 				mLowerBoundPlusFalloff = mLowerBound + mEdgeFalloff;
 				mLowerBoundMinusFalloff = mLowerBound - mEdgeFalloff;
@@ -210,6 +529,60 @@ namespace noisepp
 				mUpperBoundMinusFalloff = mUpperBound - mEdgeFalloff;
 				mTwoEdgeFalloff = Real(2.0) * mEdgeFalloff;
 			}
+			virtual bool checkColumnar () const
+			{
+				return mLeftPtr->isColumnar () && mRightPtr->isColumnar () && mControlPtr->isColumnar ();
+			}
+			/// Evaluates the control element for the whole span and each source only where it is selected.
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				// inputs which aren't columnar may share elements, only the per-point path evaluates those once
+				if (!mLeftPtr->isColumnar () || !mRightPtr->isColumnar () || !mControlPtr->isColumnar ())
+				{
+					PipelineElement3D::getValues (x, y, z, values, count, cache);
+					return;
+				}
+				SelectPartition part;
+				Real xs[PIPELINE_BATCH_SIZE];
+				Real ys[PIPELINE_BATCH_SIZE];
+				Real zs[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					getElementValues (mControlPtr, mControl, x, y, z, values, n, cache);
+					part.partition (values, n, mLowerBound, mUpperBound, mEdgeFalloff,
+						mLowerBoundMinusFalloff, mLowerBoundPlusFalloff, mUpperBoundMinusFalloff, mUpperBoundPlusFalloff, mTwoEdgeFalloff);
+					if (part.leftCount > 0)
+					{
+						SelectPartition::gather (x, part.leftIndices, part.leftCount, xs);
+						SelectPartition::gather (y, part.leftIndices, part.leftCount, ys);
+						SelectPartition::gather (z, part.leftIndices, part.leftCount, zs);
+						getElementValues (mLeftPtr, mLeft, xs, ys, zs, part.leftValues, part.leftCount, cache);
+					}
+					if (part.rightCount > 0)
+					{
+						SelectPartition::gather (x, part.rightIndices, part.rightCount, xs);
+						SelectPartition::gather (y, part.rightIndices, part.rightCount, ys);
+						SelectPartition::gather (z, part.rightIndices, part.rightCount, zs);
+						getElementValues (mRightPtr, mRight, xs, ys, zs, part.rightValues, part.rightCount, cache);
+					}
+					part.combine (values);
+					x += n;
+					y += n;
+					z += n;
+					values += n;
+					count -= n;
+				}
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				const int selected = calcSelectedSource (mControlPtr->getRegionRange (x, y, z), mLowerBound, mUpperBound, mEdgeFalloff);
+				if (selected == 0)
+					return mLeftPtr->getRegionRange (x, y, z);
+				else if (selected == 1)
+					return mRightPtr->getRegionRange (x, y, z);
+				return Interval::Hull (mLeftPtr->getRegionRange (x, y, z), mRightPtr->getRegionRange (x, y, z));
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real controlValue = getElementValue (mControlPtr, mControl, x, y, z, cache);
@@ -257,6 +630,53 @@ namespace noisepp
 					}
 				}
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real controlValue = mControlPtr->getWorldValue (x, y, z, cache);
+				Real alpha;
+				if (mEdgeFalloff > 0.0)
+				{
+					if (controlValue < mLowerBoundMinusFalloff)
+					{
+						return mLeftPtr->getWorldValue (x, y, z, cache);
+					}
+					else if (controlValue < mLowerBoundPlusFalloff)
+					{
+						alpha = Math::CubicCurve3 ((controlValue - mLowerBoundMinusFalloff) / mTwoEdgeFalloff);
+						return Math::InterpLinear (
+							mLeftPtr->getWorldValue (x, y, z, cache),
+							mRightPtr->getWorldValue (x, y, z, cache),
+							alpha);
+					}
+					else if (controlValue < mUpperBoundMinusFalloff)
+					{
+						return mRightPtr->getWorldValue (x, y, z, cache);
+					}
+					else if (controlValue < mUpperBoundPlusFalloff)
+					{
+						alpha = Math::CubicCurve3 ((controlValue - mUpperBoundMinusFalloff) / mTwoEdgeFalloff);
+						return Math::InterpLinear (
+							mRightPtr->getWorldValue (x, y, z, cache),
+							mLeftPtr->getWorldValue (x, y, z, cache),
+							alpha);
+					}
+					else
+					{
+						return mLeftPtr->getWorldValue (x, y, z, cache);
+					}
+				}
+				else
+				{
+					if (controlValue < mLowerBound || controlValue > mUpperBound)
+					{
+						return mLeftPtr->getWorldValue (x, y, z, cache);
+					}
+					else
+					{
+						return mRightPtr->getWorldValue (x, y, z, cache);
+					}
+				}
+			}
 	};
 
 	/** Select module.
@@ -272,6 +692,13 @@ namespace noisepp
 			Real mLowerBound, mUpperBound;
 			Real mEdgeFalloff;
 
+			/// Returns the source which is always selected for the specified control range,
+			/// or -1 if the selection depends on the control value.
+			int getSelectedSource (const Interval &control) const
+			{
+				return calcSelectedSource (control, mLowerBound, mUpperBound, mEdgeFalloff);
+			}
+
 		public:
 			SelectModule() : mLowerBound(-1.0), mUpperBound(1.0), mEdgeFalloff(0.0)
 			{
@@ -311,27 +738,36 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
-				ElementID third = getSourceModule(2)->addToPipeline(pipe);
+				ElementID third = pipe->addSource(getSourceModule(2));
+				const int selected = getSelectedSource (pipe->getElement(third)->getRange());
+				if (selected >= 0)
+					return pipe->addAlias (this, pipe->addSource(getSourceModule(selected)));
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
 				return pipe->addElement (this, new SelectElement1D(pipe, first, second, third, mLowerBound, mUpperBound, mEdgeFalloff));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
-				ElementID third = getSourceModule(2)->addToPipeline(pipe);
+				ElementID third = pipe->addSource(getSourceModule(2));
+				const int selected = getSelectedSource (pipe->getElement(third)->getRange());
+				if (selected >= 0)
+					return pipe->addAlias (this, pipe->addSource(getSourceModule(selected)));
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
 				return pipe->addElement (this, new SelectElement2D(pipe, first, second, third, mLowerBound, mUpperBound, mEdgeFalloff));
 			}
 			/// @copydoc noisepp::Module::addToPipeline()
 			virtual ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				ElementID second = getSourceModule(1)->addToPipeline(pipe);
-				ElementID third = getSourceModule(2)->addToPipeline(pipe);
+				ElementID third = pipe->addSource(getSourceModule(2));
+				const int selected = getSelectedSource (pipe->getElement(third)->getRange());
+				if (selected >= 0)
+					return pipe->addAlias (this, pipe->addSource(getSourceModule(selected)));
+				ElementID first = pipe->addSource(getSourceModule(0));
+				ElementID second = pipe->addSource(getSourceModule(1));
 				return pipe->addElement (this, new SelectElement3D(pipe, first, second, third, mLowerBound, mUpperBound, mEdgeFalloff));
 			}
 			/// @copydoc noisepp::Module::getType()
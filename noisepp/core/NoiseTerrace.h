@@ -28,6 +28,7 @@
 
 #include "NoisePipeline.h"
 #include "NoiseModule.h"
+#include "NoiseControlPointLookup.h"
 
 namespace noisepp
 {
@@ -42,6 +43,7 @@ namespace noisepp
 			Real *mControlPoints;
 			int mControlPointCount;
 			bool mInvert;
+			ControlPointLookup mLookup;
 
 			NOISEPP_INLINE int clampValue (int i, int lo, int hi) const
 			{
@@ -53,17 +55,8 @@ namespace noisepp
 					return i;
 			}
 
-			NOISEPP_INLINE Real mapValue (Real value) const
+			NOISEPP_INLINE Real interpolate (Real value, int index) const
 			{
-				int index;
-				for (index=0;index<mControlPointCount;++index)
-				{
-					if (value < mControlPoints[index])
-					{
-						break;
-					}
-				}
-
 				const int index0 = clampValue (index-1, 0, mControlPointCount-1);
 				const int index1 = clampValue (index, 0, mControlPointCount-1);
 
@@ -82,18 +75,44 @@ namespace noisepp
 				}
 				return Math::InterpLinear (in0, in1, a*a);
 			}
+			NOISEPP_INLINE Real mapValue (Real value) const
+			{
+				return interpolate (value, mLookup.find(value));
+			}
 		public:
-			TerraceElementBase (const Pipeline<PipelineElement> *pipe, ElementID element, Real *points, int count, bool invert) : mElement(element), mControlPoints(points), mControlPointCount(count), mInvert(invert)
+			TerraceElementBase (const Pipeline<PipelineElement> *pipe, ElementID element, Real *points, int count, bool invert) : mElement(element), mControlPoints(points), mControlPointCount(count), mInvert(invert), mLookup(points, count)
 			{
 				NoiseAssert (points != NULL, points);
 				NoiseAssert (count >= 2, count);
 				mElementPtr = pipe->getElement (mElement);
+				this->mRange = Interval (points[0], points[count-1]);
+			}
+			virtual bool checkColumnar () const
+			{
+				return mElementPtr->isColumnar ();
 			}
 			virtual ~TerraceElementBase ()
 			{
 				delete[] mControlPoints;
 				mControlPoints = NULL;
 			}
+			/// Maps a span of source values onto the terrace.
+			void mapValues (const Real *in, Real *out, size_t count) const
+			{
+				int indices[PIPELINE_BATCH_SIZE];
+				while (count > 0)
+				{
+					const size_t n = count < PIPELINE_BATCH_SIZE ? count : PIPELINE_BATCH_SIZE;
+					mLookup.find (in, indices, n);
+					for (size_t i=0;i<n;++i)
+					{
+						out[i] = interpolate (in[i], indices[i]);
+					}
+					in += n;
+					out += n;
+					count -= n;
+				}
+			}
 	};
 
 	class TerraceElement1D : public TerraceElementBase<PipelineElement1D>
@@ -102,12 +121,23 @@ namespace noisepp
 			TerraceElement1D (const Pipeline1D *pipe, ElementID element, Real *points, int count, bool invert) : TerraceElementBase<PipelineElement1D>(pipe, element, points, count, invert)
 			{
 			}
+			virtual void getValues (const Real *x, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, values, count, cache);
+				TerraceElementBase<PipelineElement1D>::mapValues (values, values, count);
+			}
 			virtual Real getValue (Real x, Cache *cache) const
 			{
 				Real value;
 				value = getElementValue (mElementPtr, mElement, x, cache);
 				return TerraceElementBase<PipelineElement1D>::mapValue(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, cache);
+				return TerraceElementBase<PipelineElement1D>::mapValue(value);
+			}
 	};
 
 	class TerraceElement2D : public TerraceElementBase<PipelineElement2D>
@@ -116,12 +146,29 @@ namespace noisepp
 			TerraceElement2D (const Pipeline2D *pipe, ElementID element, Real *points, int count, bool invert) : TerraceElementBase<PipelineElement2D>(pipe, element, points, count, invert)
 			{
 			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				const Interval range = mElementPtr->getRegionRange (x, y);
+				// the terrace curve is monotonic
+				return Interval::Hull (Interval (mapValue (range.lower)), Interval (mapValue (range.upper)));
+			}
+			virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, values, count, cache);
+				TerraceElementBase<PipelineElement2D>::mapValues (values, values, count);
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real value;
 				value = getElementValue (mElementPtr, mElement, x, y, cache);
 				return TerraceElementBase<PipelineElement2D>::mapValue(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, cache);
+				return TerraceElementBase<PipelineElement2D>::mapValue(value);
+			}
 	};
 
 	class TerraceElement3D : public TerraceElementBase<PipelineElement3D>
@@ -130,12 +177,29 @@ namespace noisepp
 			TerraceElement3D (const Pipeline3D *pipe, ElementID element, Real *points, int count, bool invert) : TerraceElementBase<PipelineElement3D>(pipe, element, points, count, invert)
 			{
 			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				const Interval range = mElementPtr->getRegionRange (x, y, z);
+				// the terrace curve is monotonic
+				return Interval::Hull (Interval (mapValue (range.lower)), Interval (mapValue (range.upper)));
+			}
+			virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+			{
+				getElementValues (mElementPtr, mElement, x, y, z, values, count, cache);
+				TerraceElementBase<PipelineElement3D>::mapValues (values, values, count);
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real value;
 				value = getElementValue (mElementPtr, mElement, x, y, z, cache);
 				return TerraceElementBase<PipelineElement3D>::mapValue(value);
 			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				Real value;
+				value = mElementPtr->getWorldValue (x, y, z, cache);
+				return TerraceElementBase<PipelineElement3D>::mapValue(value);
+			}
 	};
 
 	/** Terrace forming module.
@@ -182,7 +246,7 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				int count = (int)mControlPoints.size ();
 				NoiseAssert (count >= 2, count);
 				Real *points = new Real[count];
@@ -196,7 +260,7 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				int count = (int)mControlPoints.size ();
 				NoiseAssert (count >= 2, count);
 				Real *points = new Real[count];
@@ -210,7 +274,7 @@ namespace noisepp
 			ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				int count = (int)mControlPoints.size ();
 				NoiseAssert (count >= 2, count);
 				Real *points = new Real[count];
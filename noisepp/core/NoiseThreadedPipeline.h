@@ -27,6 +27,7 @@
 #define NOISEPP_THREADEDPIPELINE_H
 
 #include "NoisePipeline.h"
+#include "NoiseTrace.h"
 
 #if NOISEPP_ENABLE_THREADS == 0
 #error To use this classes please set NOISEPP_ENABLE_THREADS to 1
@@ -53,34 +54,102 @@ namespace noisepp
 			bool mThreadsDone;
 			unsigned mWorkingThreads;
 			PipelineJobQueue mJobsDone;
+#if NOISEPP_ENABLE_TRACING
+			TraceRecorder *mTraceRecorder;
+			TraceBuffer *mMainTrace;
+			/// Time stamps of the queued jobs, negative if no recorder was set.
+			std::queue<double> mJobTimes;
+			/// Time stamps of the executed jobs.
+			std::queue<double> mJobsDoneTimes;
+#endif
 			void threadFunction ()
 			{
 				Cache *cache = NULL;
+#if NOISEPP_ENABLE_TRACING
+				TraceRecorder *recorder = NULL;
+				TraceBuffer *trace = NULL;
+				double traceStart = 0, traceEnd = 0;
+#endif
 				threadpp::Mutex::Lock lk(mMutex);
 				while (!mThreadsDone)
 				{
 					if (Pipeline<Element>::mJobs.empty())
+					{
+#if NOISEPP_ENABLE_TRACING
+						if (trace)
+							traceStart = recorder->now ();
 						mCond.wait(lk);
+						if (trace && recorder == mTraceRecorder && !mThreadsDone)
+							trace->add ("idle", traceStart, recorder->now ());
+#else
+						mCond.wait(lk);
+#endif
+					}
+#if NOISEPP_ENABLE_TRACING
+					if (recorder != mTraceRecorder)
+					{
+						recorder = mTraceRecorder;
+						trace = recorder ? recorder->createBuffer ("pipeline worker") : NULL;
+					}
+#endif
 					if (!Pipeline<Element>::mJobs.empty())
 					{
 						PipelineJob *job = Pipeline<Element>::mJobs.front ();
 						Pipeline<Element>::mJobs.pop ();
+#if NOISEPP_ENABLE_TRACING
+						const double queued = mJobTimes.front ();
+						mJobTimes.pop ();
+						const bool tracing = (trace != NULL);
+#endif
 						++mWorkingThreads;
+#if NOISEPP_ENABLE_PROFILING
+						// the pipeline registers the profiling counters of the cache, which needs the lock
+						if (!cache)
+							cache = Pipeline<Element>::createCache();
+						lk.unlock ();
+#else
 						lk.unlock ();
 						if (!cache)
 							cache = Pipeline<Element>::createCache();
+#endif
+#if NOISEPP_ENABLE_TRACING
+						if (tracing)
+							traceStart = recorder->now ();
 						job->execute(cache);
+						if (tracing)
+						{
+							traceEnd = recorder->now ();
+							if (queued >= 0)
+								trace->add ("execute", traceStart, traceEnd, "queued_us", traceStart - queued);
+							else
+								trace->add ("execute", traceStart, traceEnd);
+						}
 						lk.lock ();
+						if (tracing)
+							trace->add ("lock", traceEnd, recorder->now ());
+						mJobsDoneTimes.push (tracing ? traceEnd : -1.0);
+#else
+						job->execute(cache);
+						lk.lock ();
+#endif
 						--mWorkingThreads;
 						mJobsDone.push (job);
 						mMainCond.notifyOne ();
 					}
 				}
+#if NOISEPP_ENABLE_PROFILING
+				if (cache)
+				{
+					Pipeline<Element>::freeCache (cache);
+				}
+				lk.unlock ();
+#else
 				lk.unlock ();
 				if (cache)
 				{
 					Pipeline<Element>::freeCache (cache);
 				}
+#endif
 			}
 			static void *threadEntry (void *pipe)
 			{
@@ -94,6 +163,10 @@ namespace noisepp
 			ThreadedPipeline (size_t numberOfThreads) : mThreadsDone(false), mWorkingThreads(0)
 			{
 				NoiseAssert (numberOfThreads > 0, numberOfThreads);
+#if NOISEPP_ENABLE_TRACING
+				mTraceRecorder = NULL;
+				mMainTrace = NULL;
+#endif
 				for (size_t i=0;i<numberOfThreads;++i)
 				{
 					mThreads.createThread (threadEntry, this);
@@ -108,13 +181,32 @@ namespace noisepp
 				while (!Pipeline<Element>::mJobs.empty() || mWorkingThreads > 0)
 				{
 					if (!Pipeline<Element>::mJobs.empty() || mWorkingThreads > 0)
+					{
+#if NOISEPP_ENABLE_TRACING
+						const double waitStart = mMainTrace ? mTraceRecorder->now () : 0;
+						mMainCond.wait(lk);
+						if (mMainTrace)
+							mMainTrace->add ("wait", waitStart, mTraceRecorder->now ());
+#else
 						mMainCond.wait(lk);
+#endif
+					}
 					while (!mJobsDone.empty())
 					{
 						PipelineJob *job = mJobsDone.front ();
 						mJobsDone.pop ();
+#if NOISEPP_ENABLE_TRACING
+						const double done = mJobsDoneTimes.front ();
+						mJobsDoneTimes.pop ();
 						lk.unlock ();
+						const double finishStart = mMainTrace ? mTraceRecorder->now () : 0;
 						job->finish ();
+						if (mMainTrace && done >= 0)
+							mMainTrace->add ("finish", finishStart, mTraceRecorder->now (), "latency_us", finishStart - done);
+#else
+						lk.unlock ();
+						job->finish ();
+#endif
 						delete job;
 						lk.lock ();
 					}
@@ -126,7 +218,25 @@ namespace noisepp
 				NoiseAssert (job != NULL, job);
 				threadpp::Mutex::Lock lk(mMutex);
 				Pipeline<Element>::mJobs.push (job);
+#if NOISEPP_ENABLE_TRACING
+				mJobTimes.push (mTraceRecorder ? mTraceRecorder->now () : -1.0);
+#endif
 			}
+#if NOISEPP_ENABLE_TRACING
+			/// Sets the recorder for the scheduling events or NULL to stop recording.
+			/// The recorder must stay valid while it is set. Don't call this while jobs are executed.
+			void setTraceRecorder (TraceRecorder *recorder)
+			{
+				threadpp::Mutex::Lock lk(mMutex);
+				mTraceRecorder = recorder;
+				mMainTrace = recorder ? recorder->createBuffer ("main") : NULL;
+			}
+			/// Returns the recorder for the scheduling events.
+			TraceRecorder *getTraceRecorder () const
+			{
+				return mTraceRecorder;
+			}
+#endif
 			/// Destructor.
 			virtual ~ThreadedPipeline ()
 			{
@@ -0,0 +1,261 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEPP_TRACE_H
+#define NOISEPP_TRACE_H
+
+#include "NoisePrerequisites.h"
+
+#if NOISEPP_ENABLE_TRACING
+
+#include <ostream>
+#include <sstream>
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+namespace noisepp
+{
+	/// A recorded trace event.
+	struct TraceEvent
+	{
+		/// Name of the event, has to be a string literal.
+		const char *name;
+		/// Start time in microseconds since the creation of the recorder.
+		double start;
+		/// Duration in microseconds.
+		double duration;
+		/// Name of the additional argument or NULL.
+		const char *argName;
+		/// Value of the additional argument in microseconds.
+		double argValue;
+	};
+
+	/** Event buffer of a single thread.
+		Only the owning thread adds events, so no locking is needed.
+		The capacity is fixed, events added to a full buffer are counted but dropped.
+	*/
+	class TraceBuffer
+	{
+		private:
+			std::vector<TraceEvent> mEvents;
+			size_t mCount;
+			size_t mDropped;
+			int mThreadID;
+			std::string mThreadName;
+
+		public:
+			/// Constructor.
+			TraceBuffer (int threadID, const std::string &threadName, size_t capacity) :
+				mEvents(capacity), mCount(0), mDropped(0), mThreadID(threadID), mThreadName(threadName)
+			{
+			}
+			/// Adds an event.
+			/// @param name The name of the event, has to be a string literal.
+			/// @param start The start time returned by TraceRecorder::now().
+			/// @param end The end time returned by TraceRecorder::now().
+			/// @param argName The name of an additional argument or NULL.
+			/// @param argValue The value of the additional argument in microseconds.
+			NOISEPP_INLINE void add (const char *name, double start, double end, const char *argName=0, double argValue=0)
+			{
+				if (mCount == mEvents.size())
+				{
+					++mDropped;
+					return;
+				}
+				TraceEvent &e = mEvents[mCount++];
+				e.name = name;
+				e.start = start;
+				e.duration = end - start;
+				e.argName = argName;
+				e.argValue = argValue;
+			}
+			/// Returns the number of recorded events.
+			size_t getEventCount () const
+			{
+				return mCount;
+			}
+			/// Returns the specified event.
+			const TraceEvent &getEvent (size_t i) const
+			{
+				NoiseAssertRange (i, mCount);
+				return mEvents[i];
+			}
+			/// Returns the number of events dropped because the buffer was full.
+			size_t getDroppedCount () const
+			{
+				return mDropped;
+			}
+			/// Returns the thread ID used in the trace.
+			int getThreadID () const
+			{
+				return mThreadID;
+			}
+			/// Returns the thread name used in the trace.
+			const std::string &getThreadName () const
+			{
+				return mThreadName;
+			}
+			/// Removes all events.
+			void clear ()
+			{
+				mCount = 0;
+				mDropped = 0;
+			}
+	};
+
+	/** Records the scheduling of threaded pipelines and job queues.
+		Set it with ThreadedPipeline::setTraceRecorder() or utils::ThreadedJobQueue::setTraceRecorder().
+		Each worker thread records the execution of its jobs, the time spent waiting for jobs and
+		the time spent waiting for the queue lock into its own buffer. The main thread records the finish() calls.
+		Only available if NOISEPP_ENABLE_TRACING is set to 1, otherwise the queues contain no tracing code at all.
+	*/
+	class TraceRecorder
+	{
+		private:
+			std::vector<TraceBuffer*> mBuffers;
+			size_t mCapacity;
+			double mEpoch;
+#if NOISEPP_ENABLE_THREADS
+			threadpp::Mutex mMutex;
+#endif
+
+			static double getMicroseconds ()
+			{
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+				LARGE_INTEGER frequency, now;
+				QueryPerformanceFrequency (&frequency);
+				QueryPerformanceCounter (&now);
+				return double(now.QuadPart) * 1000000.0 / double(frequency.QuadPart);
+#else
+				struct timespec now;
+				clock_gettime (CLOCK_MONOTONIC, &now);
+				return double(now.tv_sec) * 1000000.0 + double(now.tv_nsec) / 1000.0;
+#endif
+			}
+			static void writeString (std::ostream &out, const std::string &s)
+			{
+				out << '"';
+				for (size_t i=0;i<s.size();++i)
+				{
+					if (s[i] == '"' || s[i] == '\\')
+						out << '\\';
+					out << s[i];
+				}
+				out << '"';
+			}
+
+		public:
+			/// Constructor.
+			/// @param eventsPerThread The capacity of the buffer of each thread.
+			TraceRecorder (size_t eventsPerThread=65536) : mCapacity(eventsPerThread), mEpoch(getMicroseconds())
+			{
+			}
+			/// Returns the current time in microseconds since the creation of the recorder.
+			double now () const
+			{
+				return getMicroseconds () - mEpoch;
+			}
+			/// Creates the buffer of a thread. This is called once by each thread which records events.
+			/// @param threadName The thread name shown in the trace, the thread ID is appended.
+			TraceBuffer *createBuffer (const std::string &threadName)
+			{
+#if NOISEPP_ENABLE_THREADS
+				threadpp::Mutex::Lock lk(mMutex);
+#endif
+				const int id = (int)mBuffers.size() + 1;
+				std::ostringstream name;
+				name << threadName << " " << id;
+				TraceBuffer *buffer = new TraceBuffer(id, name.str(), mCapacity);
+				mBuffers.push_back (buffer);
+				return buffer;
+			}
+			/// Returns the number of thread buffers.
+			size_t getBufferCount () const
+			{
+				return mBuffers.size ();
+			}
+			/// Returns the specified thread buffer.
+			const TraceBuffer *getBuffer (size_t i) const
+			{
+				NoiseAssertRange (i, mBuffers.size());
+				return mBuffers[i];
+			}
+			/// Removes all events, the thread buffers stay valid.
+			/// Don't call this while jobs are executed.
+			void clear ()
+			{
+				for (size_t i=0;i<mBuffers.size();++i)
+					mBuffers[i]->clear ();
+			}
+			/// Writes the events in the Chrome trace event format, which can be loaded in chrome://tracing or Perfetto.
+			/// Don't call this while jobs are executed.
+			void writeChromeTrace (std::ostream &out) const
+			{
+				const std::ios_base::fmtflags flags = out.flags ();
+				const std::streamsize precision = out.precision (3);
+				out.setf (std::ios_base::fixed, std::ios_base::floatfield);
+				out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+				bool first = true;
+				for (size_t i=0;i<mBuffers.size();++i)
+				{
+					const TraceBuffer *buffer = mBuffers[i];
+					out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->getThreadID() << ",\"args\":{\"name\":";
+					writeString (out, buffer->getThreadName());
+					out << "}}";
+					first = false;
+					for (size_t j=0;j<buffer->getEventCount();++j)
+					{
+						const TraceEvent &e = buffer->getEvent (j);
+						out << ",\n{\"name\":";
+						writeString (out, e.name);
+						out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->getThreadID() << ",\"ts\":" << e.start << ",\"dur\":" << e.duration;
+						if (e.argName)
+						{
+							out << ",\"args\":{";
+							writeString (out, e.argName);
+							out << ":" << e.argValue << "}";
+						}
+						out << "}";
+					}
+				}
+				out << "\n]}\n";
+				out.flags (flags);
+				out.precision (precision);
+			}
+			/// Destructor.
+			~TraceRecorder ()
+			{
+				for (size_t i=0;i<mBuffers.size();++i)
+					delete mBuffers[i];
+			}
+	};
+};
+
+#endif
+
+#endif
@@ -0,0 +1,636 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEPP_TRANSFORMPOINT_H
+#define NOISEPP_TRANSFORMPOINT_H
+
+#include "NoisePipeline.h"
+#include "NoiseModule.h"
+
+namespace noisepp
+{
+	/// Affine 3x4 matrix for transforming input coordinates.
+	struct TransformMatrix
+	{
+		/// Matrix elements in row-major order. The fourth column holds the translation.
+		Real m[12];
+
+		/// Constructor. Initializes to identity.
+		TransformMatrix ()
+		{
+			setIdentity ();
+		}
+		/// Resets the matrix to identity.
+		void setIdentity ()
+		{
+			for (int i=0;i<12;++i)
+				m[i] = Real(0.0);
+			m[0] = m[5] = m[10] = Real(1.0);
+		}
+		/// Returns the element at the specified row and column.
+		Real get (int row, int col) const
+		{
+			NoiseAssertRange (row, 3);
+			NoiseAssertRange (col, 4);
+			return m[row*4+col];
+		}
+		/// Sets the element at the specified row and column.
+		void set (int row, int col, Real v)
+		{
+			NoiseAssertRange (row, 3);
+			NoiseAssertRange (col, 4);
+			m[row*4+col] = v;
+		}
+		/// Returns the concatenation of both transforms, the specified one is applied first.
+		TransformMatrix operator* (const TransformMatrix &t) const
+		{
+			TransformMatrix r;
+			for (int row=0;row<3;++row)
+			{
+				const Real *a = m + row*4;
+				for (int col=0;col<4;++col)
+				{
+					r.m[row*4+col] = a[0] * t.m[col] + a[1] * t.m[4+col] + a[2] * t.m[8+col];
+				}
+				r.m[row*4+3] += a[3];
+			}
+			return r;
+		}
+	};
+
+	class ScalePointElement1D : public PipelineElement1D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement1D *mElementPtr;
+			Real mScaleX;
+
+		public:
+			ScalePointElement1D (const Pipeline1D *pipe, ElementID element, Real scaleX) :
+				mElement(element), mScaleX(scaleX)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Real getValue (Real x, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x*mScaleX, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.scale (mScaleX), cache);
+			}
+
+	};
+
+	class ScalePointElement2D : public PipelineElement2D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement2D *mElementPtr;
+			Real mScaleX;
+			Real mScaleY;
+
+		public:
+			ScalePointElement2D (const Pipeline2D *pipe, ElementID element, Real scaleX, Real scaleY) :
+				mElement(element), mScaleX(scaleX), mScaleY(scaleY)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mElementPtr->getRegionRange (x * mScaleX, y * mScaleY);
+			}
+			virtual Real getValue (Real x, Real y, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x*mScaleX, y*mScaleY, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.scale (mScaleX), y.scale (mScaleY), cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x*mScaleX, y*mScaleY, dx, dy, cache);
+				dx *= mScaleX;
+				dy *= mScaleY;
+				return value;
+			}
+
+	};
+
+	class ScalePointElement3D : public PipelineElement3D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement3D *mElementPtr;
+			Real mScaleX;
+			Real mScaleY;
+			Real mScaleZ;
+
+		public:
+			ScalePointElement3D (const Pipeline3D *pipe, ElementID element, Real scaleX, Real scaleY, Real scaleZ) :
+				mElement(element), mScaleX(scaleX), mScaleY(scaleY), mScaleZ(scaleZ)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mElementPtr->getRegionRange (x * mScaleX, y * mScaleY, z * mScaleZ);
+			}
+			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x*mScaleX, y*mScaleY, z*mScaleZ, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.scale (mScaleX), y.scale (mScaleY), z.scale (mScaleZ), cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x*mScaleX, y*mScaleY, z*mScaleZ, dx, dy, dz, cache);
+				dx *= mScaleX;
+				dy *= mScaleY;
+				dz *= mScaleZ;
+				return value;
+			}
+
+	};
+
+	class TranslatePointElement1D : public PipelineElement1D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement1D *mElementPtr;
+			Real mTranslationX;
+
+		public:
+			TranslatePointElement1D (const Pipeline1D *pipe, ElementID element, Real TranslationX) :
+				mElement(element), mTranslationX(TranslationX)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Real getValue (Real x, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x+mTranslationX, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.translate (mTranslationX), cache);
+			}
+
+	};
+
+	class TranslatePointElement2D : public PipelineElement2D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement2D *mElementPtr;
+			Real mTranslationX;
+			Real mTranslationY;
+
+		public:
+			TranslatePointElement2D (const Pipeline2D *pipe, ElementID element, Real TranslationX, Real TranslationY) :
+				mElement(element), mTranslationX(TranslationX), mTranslationY(TranslationY)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mElementPtr->getRegionRange (x + mTranslationX, y + mTranslationY);
+			}
+			virtual Real getValue (Real x, Real y, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x+mTranslationX, y+mTranslationY, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.translate (mTranslationX), y.translate (mTranslationY), cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				return mElementPtr->getValueAndGradient (x+mTranslationX, y+mTranslationY, dx, dy, cache);
+			}
+
+	};
+
+	class TranslatePointElement3D : public PipelineElement3D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement3D *mElementPtr;
+			Real mTranslationX;
+			Real mTranslationY;
+			Real mTranslationZ;
+
+		public:
+			TranslatePointElement3D (const Pipeline3D *pipe, ElementID element, Real TranslationX, Real TranslationY, Real TranslationZ) :
+				mElement(element), mTranslationX(TranslationX), mTranslationY(TranslationY), mTranslationZ(TranslationZ)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mElementPtr->getRegionRange (x + mTranslationX, y + mTranslationY, z + mTranslationZ);
+			}
+			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x+mTranslationX, y+mTranslationY, z+mTranslationZ, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.translate (mTranslationX), y.translate (mTranslationY), z.translate (mTranslationZ), cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				return mElementPtr->getValueAndGradient (x+mTranslationX, y+mTranslationY, z+mTranslationZ, dx, dy, dz, cache);
+			}
+
+	};
+
+	class ScaleTranslatePointElement1D : public PipelineElement1D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement1D *mElementPtr;
+			Real mScaleX;
+			Real mTranslationX;
+
+		public:
+			ScaleTranslatePointElement1D (const Pipeline1D *pipe, ElementID element, Real scaleX, Real translationX) :
+				mElement(element), mScaleX(scaleX), mTranslationX(translationX)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Real getValue (Real x, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x*mScaleX+mTranslationX, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.scale (mScaleX).translate (mTranslationX), cache);
+			}
+
+	};
+
+	class ScaleTranslatePointElement2D : public PipelineElement2D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement2D *mElementPtr;
+			Real mScaleX, mScaleY;
+			Real mTranslationX, mTranslationY;
+
+		public:
+			ScaleTranslatePointElement2D (const Pipeline2D *pipe, ElementID element, Real scaleX, Real scaleY, Real translationX, Real translationY) :
+				mElement(element), mScaleX(scaleX), mScaleY(scaleY), mTranslationX(translationX), mTranslationY(translationY)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mElementPtr->getRegionRange (x * mScaleX + mTranslationX, y * mScaleY + mTranslationY);
+			}
+			virtual Real getValue (Real x, Real y, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x*mScaleX+mTranslationX, y*mScaleY+mTranslationY, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.scale (mScaleX).translate (mTranslationX), y.scale (mScaleY).translate (mTranslationY), cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x*mScaleX+mTranslationX, y*mScaleY+mTranslationY, dx, dy, cache);
+				dx *= mScaleX;
+				dy *= mScaleY;
+				return value;
+			}
+
+	};
+
+	class ScaleTranslatePointElement3D : public PipelineElement3D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement3D *mElementPtr;
+			Real mScaleX, mScaleY, mScaleZ;
+			Real mTranslationX, mTranslationY, mTranslationZ;
+
+		public:
+			ScaleTranslatePointElement3D (const Pipeline3D *pipe, ElementID element, Real scaleX, Real scaleY, Real scaleZ, Real translationX, Real translationY, Real translationZ) :
+				mElement(element), mScaleX(scaleX), mScaleY(scaleY), mScaleZ(scaleZ), mTranslationX(translationX), mTranslationY(translationY), mTranslationZ(translationZ)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				return mElementPtr->getRegionRange (x * mScaleX + mTranslationX, y * mScaleY + mTranslationY, z * mScaleZ + mTranslationZ);
+			}
+			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
+			{
+				return getElementValue (mElementPtr, mElement, x*mScaleX+mTranslationX, y*mScaleY+mTranslationY, z*mScaleZ+mTranslationZ, cache);
+			}
+			virtual Real getWorldValue (const WorldCoord &x, const WorldCoord &y, const WorldCoord &z, Cache *cache) const
+			{
+				return mElementPtr->getWorldValue (x.scale (mScaleX).translate (mTranslationX), y.scale (mScaleY).translate (mTranslationY), z.scale (mScaleZ).translate (mTranslationZ), cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				const Real value = mElementPtr->getValueAndGradient (x*mScaleX+mTranslationX, y*mScaleY+mTranslationY, z*mScaleZ+mTranslationZ, dx, dy, dz, cache);
+				dx *= mScaleX;
+				dy *= mScaleY;
+				dz *= mScaleZ;
+				return value;
+			}
+
+	};
+
+	class TransformPointElement2D : public PipelineElement2D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement2D *mElementPtr;
+			Real mXX, mXY, mXT;
+			Real mYX, mYY, mYT;
+
+		public:
+			TransformPointElement2D (const Pipeline2D *pipe, ElementID element, const TransformMatrix &matrix) :
+				mElement(element),
+				mXX(matrix.m[0]), mXY(matrix.m[1]), mXT(matrix.m[3]),
+				mYX(matrix.m[4]), mYY(matrix.m[5]), mYT(matrix.m[7])
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				return mElementPtr->getRegionRange (x * mXX + y * mXY + mXT, x * mYX + y * mYY + mYT);
+			}
+			virtual Real getValue (Real x, Real y, Cache *cache) const
+			{
+				const Real nx = x * mXX + y * mXY + mXT;
+				const Real ny = x * mYX + y * mYY + mYT;
+				return getElementValue (mElementPtr, mElement, nx, ny, cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real &dx, Real &dy, Cache *cache) const
+			{
+				const Real nx = x * mXX + y * mXY + mXT;
+				const Real ny = x * mYX + y * mYY + mYT;
+				Real ndx, ndy;
+				const Real value = mElementPtr->getValueAndGradient (nx, ny, ndx, ndy, cache);
+				// the gradient is transformed with the transposed matrix
+				dx = ndx * mXX + ndy * mYX;
+				dy = ndx * mXY + ndy * mYY;
+				return value;
+			}
+
+	};
+
+	class TransformPointElement3D : public PipelineElement3D
+	{
+		private:
+			ElementID mElement;
+			const PipelineElement3D *mElementPtr;
+			TransformMatrix mMatrix;
+
+		public:
+			TransformPointElement3D (const Pipeline3D *pipe, ElementID element, const TransformMatrix &matrix) :
+				mElement(element), mMatrix(matrix)
+			{
+				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
+			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				const Real *m = mMatrix.m;
+				return mElementPtr->getRegionRange (
+					x * m[0] + y * m[1] + z * m[2] + m[3],
+					x * m[4] + y * m[5] + z * m[6] + m[7],
+					x * m[8] + y * m[9] + z * m[10] + m[11]);
+			}
+			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
+			{
+				const Real *m = mMatrix.m;
+				const Real nx = x * m[0] + y * m[1] + z * m[2] + m[3];
+				const Real ny = x * m[4] + y * m[5] + z * m[6] + m[7];
+				const Real nz = x * m[8] + y * m[9] + z * m[10] + m[11];
+				return getElementValue (mElementPtr, mElement, nx, ny, nz, cache);
+			}
+			virtual Real getValueAndGradient (Real x, Real y, Real z, Real &dx, Real &dy, Real &dz, Cache *cache) const
+			{
+				const Real *m = mMatrix.m;
+				const Real nx = x * m[0] + y * m[1] + z * m[2] + m[3];
+				const Real ny = x * m[4] + y * m[5] + z * m[6] + m[7];
+				const Real nz = x * m[8] + y * m[9] + z * m[10] + m[11];
+				Real ndx, ndy, ndz;
+				const Real value = mElementPtr->getValueAndGradient (nx, ny, nz, ndx, ndy, ndz, cache);
+				// the gradient is transformed with the transposed matrix
+				dx = ndx * m[0] + ndy * m[4] + ndz * m[8];
+				dy = ndx * m[1] + ndy * m[5] + ndz * m[9];
+				dz = ndx * m[2] + ndy * m[6] + ndz * m[10];
+				return value;
+			}
+
+	};
+
+	/** Base class for modules transforming the input coordinates.
+		When added to a pipeline, chains of adjacent transform modules are folded into a single
+		matrix and compiled down to the cheapest element able to represent it.
+		An identity transform adds no element at all.
+	*/
+	class PointTransformModule : public Module
+	{
+		private:
+			static bool isPointTransform (const Module *module)
+			{
+				const ModuleTypeId type = module->getType();
+				return (type == MODULE_SCALEPOINT || type == MODULE_TRANSLATEPOINT || type == MODULE_TRANSFORMPOINT);
+			}
+			/// Concatenates the transforms of this and all adjacent source transform modules.
+			/// Returns the first source module which is not a transform module.
+			const Module *foldTransforms (TransformMatrix &matrix) const
+			{
+				getTransform (matrix);
+				const Module *source = getSourceModule(0);
+				while (isPointTransform(source))
+				{
+					const PointTransformModule *transformModule = static_cast<const PointTransformModule*>(source);
+					TransformMatrix inner;
+					transformModule->getTransform (inner);
+					matrix = inner * matrix;
+					source = transformModule->getSourceModule(0);
+					if (!source)
+						NoiseThrowNoModuleException;
+				}
+				return source;
+			}
+
+		public:
+			/// Constructor.
+			PointTransformModule() : Module(1)
+			{
+			}
+			/// Returns the transform applied to the input coordinates.
+			virtual void getTransform (TransformMatrix &matrix) const = 0;
+			/// @copydoc noisepp::Module::addToPipeline()
+			virtual ElementID addToPipeline (Pipeline1D *pipe) const
+			{
+				NoiseModuleCheckSourceModules;
+				TransformMatrix t;
+				ElementID first = pipe->addSource(foldTransforms(t));
+				const Real *m = t.m;
+				const bool scaled = (m[0] != Real(1.0));
+				const bool translated = (m[3] != Real(0.0));
+				if (!scaled && !translated)
+					return pipe->addAlias (this, first);
+				else if (!translated)
+					return pipe->addElement (this, new ScalePointElement1D(pipe, first, m[0]));
+				else if (!scaled)
+					return pipe->addElement (this, new TranslatePointElement1D(pipe, first, m[3]));
+				return pipe->addElement (this, new ScaleTranslatePointElement1D(pipe, first, m[0], m[3]));
+			}
+			/// @copydoc noisepp::Module::addToPipeline()
+			virtual ElementID addToPipeline (Pipeline2D *pipe) const
+			{
+				NoiseModuleCheckSourceModules;
+				TransformMatrix t;
+				ElementID first = pipe->addSource(foldTransforms(t));
+				const Real *m = t.m;
+				if (m[1] != Real(0.0) || m[4] != Real(0.0))
+					return pipe->addElement (this, new TransformPointElement2D(pipe, first, t));
+				const bool scaled = (m[0] != Real(1.0) || m[5] != Real(1.0));
+				const bool translated = (m[3] != Real(0.0) || m[7] != Real(0.0));
+				if (!scaled && !translated)
+					return pipe->addAlias (this, first);
+				else if (!translated)
+					return pipe->addElement (this, new ScalePointElement2D(pipe, first, m[0], m[5]));
+				else if (!scaled)
+					return pipe->addElement (this, new TranslatePointElement2D(pipe, first, m[3], m[7]));
+				return pipe->addElement (this, new ScaleTranslatePointElement2D(pipe, first, m[0], m[5], m[3], m[7]));
+			}
+			/// @copydoc noisepp::Module::addToPipeline()
+			virtual ElementID addToPipeline (Pipeline3D *pipe) const
+			{
+				NoiseModuleCheckSourceModules;
+				TransformMatrix t;
+				ElementID first = pipe->addSource(foldTransforms(t));
+				const Real *m = t.m;
+				if (m[1] != Real(0.0) || m[2] != Real(0.0) || m[4] != Real(0.0) || m[6] != Real(0.0) || m[8] != Real(0.0) || m[9] != Real(0.0))
+					return pipe->addElement (this, new TransformPointElement3D(pipe, first, t));
+				const bool scaled = (m[0] != Real(1.0) || m[5] != Real(1.0) || m[10] != Real(1.0));
+				const bool translated = (m[3] != Real(0.0) || m[7] != Real(0.0) || m[11] != Real(0.0));
+				if (!scaled && !translated)
+					return pipe->addAlias (this, first);
+				else if (!translated)
+					return pipe->addElement (this, new ScalePointElement3D(pipe, first, m[0], m[5], m[10]));
+				else if (!scaled)
+					return pipe->addElement (this, new TranslatePointElement3D(pipe, first, m[3], m[7], m[11]));
+				return pipe->addElement (this, new ScaleTranslatePointElement3D(pipe, first, m[0], m[5], m[10], m[3], m[7], m[11]));
+			}
+	};
+
+	/** Transform module using an arbitrary affine matrix.
+		Transforms the source module by multiplying the coordinates with a 3x4 matrix.
+		For 2D and 1D pipelines the missing coordinates are treated as zero.
+	*/
+	class TransformPointModule : public PointTransformModule
+	{
+		private:
+			TransformMatrix mMatrix;
+
+		public:
+			/// Sets the transform matrix.
+			void setMatrix (const TransformMatrix &matrix)
+			{
+				mMatrix = matrix;
+			}
+			/// Returns the transform matrix.
+			const TransformMatrix &getMatrix () const
+			{
+				return mMatrix;
+			}
+			/// Resets the transform matrix to identity.
+			void setIdentity ()
+			{
+				mMatrix.setIdentity ();
+			}
+			/// Sets the rotation part of the matrix.
+			/// The rotation is compatible to the libnoise RotatePoint module.
+			/// @param xAngle The rotation angle around the x axis in degrees.
+			/// @param yAngle The rotation angle around the y axis in degrees.
+			/// @param zAngle The rotation angle around the z axis in degrees.
+			void setRotation (Real xAngle, Real yAngle, Real zAngle)
+			{
+				const Real DEG_TO_RAD = Real(3.14159265358979323846 / 180.0);
+				const Real xCos = std::cos(xAngle * DEG_TO_RAD);
+				const Real yCos = std::cos(yAngle * DEG_TO_RAD);
+				const Real zCos = std::cos(zAngle * DEG_TO_RAD);
+				const Real xSin = std::sin(xAngle * DEG_TO_RAD);
+				const Real ySin = std::sin(yAngle * DEG_TO_RAD);
+				const Real zSin = std::sin(zAngle * DEG_TO_RAD);
+				Real *m = mMatrix.m;
+				m[0] = ySin * xSin * zSin + yCos * zCos;
+				m[1] = xCos * zSin;
+				m[2] = ySin * zCos - yCos * xSin * zSin;
+				m[4] = ySin * xSin * zCos - yCos * zSin;
+				m[5] = xCos * zCos;
+				m[6] = -yCos * xSin * zCos - ySin * zSin;
+				m[8] = -ySin * xCos;
+				m[9] = xSin;
+				m[10] = yCos * xCos;
+			}
+			/// Sets the translation part of the matrix.
+			void setTranslation (Real x, Real y, Real z)
+			{
+				mMatrix.m[3] = x;
+				mMatrix.m[7] = y;
+				mMatrix.m[11] = z;
+			}
+			/// @copydoc noisepp::PointTransformModule::getTransform()
+			virtual void getTransform (TransformMatrix &matrix) const
+			{
+				matrix = mMatrix;
+			}
+			/// @copydoc noisepp::Module::getType()
+			ModuleTypeId getType() const { return MODULE_TRANSFORMPOINT; }
+#if NOISEPP_ENABLE_UTILS
+			/// @copydoc noisepp::Module::write()
+			virtual void write (utils::OutStream &stream) const;
+			/// @copydoc noisepp::Module::read()
+			virtual void read (utils::InStream &stream);
+#endif
+	};
+};
+
+#endif // NOISEPP_TRANSFORMPOINT_H
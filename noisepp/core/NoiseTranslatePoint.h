@@ -1,75 +1,14 @@
 #ifndef NOISEPP_TRANSLATEPOINT_H
 #define NOISEPP_TRANSLATEPOINT_H
 
+#include "NoiseTransformPoint.h"
+
 namespace noisepp
 {
-	class TranslatePointElement1D : public PipelineElement1D
-	{
-		private:
-			ElementID mElement;
-			const PipelineElement1D *mElementPtr;
-			Real mTranslationX;
-
-		public:
-			TranslatePointElement1D (const Pipeline1D *pipe, ElementID element, Real TranslationX) :
-				mElement(element), mTranslationX(TranslationX)
-			{
-				mElementPtr = pipe->getElement (mElement);
-			}
-			virtual Real getValue (Real x, Cache *cache) const
-			{
-				return getElementValue (mElementPtr, mElement, x+mTranslationX, cache);
-			}
-
-	};
-
-	class TranslatePointElement2D : public PipelineElement2D
-	{
-		private:
-			ElementID mElement;
-			const PipelineElement2D *mElementPtr;
-			Real mTranslationX;
-			Real mTranslationY;
-
-		public:
-			TranslatePointElement2D (const Pipeline2D *pipe, ElementID element, Real TranslationX, Real TranslationY) :
-				mElement(element), mTranslationX(TranslationX), mTranslationY(TranslationY)
-			{
-				mElementPtr = pipe->getElement (mElement);
-			}
-			virtual Real getValue (Real x, Real y, Cache *cache) const
-			{
-				return getElementValue (mElementPtr, mElement, x+mTranslationX, y+mTranslationY, cache);
-			}
-
-	};
-
-	class TranslatePointElement3D : public PipelineElement3D
-	{
-		private:
-			ElementID mElement;
-			const PipelineElement3D *mElementPtr;
-			Real mTranslationX;
-			Real mTranslationY;
-			Real mTranslationZ;
-
-		public:
-			TranslatePointElement3D (const Pipeline3D *pipe, ElementID element, Real TranslationX, Real TranslationY, Real TranslationZ) :
-				mElement(element), mTranslationX(TranslationX), mTranslationY(TranslationY), mTranslationZ(TranslationZ)
-			{
-				mElementPtr = pipe->getElement (mElement);
-			}
-			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
-			{
-				return getElementValue (mElementPtr, mElement, x+mTranslationX, y+mTranslationY, z+mTranslationZ, cache);
-			}
-
-	};
-
 	/** Transform module for translating.
 		Transforms the source module by translating the coordinates.
 	*/
-	class TranslatePointModule : public Module
+	class TranslatePointModule : public PointTransformModule
 	{
 		private:
 			Real mTranslationX;
@@ -78,7 +17,7 @@ namespace noisepp
 
 		public:
 			/// Constructor.
-			TranslatePointModule() : Module(1), mTranslationX(0.0), mTranslationY(0.0), mTranslationZ(0.0)
+			TranslatePointModule() : mTranslationX(0.0), mTranslationY(0.0), mTranslationZ(0.0)
 			{
 			}
 			/// Sets the translation applied to the x coordintate.
@@ -111,26 +50,13 @@ namespace noisepp
 			{
 				return mTranslationZ;
 			}
-			/// @copydoc noisepp::Module::addToPipeline()
-			virtual ElementID addToPipeline (Pipeline1D *pipe) const
-			{
-				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				return pipe->addElement (this, new TranslatePointElement1D(pipe, first, mTranslationX));
-			}
-			/// @copydoc noisepp::Module::addToPipeline()
-			virtual ElementID addToPipeline (Pipeline2D *pipe) const
-			{
-				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				return pipe->addElement (this, new TranslatePointElement2D(pipe, first, mTranslationX, mTranslationY));
-			}
-			/// @copydoc noisepp::Module::addToPipeline()
-			virtual ElementID addToPipeline (Pipeline3D *pipe) const
+			/// @copydoc noisepp::PointTransformModule::getTransform()
+			virtual void getTransform (TransformMatrix &matrix) const
 			{
-				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
-				return pipe->addElement (this, new TranslatePointElement3D(pipe, first, mTranslationX, mTranslationY, mTranslationZ));
+				matrix.setIdentity ();
+				matrix.m[3] = mTranslationX;
+				matrix.m[7] = mTranslationY;
+				matrix.m[11] = mTranslationZ;
 			}
 			/// @copydoc noisepp::Module::getType()
 			ModuleTypeId getType() const { return MODULE_TRANSLATEPOINT; }
@@ -44,6 +44,7 @@ namespace noisepp
 				mPower(power), mElement(element), mPerlinX(perlinX)
 			{
 				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
 				mPerlinXPtr = pipe->getElement (mPerlinX);
 			}
 			virtual Real getValue (Real x, Cache *cache) const
@@ -72,9 +73,16 @@ namespace noisepp
 				mPower(power), mElement(element), mPerlinX(perlinX), mPerlinY(perlinY)
 			{
 				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
 				mPerlinXPtr = pipe->getElement (mPerlinX);
 				mPerlinYPtr = pipe->getElement (mPerlinY);
 			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y) const
+			{
+				const Interval xFinal = x + mPerlinXPtr->getRegionRange (x + Real(12414.0 / 65536.0), y + Real(65124.0 / 65536.0)) * mPower;
+				const Interval yFinal = y + mPerlinYPtr->getRegionRange (x + Real(26519.0 / 65536.0), y + Real(18128.0 / 65536.0)) * mPower;
+				return mElementPtr->getRegionRange (xFinal, yFinal);
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				Real x0, y0;
@@ -108,10 +116,18 @@ namespace noisepp
 				mPower(power), mElement(element), mPerlinX(perlinX), mPerlinY(perlinY), mPerlinZ(perlinZ)
 			{
 				mElementPtr = pipe->getElement (mElement);
+				mRange = mElementPtr->getRange ();
 				mPerlinXPtr = pipe->getElement (mPerlinX);
 				mPerlinYPtr = pipe->getElement (mPerlinY);
 				mPerlinZPtr = pipe->getElement (mPerlinZ);
 			}
+			virtual Interval getRegionRange (const Interval &x, const Interval &y, const Interval &z) const
+			{
+				const Interval xFinal = x + mPerlinXPtr->getRegionRange (x + Real(12414.0 / 65536.0), y + Real(65124.0 / 65536.0), z + Real(31337.0 / 65536.0)) * mPower;
+				const Interval yFinal = y + mPerlinYPtr->getRegionRange (x + Real(26519.0 / 65536.0), y + Real(18128.0 / 65536.0), z + Real(60493.0 / 65536.0)) * mPower;
+				const Interval zFinal = z + mPerlinZPtr->getRegionRange (x + Real(53820.0 / 65536.0), y + Real(11213.0 / 65536.0), z + Real(44845.0 / 65536.0)) * mPower;
+				return mElementPtr->getRegionRange (xFinal, yFinal, zFinal);
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				Real x0, y0, z0;
@@ -214,7 +230,7 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline1D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				ElementID perlinX = mPerlinX.addToPipeline(pipe);
 				return pipe->addElement (this, new TurbulenceElement1D(pipe, mPower, first, perlinX));
 			}
@@ -222,7 +238,7 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline2D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				ElementID perlinX = mPerlinX.addToPipeline(pipe);
 				ElementID perlinY = mPerlinY.addToPipeline(pipe);
 				return pipe->addElement (this, new TurbulenceElement2D(pipe, mPower, first, perlinX, perlinY));
@@ -231,7 +247,7 @@ namespace noisepp
 			virtual ElementID addToPipeline (Pipeline3D *pipe) const
 			{
 				NoiseModuleCheckSourceModules;
-				ElementID first = getSourceModule(0)->addToPipeline(pipe);
+				ElementID first = pipe->addSource(getSourceModule(0));
 				ElementID perlinX = mPerlinX.addToPipeline(pipe);
 				ElementID perlinY = mPerlinY.addToPipeline(pipe);
 				ElementID perlinZ = mPerlinZ.addToPipeline(pipe);
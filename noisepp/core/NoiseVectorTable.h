@@ -287,7 +287,7 @@ namespace noisepp
 		-0.884902f, 0.465777f, 0.0f, 0.0f,
 		-0.648342f, -0.761349f, 0.0f, 0.0f
 	};
-	const Real randomVectors3D[256 * 4] =
+	const KernelReal randomVectors3D[256 * 4] =
 	{
 		-0.763874f, -0.596439f, -0.246489f, 0.0f,
 		0.396055f, 0.904518f, -0.158073f, 0.0f,
@@ -546,7 +546,7 @@ namespace noisepp
 		0.991353f, 0.112814f, 0.0670273f, 0.0f,
 		0.0337884f, -0.979891f, -0.196654f, 0.0f
 	};
-	const Real gradientVector[256] = {
+	const KernelReal gradientVector[256] = {
 		-0.0960784f,
         -0.42f,
         -0.639608f,
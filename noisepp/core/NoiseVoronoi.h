@@ -45,6 +45,10 @@ namespace noisepp
 			VoronoiElement2D (Real frequency, int seed, Real displacement, bool enableDistance) : mFrequency(frequency), mSeed(seed), mDisplacement(displacement), mEnableDistance(enableDistance)
 			{
 			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Cache *cache) const
 			{
 				x *= mFrequency;
@@ -104,6 +108,10 @@ namespace noisepp
 			VoronoiElement3D (Real frequency, int seed, Real displacement, bool enableDistance) : mFrequency(frequency), mSeed(seed), mDisplacement(displacement), mEnableDistance(enableDistance)
 			{
 			}
+			virtual bool checkColumnar () const
+			{
+				return true;
+			}
 			virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
 			{
 				x *= mFrequency;
@@ -0,0 +1,120 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEPP_WORLDCOORD_H
+#define NOISEPP_WORLDCOORD_H
+
+#include "NoisePrerequisites.h"
+
+namespace noisepp
+{
+	/** Coordinate for big worlds.
+		Splits a position into an integer cell and a local offset, so positions far away from the origin keep
+		their precision where a single Real would have run out of mantissa bits.
+		The gradient generators consume the integer part directly when hashing lattice points,
+		the per-sample path has no fmod() and no range folding.
+	*/
+	struct WorldCoord
+	{
+		/// Integer part of the coordinate.
+		int cell;
+		/// Offset from the cell, usually the local position inside a chunk.
+		Real offset;
+
+		/// Constructor for the origin.
+		WorldCoord () : cell(0), offset(0)
+		{
+		}
+		/// Constructor.
+		WorldCoord (int c, Real o) : cell(c), offset(o)
+		{
+		}
+		/// Creates a world coordinate from a double precision position.
+		static WorldCoord fromDouble (double v)
+		{
+			const double f = std::floor (v);
+			return WorldCoord (int(f), Real(v - f));
+		}
+		/// Returns the position in double precision.
+		double toDouble () const
+		{
+			return double(cell) + double(offset);
+		}
+		/// Returns the position in Real precision, which is only exact near the origin.
+		Real toReal () const
+		{
+			return Real(toDouble ());
+		}
+		/// Returns the coordinate moved by the specified local delta.
+		WorldCoord operator+ (Real delta) const
+		{
+			return WorldCoord (cell, offset + delta);
+		}
+		/// Returns the coordinate moved by the specified distance, the whole part of the distance moves the cell.
+		WorldCoord translate (Real distance) const
+		{
+			const double f = std::floor (double(distance));
+			return WorldCoord (cell + int(f), offset + Real(double(distance) - f));
+		}
+		/// Returns the coordinate multiplied by the specified factor.
+		/// The cell is multiplied in double and split again, the whole part of the product must fit into an int.
+		WorldCoord scale (Real factor) const
+		{
+			const double p = double(cell) * double(factor);
+			const double f = std::floor (p);
+			return WorldCoord (int(f), Real((p - f) + double(offset) * double(factor)));
+		}
+		/// Returns the lattice cell of the position multiplied by frequency, the offset inside that cell
+		/// and the offset to the next cell, both calculated in double before narrowing.
+		/// The integer part of the scaled cell wraps around modulo 2^32 instead of losing precision,
+		/// frequency must be less than 2^31.
+		/// In double builds this matches the plain Real path bit for bit only for whole-number frequencies and
+		/// positions where cell + offset is exact in double. A fractional frequency scales the cell in a separate
+		/// step, which rounds differently from getValue() in the last bits, the differences grow with the cell.
+		NOISEPP_INLINE void getLattice (Real frequency, int &latticeCell, KernelReal &latticeOffset, KernelReal &latticeOffset1) const
+		{
+			const double f = double(frequency);
+			const int fi = int(f);
+			const double ff = f - double(fi);
+			int pi = 0;
+			double t = double(offset) * f;
+			// the fractional part of the frequency is constant per octave, whole frequencies skip the split
+			if (ff != 0.0)
+			{
+				const double p = double(cell) * ff;
+				pi = int(p);
+				pi -= (p < double(pi));
+				t += p - double(pi);
+			}
+			int ti = int(t);
+			ti -= (t < double(ti));
+			latticeCell = int(unsigned(cell) * unsigned(fi) + unsigned(pi) + unsigned(ti));
+			latticeOffset = KernelReal(t - double(ti));
+			latticeOffset1 = KernelReal(t - double(ti) - 1.0);
+		}
+	};
+};
+
+#endif // NOISEPP_WORLDCOORD_H
@@ -0,0 +1,201 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseBatchReader.h"
+#include "NoiseSystem.h"
+#include <fstream>
+
+namespace noisepp
+{
+namespace utils
+{
+
+BatchReader::BatchReader ()
+{
+}
+
+size_t BatchReader::addFile (const std::string &filename)
+{
+	Entry entry;
+	entry.filename = filename;
+	entry.buffer = 0;
+	entry.size = 0;
+	entry.reader = 0;
+	mEntries.push_back (entry);
+	return mEntries.size() - 1;
+}
+
+size_t BatchReader::addBuffer (char *buffer, size_t size)
+{
+	NoiseAssert (buffer != NULL, buffer);
+	Entry entry;
+	entry.buffer = buffer;
+	entry.size = size;
+	entry.reader = 0;
+	mEntries.push_back (entry);
+	return mEntries.size() - 1;
+}
+
+size_t BatchReader::read (JobQueue *jobQueue)
+{
+	if (!jobQueue)
+		jobQueue = System::createOptimalJobQueue();
+	// the pipelines added since the last call
+	size_t begin = 0;
+	while (begin < mEntries.size() && (mEntries[begin].reader || !mEntries[begin].error.empty()))
+		++begin;
+	const size_t count = mEntries.size() - begin;
+	if (count > 0)
+	{
+		// a few groups per core balance the load without paying the queue overhead per file
+		size_t groups = size_t(System::getNumberOfCPUs()) * 4;
+		if (groups > count)
+			groups = count;
+		for (size_t i=0;i<groups;++i)
+		{
+			const size_t first = begin + count * i / groups;
+			const size_t last = begin + count * (i+1) / groups;
+			ModuleArena *arena = new ModuleArena;
+			mArenas.push_back (arena);
+			jobQueue->addJob (new BatchReaderJob(&mEntries[first], last - first, arena));
+		}
+	}
+	jobQueue->executeJobs();
+	delete jobQueue;
+	jobQueue = 0;
+
+	size_t failed = 0;
+	for (EntryVector::iterator it=mEntries.begin();it!=mEntries.end();++it)
+	{
+		// added buffers are only valid during the call
+		it->buffer = 0;
+		it->size = 0;
+		if (!it->reader)
+			++failed;
+	}
+	return failed;
+}
+
+size_t BatchReader::getPipelineCount () const
+{
+	return mEntries.size();
+}
+
+Module *BatchReader::getModule (size_t index, unsigned short id) const
+{
+	NoiseAssertRange (index, mEntries.size());
+	const Entry &entry = mEntries[index];
+	if (!entry.reader)
+		return NULL;
+	return entry.reader->getModule (id);
+}
+
+const std::string &BatchReader::getError (size_t index) const
+{
+	NoiseAssertRange (index, mEntries.size());
+	return mEntries[index].error;
+}
+
+void BatchReader::clear ()
+{
+	for (EntryVector::iterator it=mEntries.begin();it!=mEntries.end();++it)
+	{
+		delete it->reader;
+	}
+	mEntries.clear ();
+	for (ArenaVector::iterator it=mArenas.begin();it!=mArenas.end();++it)
+	{
+		delete *it;
+	}
+	mArenas.clear ();
+}
+
+BatchReader::~BatchReader ()
+{
+	clear ();
+}
+
+BatchReader::BatchReaderJob::BatchReaderJob (Entry *entries, size_t count, ModuleArena *arena) : entries(entries), count(count), arena(arena)
+{
+	assert (entries);
+	assert (arena);
+}
+
+void BatchReader::BatchReaderJob::execute ()
+{
+	for (size_t i=0;i<count;++i)
+	{
+		read (entries[i]);
+	}
+}
+
+void BatchReader::BatchReaderJob::read (Entry &entry)
+{
+	std::vector<char> data;
+	char *buffer = entry.buffer;
+	size_t size = entry.size;
+	if (!buffer)
+	{
+		// the whole file in a single read
+		std::ifstream file (entry.filename.c_str(), std::ios::binary);
+		if (!file.is_open ())
+		{
+			entry.error = "Can't open file";
+			return;
+		}
+		file.seekg (0, std::ios::end);
+		const std::streamoff length = file.tellg ();
+		file.seekg (0, std::ios::beg);
+		if (length <= 0)
+		{
+			entry.error = "Empty file";
+			return;
+		}
+		data.resize (size_t(length));
+		file.read (&data[0], length);
+		if (!file)
+		{
+			entry.error = "Unexpected EOF";
+			return;
+		}
+		buffer = &data[0];
+		size = data.size();
+	}
+
+	try
+	{
+		MemoryInStream stream;
+		stream.open (buffer, size);
+		entry.reader = new Reader (stream, arena);
+	}
+	catch (std::exception &e)
+	{
+		// modules of a broken file stay in the arena until it's cleared
+		entry.error = e.what ();
+	}
+}
+
+};
+};
@@ -0,0 +1,105 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEBATCHREADER_H
+#define NOISEBATCHREADER_H
+
+#include <string>
+#include <vector>
+
+#include "NoiseReader.h"
+#include "NoiseModuleArena.h"
+#include "NoiseJobQueue.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Class for reading many pipelines at once.
+/// The pipelines are split into a few groups per CPU core which are loaded in parallel on a JobQueue.
+/// Each file is read with a single read() call and the modules of a group are constructed in one arena,
+/// so loading causes few allocations and clear() doesn't free every module on its own.
+class BatchReader
+{
+	public:
+		/// Constructor.
+		BatchReader ();
+		/// Adds a file and returns its index.
+		size_t addFile (const std::string &filename);
+		/// Adds a buffer holding a pipeline and returns its index.
+		/// The buffer isn't copied and has to stay valid until read() returns.
+		size_t addBuffer (char *buffer, size_t size);
+		/// Loads all added pipelines which aren't loaded yet.
+		/// Returns the number of pipelines that couldn't be loaded, see getError().
+		/// @param jobQueue A pointer to a JobQueue. The JobQueue will be deleted after usage. Passing NULL will use an system optimal queue.
+		size_t read (JobQueue *jobQueue=0);
+		/// Returns the number of added pipelines.
+		size_t getPipelineCount () const;
+		/// Returns a pointer to the module with the specified ID of a loaded pipeline or NULL if it does not exist.
+		Module *getModule (size_t index, unsigned short id=0) const;
+		/// Returns the error message of a pipeline that couldn't be loaded, or an empty string.
+		const std::string &getError (size_t index) const;
+		/// Releases all pipelines.
+		void clear ();
+		/// Destructor.
+		~BatchReader ();
+	protected:
+	private:
+		struct Entry
+		{
+			std::string filename;
+			char *buffer;
+			size_t size;
+			Reader *reader;
+			std::string error;
+		};
+		typedef std::vector<Entry> EntryVector;
+		EntryVector mEntries;
+		typedef std::vector<ModuleArena*> ArenaVector;
+		ArenaVector mArenas;
+
+		class BatchReaderJob : public Job
+		{
+			private:
+				Entry *entries;
+				size_t count;
+				ModuleArena *arena;
+
+				void read (Entry &entry);
+
+			public:
+				BatchReaderJob (Entry *entries, size_t count, ModuleArena *arena);
+				void execute ();
+		};
+
+		BatchReader (const BatchReader &);
+		BatchReader &operator= (const BatchReader &);
+};
+
+};
+};
+
+#endif // NOISEBATCHREADER_H
@@ -33,7 +33,7 @@ namespace noisepp
 namespace utils
 {
 
-Builder::Builder () : mDest(0), mWidth(0), mHeight(0), mModule(0), mCallback(0)
+Builder::Builder () : mDest(0), mWidth(0), mHeight(0), mModule(0), mMappedFile(0), mCallback(0)
 {
 }
 
@@ -43,9 +43,32 @@ void Builder::setSize (int width, int height)
 	mHeight = height;
 }
 
+int Builder::getWidth () const
+{
+	return mWidth;
+}
+
+int Builder::getHeight () const
+{
+	return mHeight;
+}
+
+Real *Builder::getDestination () const
+{
+	return mDest;
+}
+
 void Builder::setDestination (Real *dest)
 {
 	mDest = dest;
+	mMappedFile = 0;
+}
+
+void Builder::setDestination (MappedFile &file)
+{
+	NoiseAssert(file.isOpen(), file);
+	mDest = file.getData ();
+	mMappedFile = &file;
 }
 
 void Builder::setModule (Module *module)
@@ -53,11 +76,22 @@ void Builder::setModule (Module *module)
 	mModule = module;
 }
 
+Module *Builder::getModule () const
+{
+	return mModule;
+}
+
 void Builder::checkParameters ()
 {
 	NoiseAssert(mDest != NULL, mDest);
 	NoiseAssert(mWidth > 0, mWidth);
 	NoiseAssert(mHeight > 0, mHeight);
+	if (mMappedFile)
+	{
+		NoiseAssert(mMappedFile->getData() == mDest, mMappedFile);
+		NoiseAssert(mMappedFile->getWidth() == mWidth, mWidth);
+		NoiseAssert(mMappedFile->getHeight() == mHeight, mHeight);
+	}
 }
 
 void Builder::setCallback (BuilderCallback *callback)
@@ -79,13 +113,63 @@ Builder::~Builder ()
 class ProgressLineJob2D : public LineJob2D
 {
 	private:
+		Real *buffer;
+		int n;
+		MappedFile *file;
 		BuilderCallback *callback;
 
 	public:
-		ProgressLineJob2D (Pipeline2D *pipe, PipelineElement2D *element, Real x, Real y, int n, Real xDelta, Real *buffer, BuilderCallback *callback) : LineJob2D(pipe, element, x, y, n, xDelta, buffer), callback(callback)
+		ProgressLineJob2D (Pipeline2D *pipe, PipelineElement2D *element, Real x, Real y, int n, Real xDelta, Real *buffer, MappedFile *file, BuilderCallback *callback) :
+			LineJob2D(pipe, element, x, y, n, xDelta, buffer), buffer(buffer), n(n), file(file), callback(callback)
 		{}
 		void finish ()
 		{
+			if (file)
+			{
+				file->flush (buffer, n);
+			}
+			if (callback)
+			{
+				callback->callback ();
+			}
+		}
+};
+
+class GradientLineJob2D : public PipelineJob
+{
+	private:
+		Pipeline2D *mPipe;
+		PipelineElement2D *mElement;
+		Real x, y;
+		int n;
+		Real xDelta;
+		Real *buffer;
+		Real *gradientX, *gradientY;
+		MappedFile *file;
+		BuilderCallback *callback;
+
+	public:
+		GradientLineJob2D (Pipeline2D *pipe, PipelineElement2D *element, Real x, Real y, int n, Real xDelta, Real *buffer, Real *gradientX, Real *gradientY, MappedFile *file, BuilderCallback *callback) :
+			mPipe(pipe), mElement(element), x(x), y(y), n(n), xDelta(xDelta), buffer(buffer), gradientX(gradientX), gradientY(gradientY), file(file), callback(callback)
+		{
+		}
+		void execute (Cache *cache)
+		{
+			// cleans the cache
+			mPipe->cleanCache (cache);
+			for (int i=0;i<n;++i)
+			{
+				buffer[i] = mElement->getValueAndGradient(x, y, gradientX[i], gradientY[i], cache);
+				// move on
+				x += xDelta;
+			}
+		}
+		void finish ()
+		{
+			if (file)
+			{
+				file->flush (buffer, n);
+			}
 			if (callback)
 			{
 				callback->callback ();
@@ -104,11 +188,12 @@ class SeamlessPlaneLineJob2D : public PipelineJob
 		Real xExtent, yExtent;
 		Real yBlend;
 		Real *buffer;
+		MappedFile *file;
 		BuilderCallback *callback;
 
 	public:
-		SeamlessPlaneLineJob2D (Pipeline2D *pipe, PipelineElement2D *element, Real x, Real y, int n, Real xDelta, Real xExtent, Real yExtent, Real yBlend, Real *buffer, BuilderCallback *callback) :
-			mPipe(pipe), mElement(element), x(x), y(y), n(n), xDelta(xDelta), xExtent(xExtent), yExtent(yExtent), yBlend(yBlend), buffer(buffer), callback(callback)
+		SeamlessPlaneLineJob2D (Pipeline2D *pipe, PipelineElement2D *element, Real x, Real y, int n, Real xDelta, Real xExtent, Real yExtent, Real yBlend, Real *buffer, MappedFile *file, BuilderCallback *callback) :
+			mPipe(pipe), mElement(element), x(x), y(y), n(n), xDelta(xDelta), xExtent(xExtent), yExtent(yExtent), yBlend(yBlend), buffer(buffer), file(file), callback(callback)
 		{
 		}
 		void execute (Cache *cache)
@@ -138,6 +223,10 @@ class SeamlessPlaneLineJob2D : public PipelineJob
 		}
 		void finish ()
 		{
+			if (file)
+			{
+				file->flush (buffer, n);
+			}
 			if (callback)
 			{
 				callback->callback ();
@@ -145,7 +234,124 @@ class SeamlessPlaneLineJob2D : public PipelineJob
 		}
 };
 
-PlaneBuilder2D::PlaneBuilder2D () : mLowerBoundX(0), mLowerBoundY(0), mUpperBoundX(0), mUpperBoundY(0), mSeamless(false)
+class VolumeTileJob3D : public PipelineJob
+{
+	private:
+		Pipeline3D *mPipe;
+		PipelineElement3D *mElement;
+		ElementID mElementID;
+		Real mX, mY, mZ;
+		Real mXDelta, mYDelta, mZDelta;
+		int mSizeX, mSizeY, mSizeZ;
+		int mWidth, mHeight;
+		Real *mDest;
+		bool mRegionRejection;
+		Real mThreshold;
+		bool mRejected;
+		int *mRejectedCount;
+		MappedFile *mFile;
+		BuilderCallback *mCallback;
+
+		void fill (Real value)
+		{
+			for (int z=0;z<mSizeZ;++z)
+			{
+				for (int y=0;y<mSizeY;++y)
+				{
+					Real *dest = mDest + ((size_t)z*mHeight + y)*mWidth;
+					for (int x=0;x<mSizeX;++x)
+					{
+						dest[x] = value;
+					}
+				}
+			}
+		}
+
+	public:
+		VolumeTileJob3D (Pipeline3D *pipe, PipelineElement3D *element, ElementID elementID, Real x, Real y, Real z, Real xDelta, Real yDelta, Real zDelta,
+			int sizeX, int sizeY, int sizeZ, int width, int height, Real *dest, bool regionRejection, Real threshold, int *rejectedCount, MappedFile *file, BuilderCallback *callback) :
+			mPipe(pipe), mElement(element), mElementID(elementID), mX(x), mY(y), mZ(z), mXDelta(xDelta), mYDelta(yDelta), mZDelta(zDelta),
+			mSizeX(sizeX), mSizeY(sizeY), mSizeZ(sizeZ), mWidth(width), mHeight(height), mDest(dest),
+			mRegionRejection(regionRejection), mThreshold(threshold), mRejected(false), mRejectedCount(rejectedCount), mFile(file), mCallback(callback)
+		{
+		}
+		void execute (Cache *cache)
+		{
+			if (mRegionRejection)
+			{
+				const Interval range = mElement->getRegionRange (
+					Interval (mX, mX + Real(mSizeX-1) * mXDelta),
+					Interval (mY, mY + Real(mSizeY-1) * mYDelta),
+					Interval (mZ, mZ + Real(mSizeZ-1) * mZDelta));
+				if (range.lower > mThreshold || range.isConstant ())
+				{
+					fill (range.lower);
+					mRejected = true;
+					return;
+				}
+				else if (range.upper < mThreshold)
+				{
+					fill (range.upper);
+					mRejected = true;
+					return;
+				}
+			}
+
+			Real xs[PIPELINE_BATCH_SIZE];
+			Real ys[PIPELINE_BATCH_SIZE];
+			Real zs[PIPELINE_BATCH_SIZE];
+			// cleans the cache
+			mPipe->cleanCache (cache);
+			for (int z=0;z<mSizeZ;++z)
+			{
+				const Real zp = mZ + Real(z) * mZDelta;
+				for (int y=0;y<mSizeY;++y)
+				{
+					const Real yp = mY + Real(y) * mYDelta;
+					Real *dest = mDest + ((size_t)z*mHeight + y)*mWidth;
+					for (int x=0;x<mSizeX;)
+					{
+						const int count = (mSizeX - x) < int(PIPELINE_BATCH_SIZE) ? (mSizeX - x) : int(PIPELINE_BATCH_SIZE);
+						for (int i=0;i<count;++i)
+						{
+							xs[i] = mX + Real(x+i) * mXDelta;
+							ys[i] = yp;
+							zs[i] = zp;
+						}
+						mElement->getValues (xs, ys, zs, dest+x, count, cache);
+#if NOISEPP_ENABLE_PROFILING
+						mPipe->countValues (mElementID, cache, count);
+#endif
+						x += count;
+					}
+				}
+			}
+		}
+		void finish ()
+		{
+			if (mRejected)
+			{
+				++(*mRejectedCount);
+			}
+			if (mFile)
+			{
+				// only the rows of the tile, the values in between belong to other tiles
+				for (int z=0;z<mSizeZ;++z)
+				{
+					for (int y=0;y<mSizeY;++y)
+					{
+						mFile->flush (mDest + ((size_t)z*mHeight + y)*mWidth, mSizeX);
+					}
+				}
+			}
+			if (mCallback)
+			{
+				mCallback->callback ();
+			}
+		}
+};
+
+PlaneBuilder2D::PlaneBuilder2D () : mLowerBoundX(0), mLowerBoundY(0), mUpperBoundX(0), mUpperBoundY(0), mSeamless(false), mGradientDestX(0), mGradientDestY(0)
 {
 }
 
@@ -159,6 +365,7 @@ void PlaneBuilder2D::build (Pipeline2D *pipeline, PipelineElement2D *element)
 	checkParameters ();
 	NoiseAssert(mLowerBoundX < mUpperBoundX, (mLowerBoundX, mUpperBoundX));
 	NoiseAssert(mLowerBoundY < mUpperBoundY, (mLowerBoundY, mUpperBoundY));
+	NoiseAssert(!mSeamless || mGradientDestX == NULL, mGradientDestX);
 
 	bool destroyPipe = false;
 	if (!pipeline)
@@ -175,11 +382,19 @@ void PlaneBuilder2D::build (Pipeline2D *pipeline, PipelineElement2D *element)
 	Real xDelta = xExtent / (Real)mWidth;
 	Real yDelta = yExtent / (Real)mHeight;
 	Real yp = mLowerBoundY;
-	if (!mSeamless)
+	if (mGradientDestX)
 	{
 		for (int y=0;y<mHeight;++y)
 		{
-			pipeline->addJob (new ProgressLineJob2D(pipeline, element, mLowerBoundX, yp, mWidth, xDelta, mDest+(y*mWidth), mCallback));
+			pipeline->addJob (new GradientLineJob2D(pipeline, element, mLowerBoundX, yp, mWidth, xDelta, mDest+((size_t)y*mWidth), mGradientDestX+((size_t)y*mWidth), mGradientDestY+((size_t)y*mWidth), mMappedFile, mCallback));
+			yp += yDelta;
+		}
+	}
+	else if (!mSeamless)
+	{
+		for (int y=0;y<mHeight;++y)
+		{
+			pipeline->addJob (new ProgressLineJob2D(pipeline, element, mLowerBoundX, yp, mWidth, xDelta, mDest+((size_t)y*mWidth), mMappedFile, mCallback));
 			yp += yDelta;
 		}
 	}
@@ -188,7 +403,7 @@ void PlaneBuilder2D::build (Pipeline2D *pipeline, PipelineElement2D *element)
 		for (int y=0;y<mHeight;++y)
 		{
 			Real yBlend = Real(1) - ((yp-mLowerBoundY) / yExtent);
-			pipeline->addJob (new SeamlessPlaneLineJob2D(pipeline, element, mLowerBoundX, yp, mWidth, xDelta, xExtent, yExtent, yBlend, mDest+(y*mWidth), mCallback));
+			pipeline->addJob (new SeamlessPlaneLineJob2D(pipeline, element, mLowerBoundX, yp, mWidth, xDelta, xExtent, yExtent, yBlend, mDest+((size_t)y*mWidth), mMappedFile, mCallback));
 			yp += yDelta;
 		}
 	}
@@ -244,5 +459,172 @@ bool PlaneBuilder2D::isSeamless () const
 	return mSeamless;
 }
 
+void PlaneBuilder2D::setGradientDestination (Real *destX, Real *destY)
+{
+	NoiseAssert((destX == NULL) == (destY == NULL), (destX, destY));
+	mGradientDestX = destX;
+	mGradientDestY = destY;
+}
+
+bool PlaneBuilder2D::hasGradientDestination () const
+{
+	return mGradientDestX != NULL;
+}
+
+VolumeBuilder3D::VolumeBuilder3D () : mDepth(0), mLowerBoundX(0), mLowerBoundY(0), mLowerBoundZ(0), mUpperBoundX(0), mUpperBoundY(0), mUpperBoundZ(0),
+	mTileSize(16), mRegionRejection(false), mThreshold(0), mRejectedTileCount(0)
+{
+}
+
+int VolumeBuilder3D::getTileCount (int size) const
+{
+	return (size + mTileSize - 1) / mTileSize;
+}
+
+void VolumeBuilder3D::build ()
+{
+	build(0, 0);
+}
+
+void VolumeBuilder3D::build (Pipeline3D *pipeline, PipelineElement3D *element)
+{
+	checkParameters ();
+	NoiseAssert(mDepth > 0, mDepth);
+	NoiseAssert(mMappedFile == NULL || mMappedFile->getDepth() == mDepth, mDepth);
+	NoiseAssert(mTileSize > 0, mTileSize);
+	NoiseAssert(mLowerBoundX < mUpperBoundX, (mLowerBoundX, mUpperBoundX));
+	NoiseAssert(mLowerBoundY < mUpperBoundY, (mLowerBoundY, mUpperBoundY));
+	NoiseAssert(mLowerBoundZ < mUpperBoundZ, (mLowerBoundZ, mUpperBoundZ));
+
+	bool destroyPipe = false;
+	if (!pipeline)
+	{
+		NoiseAssert(mModule != NULL, mModule);
+		pipeline = System::createOptimalPipeline3D();
+		ElementID id = mModule->addToPipeline(pipeline);
+		element = pipeline->getElement(id);
+		destroyPipe = true;
+	}
+
+	const Real xDelta = (mUpperBoundX - mLowerBoundX) / (Real)mWidth;
+	const Real yDelta = (mUpperBoundY - mLowerBoundY) / (Real)mHeight;
+	const Real zDelta = (mUpperBoundZ - mLowerBoundZ) / (Real)mDepth;
+	const ElementID elementID = pipeline->getElementID (element);
+	mRejectedTileCount = 0;
+	for (int z=0;z<mDepth;z+=mTileSize)
+	{
+		const int sizeZ = (std::min)(mTileSize, mDepth-z);
+		for (int y=0;y<mHeight;y+=mTileSize)
+		{
+			const int sizeY = (std::min)(mTileSize, mHeight-y);
+			for (int x=0;x<mWidth;x+=mTileSize)
+			{
+				const int sizeX = (std::min)(mTileSize, mWidth-x);
+				Real *dest = mDest + ((size_t)z*mHeight + y)*mWidth + x;
+				pipeline->addJob (new VolumeTileJob3D(pipeline, element, elementID,
+					mLowerBoundX + Real(x) * xDelta, mLowerBoundY + Real(y) * yDelta, mLowerBoundZ + Real(z) * zDelta, xDelta, yDelta, zDelta,
+					sizeX, sizeY, sizeZ, mWidth, mHeight, dest, mRegionRejection, mThreshold, &mRejectedTileCount, mMappedFile, mCallback));
+			}
+		}
+	}
+	pipeline->executeJobs ();
+
+	if (destroyPipe)
+	{
+		delete pipeline;
+		pipeline = 0;
+	}
+}
+
+int VolumeBuilder3D::getProgressMaximum () const
+{
+	return getTileCount(mWidth) * getTileCount(mHeight) * getTileCount(mDepth);
+}
+
+void VolumeBuilder3D::setDepth (int depth)
+{
+	mDepth = depth;
+}
+
+int VolumeBuilder3D::getDepth () const
+{
+	return mDepth;
+}
+
+void VolumeBuilder3D::setBounds (Real lowerBoundX, Real lowerBoundY, Real lowerBoundZ, Real upperBoundX, Real upperBoundY, Real upperBoundZ)
+{
+	mLowerBoundX = lowerBoundX;
+	mLowerBoundY = lowerBoundY;
+	mLowerBoundZ = lowerBoundZ;
+	mUpperBoundX = upperBoundX;
+	mUpperBoundY = upperBoundY;
+	mUpperBoundZ = upperBoundZ;
+}
+
+Real VolumeBuilder3D::getLowerBoundX () const
+{
+	return mLowerBoundX;
+}
+
+Real VolumeBuilder3D::getLowerBoundY () const
+{
+	return mLowerBoundY;
+}
+
+Real VolumeBuilder3D::getLowerBoundZ () const
+{
+	return mLowerBoundZ;
+}
+
+Real VolumeBuilder3D::getUpperBoundX () const
+{
+	return mUpperBoundX;
+}
+
+Real VolumeBuilder3D::getUpperBoundY () const
+{
+	return mUpperBoundY;
+}
+
+Real VolumeBuilder3D::getUpperBoundZ () const
+{
+	return mUpperBoundZ;
+}
+
+void VolumeBuilder3D::setTileSize (int size)
+{
+	mTileSize = size;
+}
+
+int VolumeBuilder3D::getTileSize () const
+{
+	return mTileSize;
+}
+
+void VolumeBuilder3D::setRegionRejection (bool v)
+{
+	mRegionRejection = v;
+}
+
+bool VolumeBuilder3D::isRegionRejectionEnabled () const
+{
+	return mRegionRejection;
+}
+
+void VolumeBuilder3D::setThreshold (Real threshold)
+{
+	mThreshold = threshold;
+}
+
+Real VolumeBuilder3D::getThreshold () const
+{
+	return mThreshold;
+}
+
+int VolumeBuilder3D::getRejectedTileCount () const
+{
+	return mRejectedTileCount;
+}
+
 };
 };
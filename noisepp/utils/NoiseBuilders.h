@@ -29,6 +29,7 @@
 #include "NoisePrerequisites.h"
 #include "NoisePipelineJobs.h"
 #include "NoiseModule.h"
+#include "NoiseMappedFile.h"
 
 namespace noisepp
 {
@@ -79,6 +80,8 @@ class Builder
 		int mHeight;
 		/// Source module.
 		Module *mModule;
+		/// Mapped destination file.
+		MappedFile *mMappedFile;
 
 		/// Check the parameters.
 		void checkParameters ();
@@ -93,8 +96,18 @@ class Builder
 		/// @param width The output width.
 		/// @param height The output height.
 		void setSize (int width, int height);
+		/// Returns the output width.
+		int getWidth () const;
+		/// Returns the output height.
+		int getHeight () const;
 		/// Sets the output destination.
 		void setDestination (Real *dest);
+		/// Returns the output destination.
+		Real *getDestination () const;
+		/// Sets a mapped file as output destination.
+		/// The builder writes straight into the mapping and hands each finished job's values to MappedFile::flush().
+		/// The size of the file has to match the output size.
+		void setDestination (MappedFile &file);
 		/// Sets the source module.
 		void setModule (Module *module);
 		/// Sets the source module.
@@ -102,6 +115,8 @@ class Builder
 		{
 			setModule (&module);
 		}
+		/// Returns the source module.
+		Module *getModule () const;
 		/// Sets a callback
 		void setCallback (BuilderCallback *callback);
 		/// Build.
@@ -119,6 +134,7 @@ class PlaneBuilder2D : public Builder
 		Real mLowerBoundX, mLowerBoundY;
 		Real mUpperBoundX, mUpperBoundY;
 		bool mSeamless;
+		Real *mGradientDestX, *mGradientDestY;
 
 	public:
 		/// Constructor.
@@ -148,6 +164,75 @@ class PlaneBuilder2D : public Builder
 		void setSeamless (bool v=true);
 		/// Returns if building a seamless plane is enabled.
 		bool isSeamless () const;
+		/// Sets the destinations of the partial derivatives along the x- and y-axis.
+		/// If set, the plane is built with PipelineElement2D::getValueAndGradient(), which suits
+		/// the HeightmapRenderer classes. Passing NULL disables this. It can't be combined with a seamless plane.
+		void setGradientDestination (Real *destX, Real *destY);
+		/// Returns true if gradient destinations are set.
+		bool hasGradientDestination () const;
+};
+
+/// Builder class for a 3D volume.
+/// The volume is stored slice by slice, the value at (x, y, z) is at index (z*height + y)*width + x.
+/// The volume is built in cubic tiles. If region rejection is enabled, each tile is tested with
+/// PipelineElement3D::getRegionRange() first. Tiles which are provably above or below the threshold
+/// are filled with the bound closest to the threshold without evaluating the pipeline,
+/// which is all an iso-surface extraction needs.
+class VolumeBuilder3D : public Builder
+{
+	private:
+		int mDepth;
+		Real mLowerBoundX, mLowerBoundY, mLowerBoundZ;
+		Real mUpperBoundX, mUpperBoundY, mUpperBoundZ;
+		int mTileSize;
+		bool mRegionRejection;
+		Real mThreshold;
+		int mRejectedTileCount;
+
+		int getTileCount (int size) const;
+
+	public:
+		/// Constructor.
+		VolumeBuilder3D ();
+		/// Build using the specified pipeline and element.
+		void build (Pipeline3D *pipeline, PipelineElement3D *element);
+		/// @copydoc noisepp::utils::Builder::build()
+		virtual void build ();
+		/// @copydoc noisepp::utils::Builder::getProgressMaximum()
+		int getProgressMaximum () const;
+
+		/// Sets the output depth.
+		void setDepth (int depth);
+		/// Returns the output depth.
+		int getDepth () const;
+		/// Sets the volume bounds.
+		void setBounds (Real lowerBoundX, Real lowerBoundY, Real lowerBoundZ, Real upperBoundX, Real upperBoundY, Real upperBoundZ);
+		/// Returns the x-coordinate of the lower bound.
+		Real getLowerBoundX () const;
+		/// Returns the y-coordinate of the lower bound.
+		Real getLowerBoundY () const;
+		/// Returns the z-coordinate of the lower bound.
+		Real getLowerBoundZ () const;
+		/// Returns the x-coordinate of the upper bound.
+		Real getUpperBoundX () const;
+		/// Returns the y-coordinate of the upper bound.
+		Real getUpperBoundY () const;
+		/// Returns the z-coordinate of the upper bound.
+		Real getUpperBoundZ () const;
+		/// Sets the edge length of the tiles (default 16).
+		void setTileSize (int size);
+		/// Returns the edge length of the tiles.
+		int getTileSize () const;
+		/// Enables or disables the rejection of tiles which lie completely above or below the threshold.
+		void setRegionRejection (bool v=true);
+		/// Returns if region rejection is enabled.
+		bool isRegionRejectionEnabled () const;
+		/// Sets the threshold used for region rejection.
+		void setThreshold (Real threshold);
+		/// Returns the threshold used for region rejection.
+		Real getThreshold () const;
+		/// Returns the number of tiles that were filled without evaluating the pipeline during the last build.
+		int getRejectedTileCount () const;
 };
 
 };
@@ -0,0 +1,1164 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEEXPRESSION_H
+#define NOISEEXPRESSION_H
+
+#include "NoisePrerequisites.h"
+#include "Noise.h"
+#include "NoiseModuleArena.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/** Static module graphs built from expression templates.
+	For graphs which are fixed at compile time the type of an expression encodes the whole graph, e.g.
+	@code
+	scaleBias (turbulence (ridgedMulti<6> ().setFrequency (0.5)), 0.5, 0.5)
+	@endcode
+	Evaluating it with getValue() doesn't need a pipeline or a cache, there are no virtual calls and the compiler
+	is free to inline all generators and combiners into a single function.
+	Expressions are trees of values, an expression used twice is evaluated twice.
+	createModule() builds the equivalent module graph in an arena, e.g. for serialization with the Writer,
+	which calculates the same values in a pipeline with seed 0. The results may differ in the last bit where the
+	compiler specializes on constant parameters (e.g. std::pow with a constant exponent) or where the pipeline
+	folds adjacent point transforms into one.
+*/
+
+/// Calculates gradient coherent noise of a quality known at compile time.
+template <int Quality>
+struct ExpressionGradient
+{
+	/// Returns the noise scale including the factor of the fast qualities.
+	static Real calcScale (Real scale)
+	{
+		if (Quality > NOISE_QUALITY_HIGH)
+			scale *= FAST_NOISE_SCALE_FACTOR;
+		return scale;
+	}
+	static NOISEPP_INLINE Real calc (Real x, int seed, Real scale)
+	{
+		if (Quality == NOISE_QUALITY_STD)
+			return Generator1D::calcGradientCoherentNoiseStd (x, seed, scale);
+		else if (Quality == NOISE_QUALITY_HIGH)
+			return Generator1D::calcGradientCoherentNoiseHigh (x, seed, scale);
+		else if (Quality == NOISE_QUALITY_LOW)
+			return Generator1D::calcGradientCoherentNoiseLow (x, seed, scale);
+		else if (Quality == NOISE_QUALITY_FAST_STD)
+			return Generator1D::calcGradientCoherentFastNoiseStd (x, seed, scale);
+		else if (Quality == NOISE_QUALITY_FAST_HIGH)
+			return Generator1D::calcGradientCoherentFastNoiseHigh (x, seed, scale);
+		else
+			return Generator1D::calcGradientCoherentFastNoiseLow (x, seed, scale);
+	}
+	static NOISEPP_INLINE Real calc (Real x, Real y, int seed, Real scale)
+	{
+		if (Quality == NOISE_QUALITY_STD)
+			return Generator2D::calcGradientCoherentNoiseStd (x, y, seed, scale);
+		else if (Quality == NOISE_QUALITY_HIGH)
+			return Generator2D::calcGradientCoherentNoiseHigh (x, y, seed, scale);
+		else if (Quality == NOISE_QUALITY_LOW)
+			return Generator2D::calcGradientCoherentNoiseLow (x, y, seed, scale);
+		else if (Quality == NOISE_QUALITY_FAST_STD)
+			return Generator2D::calcGradientCoherentFastNoiseStd (x, y, seed, scale);
+		else if (Quality == NOISE_QUALITY_FAST_HIGH)
+			return Generator2D::calcGradientCoherentFastNoiseHigh (x, y, seed, scale);
+		else
+			return Generator2D::calcGradientCoherentFastNoiseLow (x, y, seed, scale);
+	}
+	static NOISEPP_INLINE Real calc (Real x, Real y, Real z, int seed, Real scale)
+	{
+		if (Quality == NOISE_QUALITY_STD)
+			return Generator3D::calcGradientCoherentNoiseStd (x, y, z, seed, scale);
+		else if (Quality == NOISE_QUALITY_HIGH)
+			return Generator3D::calcGradientCoherentNoiseHigh (x, y, z, seed, scale);
+		else if (Quality == NOISE_QUALITY_LOW)
+			return Generator3D::calcGradientCoherentNoiseLow (x, y, z, seed, scale);
+		else if (Quality == NOISE_QUALITY_FAST_STD)
+			return Generator3D::calcGradientCoherentFastNoiseStd (x, y, z, seed, scale);
+		else if (Quality == NOISE_QUALITY_FAST_HIGH)
+			return Generator3D::calcGradientCoherentFastNoiseHigh (x, y, z, seed, scale);
+		else
+			return Generator3D::calcGradientCoherentFastNoiseLow (x, y, z, seed, scale);
+	}
+};
+
+/// 1D input point of an expression.
+struct ExpressionPoint1D
+{
+	Real x;
+	ExpressionPoint1D (Real x) : x(x) {}
+	/// Evaluates the specified expression at the point.
+	template <class E>
+	NOISEPP_INLINE Real operator() (const E &expression) const
+	{
+		return expression.getValue (x);
+	}
+};
+
+/// 2D input point of an expression.
+struct ExpressionPoint2D
+{
+	Real x, y;
+	ExpressionPoint2D (Real x, Real y) : x(x), y(y) {}
+	/// Evaluates the specified expression at the point.
+	template <class E>
+	NOISEPP_INLINE Real operator() (const E &expression) const
+	{
+		return expression.getValue (x, y);
+	}
+};
+
+/// 3D input point of an expression.
+struct ExpressionPoint3D
+{
+	Real x, y, z;
+	ExpressionPoint3D (Real x, Real y, Real z) : x(x), y(y), z(z) {}
+	/// Evaluates the specified expression at the point.
+	template <class E>
+	NOISEPP_INLINE Real operator() (const E &expression) const
+	{
+		return expression.getValue (x, y, z);
+	}
+};
+
+/// Base class of the expressions which evaluate their sources at the same point.
+/// The derived class implements evaluate() once for all dimensions.
+template <class Derived>
+class PointwiseExpression
+{
+	public:
+		NOISEPP_INLINE Real getValue (Real x) const
+		{
+			return static_cast<const Derived*>(this)->evaluate (ExpressionPoint1D(x));
+		}
+		NOISEPP_INLINE Real getValue (Real x, Real y) const
+		{
+			return static_cast<const Derived*>(this)->evaluate (ExpressionPoint2D(x, y));
+		}
+		NOISEPP_INLINE Real getValue (Real x, Real y, Real z) const
+		{
+			return static_cast<const Derived*>(this)->evaluate (ExpressionPoint3D(x, y, z));
+		}
+};
+
+/// Base class of the perlin and billow expressions.
+template <class Derived, int Octaves, int Quality>
+class PerlinExpressionBase
+{
+	protected:
+		struct Octave
+		{
+			int seed;
+			Real scale;
+			Real persistence;
+		};
+		Octave mOctaves[Octaves];
+		Real mFrequency;
+		int mSeed;
+		Real mLacunarity;
+		Real mPersistence;
+		Real mScale;
+		/// The noise scale including the factor of the fast qualities.
+		Real mNoiseScale;
+
+		/// Updates the octaves like the pipeline element does.
+		void update ()
+		{
+			mNoiseScale = ExpressionGradient<Quality>::calcScale (mScale);
+			Real curPersistence = 1.0;
+			Real scale = mFrequency;
+			for (int o=0;o<Octaves;++o)
+			{
+				mOctaves[o].persistence = curPersistence;
+				mOctaves[o].scale = scale;
+				mOctaves[o].seed = (mSeed + o) & 0xffffffff;
+
+				scale *= mLacunarity;
+				curPersistence *= mPersistence;
+			}
+		}
+		Derived &self ()
+		{
+			return *static_cast<Derived*>(this);
+		}
+		/// Copies the settings to the equivalent module.
+		void setupModule (PerlinModuleBase *module) const
+		{
+			module->setFrequency (mFrequency);
+			module->setOctaveCount (Octaves);
+			module->setSeed (mSeed);
+			module->setQuality (Quality);
+			module->setLacunarity (mLacunarity);
+			module->setPersistence (mPersistence);
+			module->setScale (mScale);
+		}
+
+	public:
+		/// Constructor, the defaults are the ones of the modules.
+		PerlinExpressionBase () : mFrequency(1.0f), mSeed(0), mLacunarity(2.0f), mPersistence(0.5f), mScale(2.12f)
+		{
+			update ();
+		}
+		/// Sets the frequency.
+		Derived &setFrequency (Real v)
+		{
+			mFrequency = v;
+			update ();
+			return self ();
+		}
+		/// Returns the frequency.
+		Real getFrequency () const
+		{
+			return mFrequency;
+		}
+		/// Sets the noise seed.
+		Derived &setSeed (int v)
+		{
+			mSeed = v;
+			update ();
+			return self ();
+		}
+		/// Returns the noise seed.
+		int getSeed () const
+		{
+			return mSeed;
+		}
+		/// Sets the noise lacunarity.
+		Derived &setLacunarity (Real v)
+		{
+			mLacunarity = v;
+			update ();
+			return self ();
+		}
+		/// Returns the noise lacunarity.
+		Real getLacunarity () const
+		{
+			return mLacunarity;
+		}
+		/// Sets the noise persistence.
+		Derived &setPersistence (Real v)
+		{
+			mPersistence = v;
+			update ();
+			return self ();
+		}
+		/// Returns the noise persistence.
+		Real getPersistence () const
+		{
+			return mPersistence;
+		}
+		/// Sets the noise scale factor.
+		Derived &setScale (Real v)
+		{
+			mScale = v;
+			update ();
+			return self ();
+		}
+		/// Returns the noise scale factor.
+		Real getScale () const
+		{
+			return mScale;
+		}
+};
+
+/// Perlin noise with a fixed number of octaves, see PerlinModule.
+template <int Octaves, int Quality=NOISE_QUALITY_STD>
+class PerlinExpression : public PerlinExpressionBase<PerlinExpression<Octaves, Quality>, Octaves, Quality>
+{
+	public:
+		Real getValue (Real x) const
+		{
+			Real value = 0.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * this->mOctaves[o].scale);
+				value += ExpressionGradient<Quality>::calc (nx, this->mOctaves[o].seed, this->mNoiseScale) * this->mOctaves[o].persistence;
+			}
+			return value;
+		}
+		Real getValue (Real x, Real y) const
+		{
+			Real value = 0.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * this->mOctaves[o].scale);
+				const Real ny = Math::MakeInt32Range (y * this->mOctaves[o].scale);
+				value += ExpressionGradient<Quality>::calc (nx, ny, this->mOctaves[o].seed, this->mNoiseScale) * this->mOctaves[o].persistence;
+			}
+			return value;
+		}
+		Real getValue (Real x, Real y, Real z) const
+		{
+			Real value = 0.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * this->mOctaves[o].scale);
+				const Real ny = Math::MakeInt32Range (y * this->mOctaves[o].scale);
+				const Real nz = Math::MakeInt32Range (z * this->mOctaves[o].scale);
+				value += ExpressionGradient<Quality>::calc (nx, ny, nz, this->mOctaves[o].seed, this->mNoiseScale) * this->mOctaves[o].persistence;
+			}
+			return value;
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			PerlinModule *module = arena.create<PerlinModule> ();
+			this->setupModule (module);
+			return module;
+		}
+};
+
+/// Billow noise with a fixed number of octaves, see BillowModule.
+template <int Octaves, int Quality=NOISE_QUALITY_STD>
+class BillowExpression : public PerlinExpressionBase<BillowExpression<Octaves, Quality>, Octaves, Quality>
+{
+	public:
+		Real getValue (Real x) const
+		{
+			Real value = 0.5;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * this->mOctaves[o].scale);
+				Real signal = ExpressionGradient<Quality>::calc (nx, this->mOctaves[o].seed, this->mNoiseScale);
+				signal = Real(2.0) * std::fabs (signal) - Real(1.0);
+				value += signal * this->mOctaves[o].persistence;
+			}
+			return value;
+		}
+		Real getValue (Real x, Real y) const
+		{
+			Real value = 0.5;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * this->mOctaves[o].scale);
+				const Real ny = Math::MakeInt32Range (y * this->mOctaves[o].scale);
+				Real signal = ExpressionGradient<Quality>::calc (nx, ny, this->mOctaves[o].seed, this->mNoiseScale);
+				signal = Real(2.0) * std::fabs (signal) - Real(1.0);
+				value += signal * this->mOctaves[o].persistence;
+			}
+			return value;
+		}
+		Real getValue (Real x, Real y, Real z) const
+		{
+			Real value = 0.5;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * this->mOctaves[o].scale);
+				const Real ny = Math::MakeInt32Range (y * this->mOctaves[o].scale);
+				const Real nz = Math::MakeInt32Range (z * this->mOctaves[o].scale);
+				Real signal = ExpressionGradient<Quality>::calc (nx, ny, nz, this->mOctaves[o].seed, this->mNoiseScale);
+				signal = Real(2.0) * std::fabs (signal) - Real(1.0);
+				value += signal * this->mOctaves[o].persistence;
+			}
+			return value;
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			BillowModule *module = arena.create<BillowModule> ();
+			this->setupModule (module);
+			return module;
+		}
+};
+
+/// Ridged multifractal noise with a fixed number of octaves, see RidgedMultiModule.
+template <int Octaves, int Quality=NOISE_QUALITY_STD>
+class RidgedMultiExpression
+{
+	private:
+		struct Octave
+		{
+			int seed;
+			Real scale;
+			Real spectralWeight;
+		};
+		Octave mOctaves[Octaves];
+		Real mFrequency;
+		int mSeed;
+		Real mLacunarity;
+		Real mExponent;
+		Real mOffset;
+		Real mGain;
+		Real mScale;
+		/// The noise scale including the factor of the fast qualities.
+		Real mNoiseScale;
+
+		/// Updates the octaves like the pipeline element does.
+		void update ()
+		{
+			mNoiseScale = ExpressionGradient<Quality>::calcScale (mScale);
+			Real scale = mFrequency;
+			Real sw_freq = 1.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				mOctaves[o].spectralWeight = pow(sw_freq, -mExponent);
+				mOctaves[o].scale = scale;
+				mOctaves[o].seed = (mSeed + o) & 0x7fffffff;
+
+				scale *= mLacunarity;
+				sw_freq *= mLacunarity;
+			}
+		}
+		NOISEPP_INLINE Real calcSignal (Real signal, Real &weight) const
+		{
+			signal = mOffset - std::fabs(signal);
+			signal *= signal;
+			signal *= weight;
+			weight = signal * mGain;
+			if (weight > Real(1.0))
+				weight = Real(1.0);
+			if (weight < Real(-1.0))
+				weight = Real(-1.0);
+			return signal;
+		}
+
+	public:
+		/// Constructor, the defaults are the ones of the module.
+		RidgedMultiExpression () : mFrequency(1.0f), mSeed(0), mLacunarity(2.0f), mExponent(1.0f), mOffset(1.0f), mGain(2.0f), mScale(2.12f)
+		{
+			update ();
+		}
+		/// Sets the frequency.
+		RidgedMultiExpression &setFrequency (Real v)
+		{
+			mFrequency = v;
+			update ();
+			return *this;
+		}
+		/// Sets the noise seed.
+		RidgedMultiExpression &setSeed (int v)
+		{
+			mSeed = v;
+			update ();
+			return *this;
+		}
+		/// Sets the noise lacunarity.
+		RidgedMultiExpression &setLacunarity (Real v)
+		{
+			mLacunarity = v;
+			update ();
+			return *this;
+		}
+		/// Sets the exponent.
+		RidgedMultiExpression &setExponent (Real v)
+		{
+			mExponent = v;
+			update ();
+			return *this;
+		}
+		/// Sets the offset.
+		RidgedMultiExpression &setOffset (Real v)
+		{
+			mOffset = v;
+			return *this;
+		}
+		/// Sets the gain.
+		RidgedMultiExpression &setGain (Real v)
+		{
+			mGain = v;
+			return *this;
+		}
+		/// Sets the noise scale factor.
+		RidgedMultiExpression &setScale (Real v)
+		{
+			mScale = v;
+			update ();
+			return *this;
+		}
+		Real getValue (Real x) const
+		{
+			Real value = 0.0;
+			Real weight = 1.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * mOctaves[o].scale);
+				const Real signal = calcSignal (ExpressionGradient<Quality>::calc (nx, mOctaves[o].seed, mNoiseScale), weight);
+				value += signal * mOctaves[o].spectralWeight;
+			}
+			return (value * Real(1.25)) - Real(1.0);
+		}
+		Real getValue (Real x, Real y) const
+		{
+			Real value = 0.0;
+			Real weight = 1.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * mOctaves[o].scale);
+				const Real ny = Math::MakeInt32Range (y * mOctaves[o].scale);
+				const Real signal = calcSignal (ExpressionGradient<Quality>::calc (nx, ny, mOctaves[o].seed, mNoiseScale), weight);
+				value += signal * mOctaves[o].spectralWeight;
+			}
+			return (value * Real(1.25)) - Real(1.0);
+		}
+		Real getValue (Real x, Real y, Real z) const
+		{
+			Real value = 0.0;
+			Real weight = 1.0;
+			for (int o=0;o<Octaves;++o)
+			{
+				const Real nx = Math::MakeInt32Range (x * mOctaves[o].scale);
+				const Real ny = Math::MakeInt32Range (y * mOctaves[o].scale);
+				const Real nz = Math::MakeInt32Range (z * mOctaves[o].scale);
+				const Real signal = calcSignal (ExpressionGradient<Quality>::calc (nx, ny, nz, mOctaves[o].seed, mNoiseScale), weight);
+				value += signal * mOctaves[o].spectralWeight;
+			}
+			return (value * Real(1.25)) - Real(1.0);
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			RidgedMultiModule *module = arena.create<RidgedMultiModule> ();
+			module->setFrequency (mFrequency);
+			module->setOctaveCount (Octaves);
+			module->setSeed (mSeed);
+			module->setQuality (Quality);
+			module->setLacunarity (mLacunarity);
+			module->setExponent (mExponent);
+			module->setOffset (mOffset);
+			module->setGain (mGain);
+			module->setScale (mScale);
+			return module;
+		}
+};
+
+/// Constant value, see ConstantModule.
+class ConstantExpression : public PointwiseExpression<ConstantExpression>
+{
+	private:
+		Real mValue;
+
+	public:
+		ConstantExpression (Real value) : mValue(value) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			return mValue;
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			ConstantModule *module = arena.create<ConstantModule> ();
+			module->setValue (mValue);
+			return module;
+		}
+};
+
+/// Absolute value of the source, see AbsoluteModule.
+template <class E>
+class AbsoluteExpression : public PointwiseExpression<AbsoluteExpression<E> >
+{
+	private:
+		E mSource;
+
+	public:
+		AbsoluteExpression (const E &source) : mSource(source) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			return std::fabs(point (mSource));
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			AbsoluteModule *module = arena.create<AbsoluteModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			return module;
+		}
+};
+
+/// Negated value of the source, see InvertModule.
+template <class E>
+class InvertExpression : public PointwiseExpression<InvertExpression<E> >
+{
+	private:
+		E mSource;
+
+	public:
+		InvertExpression (const E &source) : mSource(source) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			return -(point (mSource));
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			InvertModule *module = arena.create<InvertModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			return module;
+		}
+};
+
+/// Source value clamped to a range, see ClampModule.
+template <class E>
+class ClampExpression : public PointwiseExpression<ClampExpression<E> >
+{
+	private:
+		E mSource;
+		Real mLowerBound, mUpperBound;
+
+	public:
+		ClampExpression (const E &source, Real lowerBound, Real upperBound) : mSource(source), mLowerBound(lowerBound), mUpperBound(upperBound) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			Real value = point (mSource);
+			if (value < mLowerBound)
+				value = mLowerBound;
+			else if (value > mUpperBound)
+				value = mUpperBound;
+			return value;
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			ClampModule *module = arena.create<ClampModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			module->setLowerBound (mLowerBound);
+			module->setUpperBound (mUpperBound);
+			return module;
+		}
+};
+
+/// Source value mapped onto an exponential curve, see ExponentModule.
+template <class E>
+class ExponentExpression : public PointwiseExpression<ExponentExpression<E> >
+{
+	private:
+		E mSource;
+		Real mExponent;
+
+	public:
+		ExponentExpression (const E &source, Real exponent) : mSource(source), mExponent(exponent) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			const Real value = point (mSource);
+			return (std::pow (std::fabs ((value + Real(1.0)) / Real(2.0)), mExponent) * Real(2.0) - Real(1.0));
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			ExponentModule *module = arena.create<ExponentModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			module->setExponent (mExponent);
+			return module;
+		}
+};
+
+/// Scaled and biased source value, see ScaleBiasModule.
+template <class E>
+class ScaleBiasExpression : public PointwiseExpression<ScaleBiasExpression<E> >
+{
+	private:
+		E mSource;
+		Real mScale, mBias;
+
+	public:
+		ScaleBiasExpression (const E &source, Real scale, Real bias) : mSource(source), mScale(scale), mBias(bias) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			return point (mSource) * mScale + mBias;
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			ScaleBiasModule *module = arena.create<ScaleBiasModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			module->setScale (mScale);
+			module->setBias (mBias);
+			return module;
+		}
+};
+
+/// Sum of two values, see AdditionModule.
+struct AdditionOperator
+{
+	typedef AdditionModule ModuleType;
+	static NOISEPP_INLINE Real calc (Real left, Real right)
+	{
+		return left + right;
+	}
+};
+
+/// Product of two values, see MultiplyModule.
+struct MultiplyOperator
+{
+	typedef MultiplyModule ModuleType;
+	static NOISEPP_INLINE Real calc (Real left, Real right)
+	{
+		return left * right;
+	}
+};
+
+/// Larger of two values, see MaximumModule.
+struct MaximumOperator
+{
+	typedef MaximumModule ModuleType;
+	static NOISEPP_INLINE Real calc (Real left, Real right)
+	{
+		return left > right ? left : right;
+	}
+};
+
+/// Smaller of two values, see MinimumModule.
+struct MinimumOperator
+{
+	typedef MinimumModule ModuleType;
+	static NOISEPP_INLINE Real calc (Real left, Real right)
+	{
+		return left < right ? left : right;
+	}
+};
+
+/// Left value raised to the power of the right value, see PowerModule.
+struct PowerOperator
+{
+	typedef PowerModule ModuleType;
+	static NOISEPP_INLINE Real calc (Real left, Real right)
+	{
+		return std::pow(left, right);
+	}
+};
+
+/// Combines the values of two sources with one of the operators above.
+template <class Operator, class L, class R>
+class BinaryExpression : public PointwiseExpression<BinaryExpression<Operator, L, R> >
+{
+	private:
+		L mLeft;
+		R mRight;
+
+	public:
+		BinaryExpression (const L &left, const R &right) : mLeft(left), mRight(right) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			return Operator::calc (point (mLeft), point (mRight));
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			typename Operator::ModuleType *module = arena.create<typename Operator::ModuleType> ();
+			module->setSourceModule (0, mLeft.createModule (arena));
+			module->setSourceModule (1, mRight.createModule (arena));
+			return module;
+		}
+};
+
+/// Blends two sources by a control source, see BlendModule.
+template <class L, class R, class C>
+class BlendExpression : public PointwiseExpression<BlendExpression<L, R, C> >
+{
+	private:
+		L mLeft;
+		R mRight;
+		C mControl;
+
+	public:
+		BlendExpression (const L &left, const R &right, const C &control) : mLeft(left), mRight(right), mControl(control) {}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			return Math::InterpLinear (point (mLeft), point (mRight), (point (mControl) + Real(1.0)) / Real(2.0));
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			BlendModule *module = arena.create<BlendModule> ();
+			module->setSourceModule (0, mLeft.createModule (arena));
+			module->setSourceModule (1, mRight.createModule (arena));
+			module->setControlModule (mControl.createModule (arena));
+			return module;
+		}
+};
+
+/// Selects one of two sources by a control source, see SelectModule.
+/// Only the selected sources are evaluated.
+template <class L, class R, class C>
+class SelectExpression : public PointwiseExpression<SelectExpression<L, R, C> >
+{
+	private:
+		L mLeft;
+		R mRight;
+		C mControl;
+		Real mLowerBound, mUpperBound;
+		Real mLowerBoundPlusFalloff, mLowerBoundMinusFalloff;
+		Real mUpperBoundPlusFalloff, mUpperBoundMinusFalloff;
+		Real mEdgeFalloff, mTwoEdgeFalloff;
+
+	public:
+		SelectExpression (const L &left, const R &right, const C &control, Real lowerBound, Real upperBound, Real edgeFalloff) :
+			mLeft(left), mRight(right), mControl(control), mLowerBound(lowerBound), mUpperBound(upperBound)
+		{
+			NoiseAssert (mLowerBound < mUpperBound, (mLowerBound, mUpperBound));
+			// the edge falloff is limited like in the module
+			const Real range = Real(0.5) * (mUpperBound - mLowerBound);
+			mEdgeFalloff = (edgeFalloff > range) ? range : edgeFalloff;
+			mLowerBoundPlusFalloff = mLowerBound + mEdgeFalloff;
+			mLowerBoundMinusFalloff = mLowerBound - mEdgeFalloff;
+			mUpperBoundPlusFalloff = mUpperBound + mEdgeFalloff;
+			mUpperBoundMinusFalloff = mUpperBound - mEdgeFalloff;
+			mTwoEdgeFalloff = Real(2.0) * mEdgeFalloff;
+		}
+		template <class P>
+		NOISEPP_INLINE Real evaluate (const P &point) const
+		{
+			const Real controlValue = point (mControl);
+			if (mEdgeFalloff > 0.0)
+			{
+				if (controlValue < mLowerBoundMinusFalloff)
+					return point (mLeft);
+				else if (controlValue < mLowerBoundPlusFalloff)
+					return Math::InterpLinear (point (mLeft), point (mRight), Math::CubicCurve3 ((controlValue - mLowerBoundMinusFalloff) / mTwoEdgeFalloff));
+				else if (controlValue < mUpperBoundMinusFalloff)
+					return point (mRight);
+				else if (controlValue < mUpperBoundPlusFalloff)
+					return Math::InterpLinear (point (mRight), point (mLeft), Math::CubicCurve3 ((controlValue - mUpperBoundMinusFalloff) / mTwoEdgeFalloff));
+				return point (mLeft);
+			}
+			if (controlValue < mLowerBound || controlValue > mUpperBound)
+				return point (mLeft);
+			return point (mRight);
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			SelectModule *module = arena.create<SelectModule> ();
+			module->setSourceModule (0, mLeft.createModule (arena));
+			module->setSourceModule (1, mRight.createModule (arena));
+			module->setControlModule (mControl.createModule (arena));
+			module->setLowerBound (mLowerBound);
+			module->setUpperBound (mUpperBound);
+			module->setEdgeFalloff (mEdgeFalloff);
+			return module;
+		}
+};
+
+/// Source evaluated at scaled coordinates, see ScalePointModule.
+template <class E>
+class ScalePointExpression
+{
+	private:
+		E mSource;
+		Real mScaleX, mScaleY, mScaleZ;
+
+	public:
+		ScalePointExpression (const E &source, Real scaleX, Real scaleY, Real scaleZ) : mSource(source), mScaleX(scaleX), mScaleY(scaleY), mScaleZ(scaleZ) {}
+		NOISEPP_INLINE Real getValue (Real x) const
+		{
+			return mSource.getValue (x*mScaleX);
+		}
+		NOISEPP_INLINE Real getValue (Real x, Real y) const
+		{
+			return mSource.getValue (x*mScaleX, y*mScaleY);
+		}
+		NOISEPP_INLINE Real getValue (Real x, Real y, Real z) const
+		{
+			return mSource.getValue (x*mScaleX, y*mScaleY, z*mScaleZ);
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			ScalePointModule *module = arena.create<ScalePointModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			module->setScaleX (mScaleX);
+			module->setScaleY (mScaleY);
+			module->setScaleZ (mScaleZ);
+			return module;
+		}
+};
+
+/// Source evaluated at translated coordinates, see TranslatePointModule.
+template <class E>
+class TranslatePointExpression
+{
+	private:
+		E mSource;
+		Real mTranslationX, mTranslationY, mTranslationZ;
+
+	public:
+		TranslatePointExpression (const E &source, Real translationX, Real translationY, Real translationZ) :
+			mSource(source), mTranslationX(translationX), mTranslationY(translationY), mTranslationZ(translationZ) {}
+		NOISEPP_INLINE Real getValue (Real x) const
+		{
+			return mSource.getValue (x+mTranslationX);
+		}
+		NOISEPP_INLINE Real getValue (Real x, Real y) const
+		{
+			return mSource.getValue (x+mTranslationX, y+mTranslationY);
+		}
+		NOISEPP_INLINE Real getValue (Real x, Real y, Real z) const
+		{
+			return mSource.getValue (x+mTranslationX, y+mTranslationY, z+mTranslationZ);
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			TranslatePointModule *module = arena.create<TranslatePointModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			module->setTranslationX (mTranslationX);
+			module->setTranslationY (mTranslationY);
+			module->setTranslationZ (mTranslationZ);
+			return module;
+		}
+};
+
+/// Source evaluated at coordinates displaced by perlin noise, see TurbulenceModule.
+template <class E, int Roughness=3, int Quality=NOISE_QUALITY_STD>
+class TurbulenceExpression
+{
+	private:
+		E mSource;
+		Real mPower;
+		PerlinExpression<Roughness, Quality> mPerlinX;
+		PerlinExpression<Roughness, Quality> mPerlinY;
+		PerlinExpression<Roughness, Quality> mPerlinZ;
+
+	public:
+		TurbulenceExpression (const E &source, Real power) : mSource(source), mPower(power)
+		{
+			setSeed (0);
+		}
+		/// Sets the power.
+		TurbulenceExpression &setPower (Real v)
+		{
+			mPower = v;
+			return *this;
+		}
+		/// Sets the seed.
+		TurbulenceExpression &setSeed (int v)
+		{
+			mPerlinX.setSeed (v);
+			mPerlinY.setSeed (v+1);
+			mPerlinZ.setSeed (v+2);
+			return *this;
+		}
+		/// Sets the frequency.
+		TurbulenceExpression &setFrequency (Real v)
+		{
+			mPerlinX.setFrequency (v);
+			mPerlinY.setFrequency (v);
+			mPerlinZ.setFrequency (v);
+			return *this;
+		}
+		Real getValue (Real x) const
+		{
+			const Real x0 = x + Real(12414.0 / 65536.0);
+			const Real xFinal = x + (mPerlinX.getValue (x0) * mPower);
+			return mSource.getValue (xFinal);
+		}
+		Real getValue (Real x, Real y) const
+		{
+			const Real x0 = x + Real(12414.0 / 65536.0);
+			const Real y0 = y + Real(65124.0 / 65536.0);
+			const Real x1 = x + Real(26519.0 / 65536.0);
+			const Real y1 = y + Real(18128.0 / 65536.0);
+			const Real xFinal = x + (mPerlinX.getValue (x0, y0) * mPower);
+			const Real yFinal = y + (mPerlinY.getValue (x1, y1) * mPower);
+			return mSource.getValue (xFinal, yFinal);
+		}
+		Real getValue (Real x, Real y, Real z) const
+		{
+			const Real x0 = x + Real(12414.0 / 65536.0);
+			const Real y0 = y + Real(65124.0 / 65536.0);
+			const Real z0 = z + Real(31337.0 / 65536.0);
+			const Real x1 = x + Real(26519.0 / 65536.0);
+			const Real y1 = y + Real(18128.0 / 65536.0);
+			const Real z1 = z + Real(60493.0 / 65536.0);
+			const Real x2 = x + Real(53820.0 / 65536.0);
+			const Real y2 = y + Real(11213.0 / 65536.0);
+			const Real z2 = z + Real(44845.0 / 65536.0);
+			const Real xFinal = x + (mPerlinX.getValue (x0, y0, z0) * mPower);
+			const Real yFinal = y + (mPerlinY.getValue (x1, y1, z1) * mPower);
+			const Real zFinal = z + (mPerlinZ.getValue (x2, y2, z2) * mPower);
+			return mSource.getValue (xFinal, yFinal, zFinal);
+		}
+		/// Creates the equivalent module.
+		Module *createModule (ModuleArena &arena) const
+		{
+			TurbulenceModule *module = arena.create<TurbulenceModule> ();
+			module->setSourceModule (0, mSource.createModule (arena));
+			module->setPower (mPower);
+			module->setRoughness (Roughness);
+			module->setSeed (mPerlinX.getSeed ());
+			module->setFrequency (mPerlinX.getFrequency ());
+			module->setQuality (Quality);
+			return module;
+		}
+};
+
+/// Returns a perlin expression.
+template <int Octaves>
+inline PerlinExpression<Octaves> perlin ()
+{
+	return PerlinExpression<Octaves> ();
+}
+/// Returns a perlin expression of the specified quality.
+template <int Octaves, int Quality>
+inline PerlinExpression<Octaves, Quality> perlin ()
+{
+	return PerlinExpression<Octaves, Quality> ();
+}
+/// Returns a billow expression.
+template <int Octaves>
+inline BillowExpression<Octaves> billow ()
+{
+	return BillowExpression<Octaves> ();
+}
+/// Returns a billow expression of the specified quality.
+template <int Octaves, int Quality>
+inline BillowExpression<Octaves, Quality> billow ()
+{
+	return BillowExpression<Octaves, Quality> ();
+}
+/// Returns a ridged multifractal expression.
+template <int Octaves>
+inline RidgedMultiExpression<Octaves> ridgedMulti ()
+{
+	return RidgedMultiExpression<Octaves> ();
+}
+/// Returns a ridged multifractal expression of the specified quality.
+template <int Octaves, int Quality>
+inline RidgedMultiExpression<Octaves, Quality> ridgedMulti ()
+{
+	return RidgedMultiExpression<Octaves, Quality> ();
+}
+/// Returns a constant expression.
+inline ConstantExpression constant (Real value)
+{
+	return ConstantExpression (value);
+}
+/// Returns the absolute value of an expression.
+template <class E>
+inline AbsoluteExpression<E> absolute (const E &source)
+{
+	return AbsoluteExpression<E> (source);
+}
+/// Returns the negated value of an expression.
+template <class E>
+inline InvertExpression<E> invert (const E &source)
+{
+	return InvertExpression<E> (source);
+}
+/// Returns an expression clamped to the specified range.
+template <class E>
+inline ClampExpression<E> clamp (const E &source, Real lowerBound, Real upperBound)
+{
+	return ClampExpression<E> (source, lowerBound, upperBound);
+}
+/// Returns an expression mapped onto an exponential curve.
+template <class E>
+inline ExponentExpression<E> exponent (const E &source, Real exponent)
+{
+	return ExponentExpression<E> (source, exponent);
+}
+/// Returns a scaled and biased expression.
+template <class E>
+inline ScaleBiasExpression<E> scaleBias (const E &source, Real scale, Real bias)
+{
+	return ScaleBiasExpression<E> (source, scale, bias);
+}
+/// Returns the sum of two expressions.
+template <class L, class R>
+inline BinaryExpression<AdditionOperator, L, R> addition (const L &left, const R &right)
+{
+	return BinaryExpression<AdditionOperator, L, R> (left, right);
+}
+/// Returns the product of two expressions.
+template <class L, class R>
+inline BinaryExpression<MultiplyOperator, L, R> multiply (const L &left, const R &right)
+{
+	return BinaryExpression<MultiplyOperator, L, R> (left, right);
+}
+/// Returns the larger value of two expressions.
+template <class L, class R>
+inline BinaryExpression<MaximumOperator, L, R> maximum (const L &left, const R &right)
+{
+	return BinaryExpression<MaximumOperator, L, R> (left, right);
+}
+/// Returns the smaller value of two expressions.
+template <class L, class R>
+inline BinaryExpression<MinimumOperator, L, R> minimum (const L &left, const R &right)
+{
+	return BinaryExpression<MinimumOperator, L, R> (left, right);
+}
+/// Returns the left expression raised to the power of the right expression.
+template <class L, class R>
+inline BinaryExpression<PowerOperator, L, R> power (const L &left, const R &right)
+{
+	return BinaryExpression<PowerOperator, L, R> (left, right);
+}
+/// Returns two expressions blended by a control expression.
+template <class L, class R, class C>
+inline BlendExpression<L, R, C> blend (const L &left, const R &right, const C &control)
+{
+	return BlendExpression<L, R, C> (left, right, control);
+}
+/// Returns one of two expressions selected by a control expression.
+template <class L, class R, class C>
+inline SelectExpression<L, R, C> select (const L &left, const R &right, const C &control, Real lowerBound, Real upperBound, Real edgeFalloff=0.0)
+{
+	return SelectExpression<L, R, C> (left, right, control, lowerBound, upperBound, edgeFalloff);
+}
+/// Returns an expression evaluated at scaled coordinates.
+template <class E>
+inline ScalePointExpression<E> scalePoint (const E &source, Real scaleX, Real scaleY=1.0, Real scaleZ=1.0)
+{
+	return ScalePointExpression<E> (source, scaleX, scaleY, scaleZ);
+}
+/// Returns an expression evaluated at translated coordinates.
+template <class E>
+inline TranslatePointExpression<E> translatePoint (const E &source, Real translationX, Real translationY=0.0, Real translationZ=0.0)
+{
+	return TranslatePointExpression<E> (source, translationX, translationY, translationZ);
+}
+/// Returns an expression with turbulence of roughness 3.
+template <class E>
+inline TurbulenceExpression<E> turbulence (const E &source, Real power=1.0)
+{
+	return TurbulenceExpression<E> (source, power);
+}
+/// Returns an expression with turbulence of the specified roughness.
+template <int Roughness, class E>
+inline TurbulenceExpression<E, Roughness> turbulence (const E &source, Real power=1.0)
+{
+	return TurbulenceExpression<E, Roughness> (source, power);
+}
+/// Returns an expression with turbulence of the specified roughness and quality.
+template <int Roughness, int Quality, class E>
+inline TurbulenceExpression<E, Roughness, Quality> turbulence (const E &source, Real power=1.0)
+{
+	return TurbulenceExpression<E, Roughness, Quality> (source, power);
+}
+
+};
+};
+
+#endif // NOISEEXPRESSION_H
@@ -0,0 +1,82 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEFILEFORMAT_H
+#define NOISEFILEFORMAT_H
+
+#include <cstddef>
+
+/// The version of the pipeline file format written by default.
+#define NOISE_FILE_VERSION 2
+
+/// Version 2 files start with a 24 byte header:
+/// the version byte, 3 bytes padding and the little-endian 32-bit file size, module count, source count,
+/// offset of the parameter block and size of the parameter block.
+#define NOISE_FILE_V2_HEADER_SIZE 24
+/// The header is followed by a table with one 16 byte entry per module:
+/// 16-bit type ID, 16-bit source count, 32-bit index of the first source, 32-bit offset and size of the parameters.
+/// After the table come the 32-bit module IDs of all sources and the 8 byte aligned parameter block,
+/// which holds the fields of each module as written by Module::write(), each one 8 byte aligned.
+#define NOISE_FILE_V2_MODULE_SIZE 16
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Helpers for the little-endian fields of the version 2 pipeline file format.
+class FileFormat
+{
+	public:
+		/// Stores a 16-bit value.
+		static void writeLE16 (unsigned char *dest, unsigned short v)
+		{
+			dest[0] = (unsigned char)(v & 0xff);
+			dest[1] = (unsigned char)(v >> 8);
+		}
+		/// Stores a 32-bit value.
+		static void writeLE32 (unsigned char *dest, unsigned v)
+		{
+			dest[0] = (unsigned char)(v & 0xff);
+			dest[1] = (unsigned char)((v >> 8) & 0xff);
+			dest[2] = (unsigned char)((v >> 16) & 0xff);
+			dest[3] = (unsigned char)(v >> 24);
+		}
+		/// Loads a 16-bit value.
+		static unsigned short readLE16 (const unsigned char *src)
+		{
+			return (unsigned short)(src[0] | (src[1] << 8));
+		}
+		/// Loads a 32-bit value.
+		static unsigned readLE32 (const unsigned char *src)
+		{
+			return unsigned(src[0]) | (unsigned(src[1]) << 8) | (unsigned(src[2]) << 16) | (unsigned(src[3]) << 24);
+		}
+};
+
+};
+};
+
+#endif // NOISEFILEFORMAT_H
@@ -24,6 +24,7 @@
 //
 
 #include "NoiseGradientRenderer.h"
+#include <cstring>
 #include "NoiseSystem.h"
 
 namespace noisepp
@@ -31,7 +32,7 @@ namespace noisepp
 namespace utils
 {
 
-GradientRenderer::GradientRenderer() : mCallback(0)
+GradientRenderer::GradientRenderer() : mCallback(0), mLookupTableSize(0), mLookupOffset(0), mLookupScale(0)
 {
 }
 
@@ -49,11 +50,15 @@ void GradientRenderer::renderImage (Image &image, const Real *data, JobQueue *jo
 	NoiseAssert (mGradients.size() >= 2, mGradients);
 	if (!jobQueue)
 		jobQueue = System::createOptimalJobQueue();
-	unsigned char *buffer = image.getPixelData ();
+	const PixelFormat format = image.getFormat ();
+	if (mLookupTableSize > 0)
+		bakeLookupTable (format);
+	else
+		mLookupTable.clear ();
 	int width = image.getWidth();
 	for (int y=0;y<image.getHeight();++y)
 	{
-		jobQueue->addJob (new GradientRendererJob(this, width, data+(y*width), buffer+(y*width*3)));
+		jobQueue->addJob (new GradientRendererJob(this, width, data+(y*width), image.getRowData(y), format));
 	}
 	jobQueue->executeJobs();
 	if (mCallback)
@@ -62,6 +67,52 @@ void GradientRenderer::renderImage (Image &image, const Real *data, JobQueue *jo
 	jobQueue = 0;
 }
 
+void GradientRenderer::setLookupTableSize (int size)
+{
+	NoiseAssert (size >= 0, size);
+	mLookupTableSize = size;
+}
+
+int GradientRenderer::getLookupTableSize () const
+{
+	return mLookupTableSize;
+}
+
+ColourValue GradientRenderer::getColour (Real value) const
+{
+	size_t n;
+	for (n=0;n<mGradients.size();++n)
+	{
+		if (mGradients[n].value > value)
+			break;
+	}
+	if (n == 0)
+		return mGradients.front().color;
+	if (n == mGradients.size())
+		return mGradients.back().color;
+	const Gradient &left = mGradients[n-1];
+	const Gradient &right = mGradients[n];
+	const float a = (float)((value - left.value) / (right.value - left.value));
+	return left.color * (1.0f-a) + right.color * a;
+}
+
+void GradientRenderer::bakeLookupTable (PixelFormat format)
+{
+	// the table spans the gradient points, values outside are clamped to the end colours
+	const Real lower = mGradients.front().value;
+	const Real upper = mGradients.back().value;
+	const int size = mLookupTableSize;
+	mLookupTable.resize (size_t(size) * Image::getBytesPerPixel(format));
+	mLookupOffset = -lower;
+	mLookupScale = (size > 1 && upper > lower) ? Real(size - 1) / (upper - lower) : Real(0.0);
+	unsigned char *entry = &mLookupTable[0];
+	for (int i=0;i<size;++i)
+	{
+		const Real value = (size > 1) ? lower + (upper - lower) * Real(i) / Real(size - 1) : lower;
+		Image::writeColour (entry, format, getColour (value));
+	}
+}
+
 void GradientRenderer::setCallback(BuilderCallback *callback)
 {
 	if (mCallback)
@@ -78,37 +129,51 @@ GradientRenderer::~GradientRenderer()
 	}
 }
 
-GradientRenderer::GradientRendererJob::GradientRendererJob(GradientRenderer *renderer, int width, const Real *data, unsigned char *buffer) :
-	renderer(renderer), width(width), data(data), buffer(buffer)
+GradientRenderer::GradientRendererJob::GradientRendererJob(GradientRenderer *renderer, int width, const Real *data, unsigned char *buffer, PixelFormat format) :
+	renderer(renderer), width(width), data(data), buffer(buffer), format(format)
 {
 	assert (renderer);
 }
 
 void GradientRenderer::GradientRendererJob::execute ()
 {
-	size_t n;
+	if (!renderer->mLookupTable.empty())
+	{
+		executeLookup ();
+		return;
+	}
 	for (int x=0;x<width;++x)
 	{
-		Real value = *data++;
-		ColourValue color = renderer->mGradients.front().color;
-		for (n=0;n<renderer->mGradients.size();++n)
+		Image::writeColour (buffer, format, renderer->getColour (*data++));
+	}
+}
+
+void GradientRenderer::GradientRendererJob::executeLookup ()
+{
+	int indices[PIPELINE_BATCH_SIZE];
+	const unsigned char *table = &renderer->mLookupTable[0];
+	const Real offset = renderer->mLookupOffset;
+	const Real scale = renderer->mLookupScale;
+	const Real last = Real(renderer->mLookupTableSize - 1);
+	const int bytesPerPixel = Image::getBytesPerPixel (format);
+	for (int x0=0;x0<width;x0+=int(PIPELINE_BATCH_SIZE))
+	{
+		const int count = (width - x0) < int(PIPELINE_BATCH_SIZE) ? (width - x0) : int(PIPELINE_BATCH_SIZE);
+		// clamp and scale, written so that the loop vectorizes and NaN maps to the last entry like in getColour()
+		for (int i=0;i<count;++i)
 		{
-			if (renderer->mGradients[n].value > value)
-				break;
+			Real t = (data[x0+i] + offset) * scale + Real(0.5);
+			t = (t < last) ? t : last;
+			t = (t > Real(0.0)) ? t : Real(0.0);
+			indices[i] = int(t) * bytesPerPixel;
 		}
-		if (n < renderer->mGradients.size())
+		// gather and store
+		unsigned char *out = buffer + x0 * bytesPerPixel;
+		for (int i=0;i<count;++i)
 		{
-			if (n > 0)
-			{
-				const Gradient &left = renderer->mGradients[n-1];
-				const Gradient &right = renderer->mGradients[n];
-				const float a = (float)((value - left.value) / (right.value - left.value));
-				color = left.color * (1.0f-a) + right.color * a;
-			}
+			memcpy (out, table + indices[i], bytesPerPixel);
+			out += bytesPerPixel;
 		}
-		else
-			color = renderer->mGradients.back().color;
-		color.writeRGB (buffer);
 	}
 }
 
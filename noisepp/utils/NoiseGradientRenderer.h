@@ -48,10 +48,19 @@ class GradientRenderer
 		/// @param color Color value of the gradient point.
 		void addGradient (Real value, const ColourValue &color);
 		/// Renders the data to an image.
+		/// Colours are written in the pixel format of the image, single channel formats receive the luminance.
 		/// @param image The image to render to.
 		/// @param data The source data.
 		/// @param jobQueue A pointer to a JobQueue. The JobQueue will be deleted after usage. Passing NULL will use an system optimal queue.
 		void renderImage (Image &image, const Real *data, JobQueue *jobQueue=0);
+		/// Sets the number of entries of the baked colour lookup table (default 0).
+		/// If the size is greater than zero, renderImage() bakes the gradient into a table of pixels in the image format
+		/// spanning the gradient points once and maps each value to its nearest entry,
+		/// which is a lot faster than interpolating the colours per pixel. 4096 entries are plenty for 8-bit output.
+		/// Passing 0 disables the table.
+		void setLookupTableSize (int size);
+		/// Returns the number of entries of the baked colour lookup table.
+		int getLookupTableSize () const;
 		/// Sets a callback
 		void setCallback (BuilderCallback *callback);
 		/// Destructor.
@@ -70,6 +79,11 @@ class GradientRenderer
 		typedef std::vector<Gradient> GradientVector;
 		GradientVector mGradients;
 		BuilderCallback *mCallback;
+		int mLookupTableSize;
+		std::vector<unsigned char> mLookupTable;
+		Real mLookupOffset, mLookupScale;
+		ColourValue getColour (Real value) const;
+		void bakeLookupTable (PixelFormat format);
 		class GradientRendererJob : public Job
 		{
 			private:
@@ -77,10 +91,12 @@ class GradientRenderer
 				int width;
 				const Real *data;
 				unsigned char *buffer;
+				PixelFormat format;
 
 			public:
-				GradientRendererJob(GradientRenderer *renderer, int width, const Real *data, unsigned char *buffer);
+				GradientRendererJob(GradientRenderer *renderer, int width, const Real *data, unsigned char *buffer, PixelFormat format);
 				void execute ();
+				void executeLookup ();
 				void finish ();
 		};
 };
@@ -0,0 +1,86 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseGraphHash.h"
+#include "NoiseWriter.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+GraphHash::GraphHash () : mValue(14695981039346656037ULL)
+{
+}
+
+void GraphHash::add (const void *data, size_t size)
+{
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+	Value value = mValue;
+	for (size_t i=0;i<size;++i)
+	{
+		value ^= bytes[i];
+		value *= 1099511628211ULL;
+	}
+	mValue = value;
+}
+
+void GraphHash::addInt (int v)
+{
+	unsigned char bytes[4];
+	FileFormat::writeLE32 (bytes, unsigned(v));
+	add (bytes, sizeof(bytes));
+}
+
+void GraphHash::addReal (Real v)
+{
+	const double d = v;
+	unsigned long long bits;
+	std::memcpy (&bits, &d, sizeof(bits));
+	unsigned char bytes[8];
+	FileFormat::writeLE32 (bytes, unsigned(bits & 0xffffffffULL));
+	FileFormat::writeLE32 (bytes+4, unsigned(bits >> 32));
+	add (bytes, sizeof(bytes));
+}
+
+void GraphHash::addModule (const Module &module)
+{
+	// the writer's version 2 output is a fixed little-endian layout of the whole graph
+	MemoryOutStream stream;
+	Writer writer(stream);
+	writer.addModule (module);
+	writer.writePipeline (2);
+	add (stream.getBuffer (), stream.getBufferSize ());
+}
+
+GraphHash::Value GraphHash::calcModuleHash (const Module &module)
+{
+	GraphHash hash;
+	hash.addModule (module);
+	return hash.getValue ();
+}
+
+};
+};
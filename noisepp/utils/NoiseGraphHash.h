@@ -0,0 +1,72 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEGRAPHHASH_H
+#define NOISEGRAPHHASH_H
+
+#include "NoisePrerequisites.h"
+#include "NoiseModule.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Stable 64-bit hash (FNV-1a) of module graphs and build parameters.
+/// Module graphs are hashed over their serialized form as written by the Writer, which covers the module types,
+/// all parameters and the topology, and doesn't depend on the platform or the Real type.
+/// Modules with equal settings hash equally across runs, so the hash can be used as a cache key.
+class GraphHash
+{
+	public:
+		/// Hash value type.
+		typedef unsigned long long Value;
+
+		/// Constructor.
+		GraphHash ();
+		/// Adds raw bytes.
+		void add (const void *data, size_t size);
+		/// Adds an integer.
+		void addInt (int v);
+		/// Adds a real value, hashed as little-endian double.
+		void addReal (Real v);
+		/// Adds a module and all its source modules.
+		void addModule (const Module &module);
+		/// Returns the hash value.
+		Value getValue () const
+		{
+			return mValue;
+		}
+		/// Returns the hash value of a module graph.
+		static Value calcModuleHash (const Module &module);
+	protected:
+	private:
+		Value mValue;
+};
+
+};
+};
+
+#endif // NOISEGRAPHHASH_H
@@ -0,0 +1,154 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseHeightmapExporter.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace noisepp
+{
+namespace utils
+{
+
+HeightmapExporter::HeightmapExporter() : mFormat(FORMAT_RAW16), mLowerBound(-1.0), mUpperBound(1.0), mBigEndian(false)
+{
+}
+
+void HeightmapExporter::setFormat (Format format)
+{
+	mFormat = format;
+}
+
+HeightmapExporter::Format HeightmapExporter::getFormat () const
+{
+	return mFormat;
+}
+
+void HeightmapExporter::setRange (Real lower, Real upper)
+{
+	NoiseAssert (lower < upper, lower);
+	mLowerBound = lower;
+	mUpperBound = upper;
+}
+
+Real HeightmapExporter::getLowerBound () const
+{
+	return mLowerBound;
+}
+
+Real HeightmapExporter::getUpperBound () const
+{
+	return mUpperBound;
+}
+
+void HeightmapExporter::setBigEndian (bool v)
+{
+	mBigEndian = v;
+}
+
+bool HeightmapExporter::isBigEndian () const
+{
+	return mBigEndian;
+}
+
+bool HeightmapExporter::save (const char *filename, const Real *data, int width, int height) const
+{
+	FileOutStream stream(filename);
+	if (!stream.isOpen())
+		return false;
+	write (stream, data, width, height);
+	stream.close ();
+	return true;
+}
+
+void HeightmapExporter::write (OutStream &stream, const Real *data, int width, int height) const
+{
+	NoiseAssert (data != NULL, data);
+	NoiseAssert (width > 0, width);
+	NoiseAssert (height > 0, height);
+
+	const bool pgm = (mFormat == FORMAT_PGM16);
+	const bool bigEndian = pgm || mBigEndian;
+	if (pgm)
+	{
+		char header[64];
+		const int len = std::sprintf (header, "P5\n%d %d\n65535\n", width, height);
+		stream.write (header, len);
+	}
+
+	// the bytes are assembled explicitly, so the output doesn't depend on the byte order of the host
+	const int bytesPerValue = (mFormat == FORMAT_RAW32F) ? 4 : 2;
+	const size_t rowSize = size_t(width) * bytesPerValue;
+	std::vector<unsigned char> row(rowSize);
+	unsigned char *dest = &row[0];
+	const Real scale = Real(65535.0) / (mUpperBound - mLowerBound);
+	for (int y=0;y<height;++y)
+	{
+		const Real *src = data + size_t(y) * width;
+		if (bytesPerValue == 2)
+		{
+			const int hi = bigEndian ? 0 : 1;
+			const int lo = 1 - hi;
+			for (int x=0;x<width;++x)
+			{
+				Real t = (src[x] - mLowerBound) * scale + Real(0.5);
+				t = (t > Real(0.0)) ? t : Real(0.0);
+				t = (t < Real(65535.0)) ? t : Real(65535.0);
+				const unsigned v = unsigned(t);
+				dest[x*2+hi] = (unsigned char)(v >> 8);
+				dest[x*2+lo] = (unsigned char)(v & 0xff);
+			}
+		}
+		else
+		{
+			for (int x=0;x<width;++x)
+			{
+				const float f = float(src[x]);
+				unsigned v;
+				std::memcpy (&v, &f, sizeof(v));
+				unsigned char *out = dest + x*4;
+				if (bigEndian)
+				{
+					out[0] = (unsigned char)(v >> 24);
+					out[1] = (unsigned char)(v >> 16);
+					out[2] = (unsigned char)(v >> 8);
+					out[3] = (unsigned char)v;
+				}
+				else
+				{
+					out[0] = (unsigned char)v;
+					out[1] = (unsigned char)(v >> 8);
+					out[2] = (unsigned char)(v >> 16);
+					out[3] = (unsigned char)(v >> 24);
+				}
+			}
+		}
+		stream.write (dest, rowSize);
+	}
+}
+
+};
+};
@@ -0,0 +1,95 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEHEIGHTMAPEXPORTER_H
+#define NOISEHEIGHTMAPEXPORTER_H
+
+#include "NoisePrerequisites.h"
+#include "NoiseOutStream.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Heightmap exporter.
+/// Writes the output of a builder as raw 16-bit, 16-bit PGM or raw 32-bit float data.
+/// The values are converted row by row and written in whole blocks.
+class HeightmapExporter
+{
+	public:
+		/// Output formats.
+		enum Format
+		{
+			/// Headerless unsigned 16-bit values.
+			FORMAT_RAW16,
+			/// Binary greyscale portable graymap (P5) with 16-bit values.
+			FORMAT_PGM16,
+			/// Headerless 32-bit floating point values, unscaled.
+			FORMAT_RAW32F
+		};
+
+		/// Constructor.
+		HeightmapExporter();
+		/// Sets the output format (default FORMAT_RAW16).
+		void setFormat (Format format);
+		/// Returns the output format.
+		Format getFormat () const;
+		/// Sets the range of values mapped to [0, 65535] by the 16-bit formats (default -1.0 to 1.0).
+		/// Values outside the range are clamped.
+		void setRange (Real lower, Real upper);
+		/// Returns the lower bound of the range.
+		Real getLowerBound () const;
+		/// Returns the upper bound of the range.
+		Real getUpperBound () const;
+		/// Sets the byte order of the raw formats (default little endian).
+		/// PGM files are always big endian.
+		void setBigEndian (bool v=true);
+		/// Returns true if the raw formats are written big endian.
+		bool isBigEndian () const;
+		/// Writes the data to the specified file.
+		/// @param filename The name of the output file.
+		/// @param data The source data, as filled by a builder.
+		/// @param width The width of the data.
+		/// @param height The height of the data.
+		/// Returns false if the file can't be opened.
+		bool save (const char *filename, const Real *data, int width, int height) const;
+		/// Writes the data to a stream.
+		/// @param stream The output stream.
+		/// @param data The source data, as filled by a builder.
+		/// @param width The width of the data.
+		/// @param height The height of the data.
+		void write (OutStream &stream, const Real *data, int width, int height) const;
+	protected:
+	private:
+		Format mFormat;
+		Real mLowerBound, mUpperBound;
+		bool mBigEndian;
+};
+
+};
+};
+
+#endif // NOISEHEIGHTMAPEXPORTER_H
@@ -0,0 +1,229 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseHeightmapRenderer.h"
+#include "NoiseSystem.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+HeightmapRenderer::HeightmapRenderer() : mHeightScale(1.0), mSpacingX(1.0), mSpacingY(1.0), mSeamless(false), mCallback(0)
+{
+}
+
+void HeightmapRenderer::renderImage (Image &image, const Real *data, JobQueue *jobQueue)
+{
+	NoiseAssert (data != NULL, data);
+	NoiseAssert (isFormatSupported(image.getFormat()), image);
+	if (!jobQueue)
+		jobQueue = System::createOptimalJobQueue();
+	const PixelFormat format = image.getFormat ();
+	const int width = image.getWidth();
+	const int height = image.getHeight();
+	for (int y=0;y<height;++y)
+	{
+		// the rows above and below are clamped or wrapped at the borders
+		int above = y - 1;
+		int below = y + 1;
+		Real distance = 2.0;
+		if (above < 0)
+		{
+			if (mSeamless)
+				above = height - 1;
+			else
+			{
+				above = y;
+				distance -= Real(1.0);
+			}
+		}
+		if (below >= height)
+		{
+			if (mSeamless)
+				below = 0;
+			else
+			{
+				below = y;
+				distance -= Real(1.0);
+			}
+		}
+		const Real invDeltaY = (distance > Real(0.0)) ? Real(1.0) / (distance * mSpacingY) : Real(0.0);
+		jobQueue->addJob (new HeightmapRendererJob(this, width, data+(y*width), data+(above*width), data+(below*width), invDeltaY, image.getRowData(y), format));
+	}
+	jobQueue->executeJobs();
+	if (mCallback)
+		mCallback->reset ();
+	delete jobQueue;
+	jobQueue = 0;
+}
+
+void HeightmapRenderer::renderGradientImage (Image &image, const Real *gradientX, const Real *gradientY, JobQueue *jobQueue)
+{
+	NoiseAssert (gradientX != NULL, gradientX);
+	NoiseAssert (gradientY != NULL, gradientY);
+	NoiseAssert (isFormatSupported(image.getFormat()), image);
+	if (!jobQueue)
+		jobQueue = System::createOptimalJobQueue();
+	const PixelFormat format = image.getFormat ();
+	const int width = image.getWidth();
+	for (int y=0;y<image.getHeight();++y)
+	{
+		jobQueue->addJob (new HeightmapRendererJob(this, width, gradientX+(y*width), gradientY+(y*width), image.getRowData(y), format));
+	}
+	jobQueue->executeJobs();
+	if (mCallback)
+		mCallback->reset ();
+	delete jobQueue;
+	jobQueue = 0;
+}
+
+void HeightmapRenderer::setHeightScale (Real scale)
+{
+	mHeightScale = scale;
+}
+
+Real HeightmapRenderer::getHeightScale () const
+{
+	return mHeightScale;
+}
+
+void HeightmapRenderer::setSpacing (Real spacingX, Real spacingY)
+{
+	NoiseAssert (spacingX > Real(0.0), spacingX);
+	NoiseAssert (spacingY > Real(0.0), spacingY);
+	mSpacingX = spacingX;
+	mSpacingY = spacingY;
+}
+
+Real HeightmapRenderer::getSpacingX () const
+{
+	return mSpacingX;
+}
+
+Real HeightmapRenderer::getSpacingY () const
+{
+	return mSpacingY;
+}
+
+void HeightmapRenderer::setSeamless (bool v)
+{
+	mSeamless = v;
+}
+
+bool HeightmapRenderer::isSeamless () const
+{
+	return mSeamless;
+}
+
+void HeightmapRenderer::setCallback(BuilderCallback *callback)
+{
+	if (mCallback)
+		delete mCallback;
+	mCallback = callback;
+}
+
+HeightmapRenderer::~HeightmapRenderer()
+{
+	if (mCallback)
+	{
+		delete mCallback;
+		mCallback = 0;
+	}
+}
+
+HeightmapRenderer::HeightmapRendererJob::HeightmapRendererJob(const HeightmapRenderer *renderer, int width, const Real *row, const Real *rowAbove, const Real *rowBelow, Real invDeltaY, unsigned char *buffer, PixelFormat format) :
+	renderer(renderer), width(width), row(row), rowAbove(rowAbove), rowBelow(rowBelow), invDeltaY(invDeltaY), gradientX(0), gradientY(0), buffer(buffer), format(format)
+{
+	assert (renderer);
+}
+
+HeightmapRenderer::HeightmapRendererJob::HeightmapRendererJob(const HeightmapRenderer *renderer, int width, const Real *gradientX, const Real *gradientY, unsigned char *buffer, PixelFormat format) :
+	renderer(renderer), width(width), row(0), rowAbove(0), rowBelow(0), invDeltaY(0), gradientX(gradientX), gradientY(gradientY), buffer(buffer), format(format)
+{
+	assert (renderer);
+}
+
+Real HeightmapRenderer::HeightmapRendererJob::calcBorderGradient (int x, Real invDeltaX) const
+{
+	if (width < 2)
+		return Real(0.0);
+	if (renderer->mSeamless)
+	{
+		const int left = (x > 0) ? x - 1 : width - 1;
+		const int right = (x < width - 1) ? x + 1 : 0;
+		return (row[right] - row[left]) * invDeltaX;
+	}
+	// one-sided difference over a single pixel
+	if (x == 0)
+		return (row[1] - row[0]) * invDeltaX * Real(2.0);
+	return (row[x] - row[x-1]) * invDeltaX * Real(2.0);
+}
+
+void HeightmapRenderer::HeightmapRendererJob::execute ()
+{
+	if (!row)
+	{
+		renderer->shadeSpan (gradientX, gradientY, width, buffer, format);
+		return;
+	}
+
+	Real dx[PIPELINE_BATCH_SIZE];
+	Real dy[PIPELINE_BATCH_SIZE];
+	const Real invDeltaX = Real(1.0) / (Real(2.0) * renderer->mSpacingX);
+	for (int x0=0;x0<width;x0+=int(PIPELINE_BATCH_SIZE))
+	{
+		const int count = (width - x0) < int(PIPELINE_BATCH_SIZE) ? (width - x0) : int(PIPELINE_BATCH_SIZE);
+		const Real *center = row + x0;
+		const Real *above = rowAbove + x0;
+		const Real *below = rowBelow + x0;
+		// plain loops over the interior, which the compiler can vectorize
+		const int begin = (x0 == 0) ? 1 : 0;
+		const int end = (x0 + count == width) ? count - 1 : count;
+		for (int i=begin;i<end;++i)
+		{
+			dx[i] = (center[i+1] - center[i-1]) * invDeltaX;
+		}
+		for (int i=0;i<count;++i)
+		{
+			dy[i] = (below[i] - above[i]) * invDeltaY;
+		}
+		// the borders
+		if (x0 == 0)
+			dx[0] = calcBorderGradient (0, invDeltaX);
+		if (x0 + count == width)
+			dx[count-1] = calcBorderGradient (width-1, invDeltaX);
+		renderer->shadeSpan (dx, dy, count, buffer+(x0*Image::getBytesPerPixel(format)), format);
+	}
+}
+
+void HeightmapRenderer::HeightmapRendererJob::finish ()
+{
+	if (renderer->mCallback)
+		renderer->mCallback->callback ();
+}
+
+};
+};
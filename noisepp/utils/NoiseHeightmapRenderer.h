@@ -0,0 +1,133 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEHEIGHTMAPRENDERER_H
+#define NOISEHEIGHTMAPRENDERER_H
+
+#include "NoisePrerequisites.h"
+#include "NoiseImage.h"
+#include "NoiseBuilders.h"
+#include "NoiseJobQueue.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Base class for renderers which shade a heightmap by its surface normals.
+/// The normals are calculated row by row with central differences of the heightmap,
+/// or taken from analytic gradients like the ones PlaneBuilder2D::setGradientDestination() produces.
+/// The borders use one-sided differences, or wrap around for seamless heightmaps.
+class HeightmapRenderer
+{
+	public:
+		/// Constructor.
+		HeightmapRenderer();
+		/// Renders the heightmap to an image.
+		/// The normals are calculated with central differences.
+		/// @param image The image to render to.
+		/// @param data The heightmap, it must have the same size as the image.
+		/// @param jobQueue A pointer to a JobQueue. The JobQueue will be deleted after usage. Passing NULL will use an system optimal queue.
+		void renderImage (Image &image, const Real *data, JobQueue *jobQueue=0);
+		/// Renders the heightmap to an image using analytic gradients.
+		/// @param image The image to render to.
+		/// @param gradientX The partial derivatives along the x-axis in height units per world unit.
+		/// @param gradientY The partial derivatives along the y-axis in height units per world unit.
+		/// @param jobQueue A pointer to a JobQueue. The JobQueue will be deleted after usage. Passing NULL will use an system optimal queue.
+		void renderGradientImage (Image &image, const Real *gradientX, const Real *gradientY, JobQueue *jobQueue=0);
+		/// Sets the factor the heights are scaled with before the normals are calculated (default 1.0).
+		void setHeightScale (Real scale);
+		/// Returns the height scale.
+		Real getHeightScale () const;
+		/// Sets the distance between two pixels in world units (default 1.0).
+		/// This is used to convert the central differences into gradients.
+		void setSpacing (Real spacingX, Real spacingY);
+		/// Returns the distance between two pixels along the x-axis.
+		Real getSpacingX () const;
+		/// Returns the distance between two pixels along the y-axis.
+		Real getSpacingY () const;
+		/// Enables or disables wrapping around at the borders for seamless heightmaps.
+		void setSeamless (bool v=true);
+		/// Returns if wrapping around at the borders is enabled.
+		bool isSeamless () const;
+		/// Sets a callback
+		void setCallback (BuilderCallback *callback);
+		/// Destructor.
+		virtual ~HeightmapRenderer();
+	protected:
+		/// Writes the pixels of a span.
+		/// @param gradientX The partial derivatives along the x-axis.
+		/// @param gradientY The partial derivatives along the y-axis.
+		/// @param count The number of pixels.
+		/// @param buffer A pointer to the pixel data.
+		/// @param format The pixel format of the image.
+		virtual void shadeSpan (const Real *gradientX, const Real *gradientY, int count, unsigned char *buffer, PixelFormat format) const = 0;
+		/// Returns true if the renderer can write the specified pixel format.
+		virtual bool isFormatSupported (PixelFormat format) const
+		{
+			return true;
+		}
+		/// Calculates the unit normal for the specified gradient.
+		NOISEPP_INLINE void calcNormal (Real gradientX, Real gradientY, Real &nx, Real &ny, Real &nz) const
+		{
+			nx = -gradientX * mHeightScale;
+			ny = -gradientY * mHeightScale;
+			const Real invLength = Real(1.0) / std::sqrt (nx * nx + ny * ny + Real(1.0));
+			nx *= invLength;
+			ny *= invLength;
+			nz = invLength;
+		}
+	private:
+		Real mHeightScale;
+		Real mSpacingX, mSpacingY;
+		bool mSeamless;
+		BuilderCallback *mCallback;
+		class HeightmapRendererJob : public Job
+		{
+			private:
+				const HeightmapRenderer *renderer;
+				int width;
+				const Real *row;
+				const Real *rowAbove;
+				const Real *rowBelow;
+				Real invDeltaY;
+				const Real *gradientX;
+				const Real *gradientY;
+				unsigned char *buffer;
+				PixelFormat format;
+
+			public:
+				HeightmapRendererJob(const HeightmapRenderer *renderer, int width, const Real *row, const Real *rowAbove, const Real *rowBelow, Real invDeltaY, unsigned char *buffer, PixelFormat format);
+				HeightmapRendererJob(const HeightmapRenderer *renderer, int width, const Real *gradientX, const Real *gradientY, unsigned char *buffer, PixelFormat format);
+				Real calcBorderGradient (int x, Real invDeltaX) const;
+				void execute ();
+				void finish ();
+		};
+};
+
+};
+};
+
+#endif // NOISEHEIGHTMAPRENDERER_H
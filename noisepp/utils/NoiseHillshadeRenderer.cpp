@@ -0,0 +1,132 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseHillshadeRenderer.h"
+#include "NoiseColourValue.h"
+#include <cstring>
+
+namespace noisepp
+{
+namespace utils
+{
+
+HillshadeRenderer::HillshadeRenderer() : mAmbient(0.2), mModulate(false)
+{
+	setLightDirection (315.0, 45.0);
+}
+
+void HillshadeRenderer::setLightDirection (Real azimuth, Real elevation)
+{
+	const Real degToRad = Real(3.14159265358979323846 / 180.0);
+	mAzimuth = azimuth;
+	mElevation = elevation;
+	const Real horizontal = std::cos (elevation * degToRad);
+	mLightX = std::sin (azimuth * degToRad) * horizontal;
+	mLightY = -std::cos (azimuth * degToRad) * horizontal;
+	mLightZ = std::sin (elevation * degToRad);
+}
+
+Real HillshadeRenderer::getLightAzimuth () const
+{
+	return mAzimuth;
+}
+
+Real HillshadeRenderer::getLightElevation () const
+{
+	return mElevation;
+}
+
+void HillshadeRenderer::setAmbient (Real ambient)
+{
+	mAmbient = ambient;
+}
+
+Real HillshadeRenderer::getAmbient () const
+{
+	return mAmbient;
+}
+
+void HillshadeRenderer::setModulate (bool v)
+{
+	mModulate = v;
+}
+
+bool HillshadeRenderer::isModulateEnabled () const
+{
+	return mModulate;
+}
+
+void HillshadeRenderer::shadeSpan (const Real *gradientX, const Real *gradientY, int count, unsigned char *buffer, PixelFormat format) const
+{
+	Real nx, ny, nz;
+	for (int i=0;i<count;++i)
+	{
+		calcNormal (gradientX[i], gradientY[i], nx, ny, nz);
+		Real lambert = nx * mLightX + ny * mLightY + nz * mLightZ;
+		if (lambert < Real(0.0))
+			lambert = Real(0.0);
+		const float shade = float(mAmbient + (Real(1.0) - mAmbient) * lambert);
+		if (!mModulate)
+		{
+			Image::writeValue (buffer, format, shade);
+			continue;
+		}
+		switch (format)
+		{
+			case PIXELFORMAT_RGB8:
+			case PIXELFORMAT_RGBA8:
+				for (int c=0;c<3;++c)
+				{
+					*buffer = ColourValue::toUChar (float(*buffer) / 255.0f * shade);
+					++buffer;
+				}
+				// alpha is kept
+				if (format == PIXELFORMAT_RGBA8)
+					++buffer;
+				break;
+			case PIXELFORMAT_R16:
+			{
+				unsigned short v;
+				memcpy (&v, buffer, sizeof(v));
+				v = (unsigned short)(v * shade + 0.5f);
+				memcpy (buffer, &v, sizeof(v));
+				buffer += sizeof(v);
+				break;
+			}
+			case PIXELFORMAT_R32F:
+			{
+				float v;
+				memcpy (&v, buffer, sizeof(v));
+				v *= shade;
+				memcpy (buffer, &v, sizeof(v));
+				buffer += sizeof(v);
+				break;
+			}
+		}
+	}
+}
+
+};
+};
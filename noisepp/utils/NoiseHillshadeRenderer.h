@@ -0,0 +1,74 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEHILLSHADERENDERER_H
+#define NOISEHILLSHADERENDERER_H
+
+#include "NoiseHeightmapRenderer.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Hillshade renderer.
+/// Lights a heightmap with a directional light using Lambert shading.
+/// The shade can overwrite the image with grey values or modulate the existing colours,
+/// for example the output of a GradientRenderer.
+class HillshadeRenderer : public HeightmapRenderer
+{
+	public:
+		/// Constructor.
+		HillshadeRenderer();
+		/// Sets the direction of the light.
+		/// @param azimuth The azimuth in degrees, measured clockwise from the negative y-axis (default 315, top left).
+		/// @param elevation The elevation above the horizon in degrees (default 45).
+		void setLightDirection (Real azimuth, Real elevation);
+		/// Returns the azimuth of the light in degrees.
+		Real getLightAzimuth () const;
+		/// Returns the elevation of the light in degrees.
+		Real getLightElevation () const;
+		/// Sets the brightness of surfaces facing away from the light (default 0.2).
+		void setAmbient (Real ambient);
+		/// Returns the ambient brightness.
+		Real getAmbient () const;
+		/// Enables or disables modulating the existing image colours instead of overwriting them.
+		void setModulate (bool v=true);
+		/// Returns if modulating the existing image colours is enabled.
+		bool isModulateEnabled () const;
+	protected:
+		/// @copydoc noisepp::utils::HeightmapRenderer::shadeSpan()
+		virtual void shadeSpan (const Real *gradientX, const Real *gradientY, int count, unsigned char *buffer, PixelFormat format) const;
+	private:
+		Real mAzimuth, mElevation;
+		Real mLightX, mLightY, mLightZ;
+		Real mAmbient;
+		bool mModulate;
+};
+
+};
+};
+
+#endif // NOISEHILLSHADERENDERER_H
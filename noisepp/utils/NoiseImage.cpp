@@ -25,35 +25,118 @@
 
 #include "NoiseImage.h"
 #include "NoiseOutStream.h"
+#include <cstring>
+#include <vector>
 
 namespace noisepp
 {
 namespace utils
 {
 
-Image::Image() : mData(0), mWidth(0), mHeight(0)
+Image::Image() : mBuffer(0), mData(0), mWidth(0), mHeight(0), mFormat(PIXELFORMAT_RGB8), mBytesPerPixel(3), mPitch(0)
 {
 }
 
-void Image::create (int width, int height)
+void Image::create (int width, int height, PixelFormat format, int rowAlignment)
 {
 	NoiseAssert (width > 0, width);
 	NoiseAssert (height > 0, height);
+	NoiseAssert (rowAlignment > 0 && (rowAlignment & (rowAlignment - 1)) == 0, rowAlignment);
+	clear ();
 	mWidth = width;
 	mHeight = height;
+	mFormat = format;
+	mBytesPerPixel = getBytesPerPixel (format);
 
-	mData = new unsigned char [mWidth*mHeight*3];
+	// the pitch is a multiple of the alignment, so aligning the first row aligns all of them
+	const size_t alignment = size_t(rowAlignment);
+	mPitch = (size_t(mWidth) * mBytesPerPixel + alignment - 1) & ~(alignment - 1);
+	mBuffer = new unsigned char [mPitch*mHeight + alignment - 1];
+	mData = (unsigned char *)(((size_t)mBuffer + alignment - 1) & ~(alignment - 1));
 }
 
 void Image::clear ()
 {
-	if (mData)
+	if (mBuffer)
 	{
-		delete[] mData;
-		mData = 0;
+		delete[] mBuffer;
+		mBuffer = 0;
 	}
+	mData = 0;
 	mWidth = 0;
 	mHeight = 0;
+	mPitch = 0;
+}
+
+int Image::getBytesPerPixel (PixelFormat format)
+{
+	switch (format)
+	{
+		case PIXELFORMAT_RGB8:
+			return 3;
+		case PIXELFORMAT_RGBA8:
+			return 4;
+		case PIXELFORMAT_R16:
+			return 2;
+		case PIXELFORMAT_R32F:
+			return 4;
+	}
+	NoiseAssert (false, format);
+	return 0;
+}
+
+void Image::writeColour (unsigned char *&buffer, PixelFormat format, const ColourValue &colour)
+{
+	switch (format)
+	{
+		case PIXELFORMAT_RGB8:
+			*buffer++ = ColourValue::toUChar (colour.r);
+			*buffer++ = ColourValue::toUChar (colour.g);
+			*buffer++ = ColourValue::toUChar (colour.b);
+			break;
+		case PIXELFORMAT_RGBA8:
+			*buffer++ = ColourValue::toUChar (colour.r);
+			*buffer++ = ColourValue::toUChar (colour.g);
+			*buffer++ = ColourValue::toUChar (colour.b);
+			*buffer++ = 255;
+			break;
+		default:
+			writeValue (buffer, format, 0.299f * colour.r + 0.587f * colour.g + 0.114f * colour.b);
+			break;
+	}
+}
+
+void Image::writeValue (unsigned char *&buffer, PixelFormat format, float value)
+{
+	switch (format)
+	{
+		case PIXELFORMAT_RGB8:
+		case PIXELFORMAT_RGBA8:
+		{
+			const unsigned char grey = ColourValue::toUChar (value);
+			*buffer++ = grey;
+			*buffer++ = grey;
+			*buffer++ = grey;
+			if (format == PIXELFORMAT_RGBA8)
+				*buffer++ = 255;
+			break;
+		}
+		case PIXELFORMAT_R16:
+		{
+			if (value < 0.0f)
+				value = 0.0f;
+			if (value > 1.0f)
+				value = 1.0f;
+			const unsigned short v = (unsigned short)(value * 65535.0f + 0.5f);
+			memcpy (buffer, &v, sizeof(v));
+			buffer += sizeof(v);
+			break;
+		}
+		case PIXELFORMAT_R32F:
+			memcpy (buffer, &value, sizeof(value));
+			buffer += sizeof(value);
+			break;
+	}
 }
 
 bool Image::saveBMP (const char *filename)
@@ -64,9 +147,14 @@ bool Image::saveBMP (const char *filename)
 	FileOutStream stream(filename);
 	if (!stream.isOpen())
 		return false;
+	// RGBA is written with alpha, everything else as 24-bit
+	const bool alpha = (mFormat == PIXELFORMAT_RGBA8);
+	const int bytesPerPixel = alpha ? 4 : 3;
+	// rows are padded to a multiple of 4 bytes
+	const size_t rowSize = (size_t(mWidth) * bytesPerPixel + 3) & ~size_t(3);
 	// BMP Header
 	stream.write ("BM", 2);
-	unsigned size = 14 + 40 + mWidth * mHeight * 3;
+	unsigned size = 14 + 40 + unsigned(rowSize * mHeight);
 	stream.write (size);
 	unsigned res = 0;
 	stream.write (res);
@@ -82,11 +170,11 @@ bool Image::saveBMP (const char *filename)
 	stream.write (h);
 	unsigned short planes = 1;
 	stream.write (planes);
-	unsigned short bpp = 24;
+	unsigned short bpp = bytesPerPixel * 8;
 	stream.write (bpp);
 	unsigned compression = 0;
 	stream.write (compression);
-	unsigned sizeImage = mWidth * mHeight * 3;
+	unsigned sizeImage = unsigned(rowSize * mHeight);
 	stream.write (sizeImage);
 	int ppm = 0;
 	stream.write (ppm);
@@ -97,18 +185,49 @@ bool Image::saveBMP (const char *filename)
 	stream.write (clrImportant);
 	assert (stream.tell() == offset);
 
+	// the rows are swizzled into a scratch row and written at once, bottom to top
+	std::vector<unsigned char> row(rowSize, 0);
+	unsigned char *dest = &row[0];
 	for (int y=mHeight-1;y>=0;--y)
 	{
-		unsigned char *buffer = mData+y*mWidth*3;
-		for (int x=0;x<mWidth;++x)
+		const unsigned char *src = getRowData (y);
+		switch (mFormat)
 		{
-			unsigned char r = *buffer++;
-			unsigned char g = *buffer++;
-			unsigned char b = *buffer++;
-			stream.write (b);
-			stream.write (g);
-			stream.write (r);
+			case PIXELFORMAT_RGB8:
+				for (int x=0;x<mWidth;++x)
+				{
+					dest[x*3+0] = src[x*3+2];
+					dest[x*3+1] = src[x*3+1];
+					dest[x*3+2] = src[x*3+0];
+				}
+				break;
+			case PIXELFORMAT_RGBA8:
+				for (int x=0;x<mWidth;++x)
+				{
+					dest[x*4+0] = src[x*4+2];
+					dest[x*4+1] = src[x*4+1];
+					dest[x*4+2] = src[x*4+0];
+					dest[x*4+3] = src[x*4+3];
+				}
+				break;
+			case PIXELFORMAT_R16:
+				for (int x=0;x<mWidth;++x)
+				{
+					unsigned short v;
+					memcpy (&v, src+x*2, sizeof(v));
+					dest[x*3+0] = dest[x*3+1] = dest[x*3+2] = (unsigned char)(v >> 8);
+				}
+				break;
+			case PIXELFORMAT_R32F:
+				for (int x=0;x<mWidth;++x)
+				{
+					float v;
+					memcpy (&v, src+x*4, sizeof(v));
+					dest[x*3+0] = dest[x*3+1] = dest[x*3+2] = ColourValue::toUChar (v);
+				}
+				break;
 		}
+		stream.write (dest, rowSize);
 	}
 
 	stream.close ();
@@ -27,13 +27,29 @@
 #define NOISEIMAGE_H
 
 #include <cassert>
+#include <cstddef>
+#include "NoiseColourValue.h"
 
 namespace noisepp
 {
 namespace utils
 {
 
-/// Class representing an 24-bit image.
+/// Pixel formats of an image.
+enum PixelFormat
+{
+	/// 8-bit red, green and blue.
+	PIXELFORMAT_RGB8,
+	/// 8-bit red, green, blue and alpha.
+	PIXELFORMAT_RGBA8,
+	/// 16-bit unsigned single channel.
+	PIXELFORMAT_R16,
+	/// 32-bit floating point single channel.
+	PIXELFORMAT_R32F
+};
+
+/// Class representing an image.
+/// The rows are stored top to bottom, each row starts getPitch() bytes after the previous one.
 class Image
 {
 	public:
@@ -42,7 +58,10 @@ class Image
 		/// Creates the image with the specified parameters.
 		/// @param width Width of the image.
 		/// @param height Height of the image.
-		void create (int width, int height);
+		/// @param format The pixel format.
+		/// @param rowAlignment The alignment of the rows in bytes, must be a power of two.
+		/// The default packs the rows tightly, use 16 or more to make aligned SIMD stores legal at the start of each row.
+		void create (int width, int height, PixelFormat format=PIXELFORMAT_RGB8, int rowAlignment=1);
 		/// Clears the image data.
 		void clear ();
 
@@ -51,17 +70,22 @@ class Image
 		{
 			return mData;
 		}
-		/// Returns a pointer to the pixel data at the specified row.
-		/// @param i The row number.
+		/// Returns a pointer to the pixel data of the specified pixel, counted row by row.
+		/// @param i The pixel number.
 		unsigned char *getPixelData (int i) const
 		{
 			assert (i < mWidth*mHeight);
-			return mData+i*3;
+			return getPixelData (i % mWidth, i / mWidth);
 		}
 		/// Returns a pointer to the pixel data at the specified position.
 		unsigned char *getPixelData (int x, int y) const
 		{
-			return mData+(y*mWidth+x)*3;
+			return mData+y*mPitch+x*mBytesPerPixel;
+		}
+		/// Returns a pointer to the pixel data of the specified row.
+		unsigned char *getRowData (int y) const
+		{
+			return mData+y*mPitch;
 		}
 		/// Returns the width of the image.
 		int getWidth () const
@@ -73,14 +97,50 @@ class Image
 		{
 			return mHeight;
 		}
+		/// Returns the pixel format.
+		PixelFormat getFormat () const
+		{
+			return mFormat;
+		}
+		/// Returns the size of a pixel in bytes.
+		int getBytesPerPixel () const
+		{
+			return mBytesPerPixel;
+		}
+		/// Returns the distance between two rows in bytes.
+		size_t getPitch () const
+		{
+			return mPitch;
+		}
+		/// Returns the size of a pixel of the specified format in bytes.
+		static int getBytesPerPixel (PixelFormat format);
+		/// Returns true if the specified format stores colours rather than a single channel.
+		static bool isColourFormat (PixelFormat format)
+		{
+			return (format == PIXELFORMAT_RGB8 || format == PIXELFORMAT_RGBA8);
+		}
+		/// Writes a colour as a pixel of the specified format and advances the buffer.
+		/// The alpha channel is set to opaque, single channel formats receive the luminance.
+		static void writeColour (unsigned char *&buffer, PixelFormat format, const ColourValue &colour);
+		/// Writes a normalized value (range 0.0 to 1.0) as a pixel of the specified format and advances the buffer.
+		/// Colour formats receive a grey value, PIXELFORMAT_R32F stores the value unclamped.
+		static void writeValue (unsigned char *&buffer, PixelFormat format, float value);
 		/// Destructor.
 		~Image();
 		/// Writes the image to the specified bitmap file.
+		/// Single channel formats are written as grey values.
 		bool saveBMP (const char *filename);
 	protected:
 	private:
+		unsigned char *mBuffer;
 		unsigned char *mData;
 		int mWidth, mHeight;
+		PixelFormat mFormat;
+		int mBytesPerPixel;
+		size_t mPitch;
+
+		Image (const Image &);
+		Image &operator= (const Image &);
 };
 
 };
@@ -95,10 +95,16 @@ void MemoryInStream::open (char *buffer, size_t size)
 
 void MemoryInStream::read (void *buffer, size_t len)
 {
-	if (mPosition+len > mSize)
+	std::memcpy (buffer, view(len), len);
+}
+
+const char *MemoryInStream::view (size_t len)
+{
+	if (len > mSize - mPosition)
 		throw std::runtime_error ("Unexpected EOF");
-	std::memcpy (buffer, mBuffer+mPosition, len);
+	const char *data = mBuffer+mPosition;
 	mPosition += len;
+	return data;
 }
 
 size_t MemoryInStream::tell ()
@@ -50,6 +50,12 @@ class InStream
 		virtual size_t tell () = 0;
 		/// Jumps to the specified position.
 		virtual void seek (size_t pos) = 0;
+		/// Returns a pointer to the next len bytes and skips them, without copying.
+		/// Returns NULL without skipping if the stream doesn't support views.
+		virtual const char *view (size_t len)
+		{
+			return NULL;
+		}
 		/// Destructor.
 		virtual ~InStream();
 
@@ -117,9 +123,25 @@ class MemoryInStream : public InStream
 		/// Constructor.
 		MemoryInStream ();
 		/// Open the specified buffer for reading.
+		/// The buffer isn't copied and has to stay valid while the stream is used.
 		/// @param buffer The buffer.
 		/// @param size The size of the buffer.
 		void open (char *buffer, size_t size);
+		/// Returns a pointer to the next len bytes and skips them, without copying.
+		/// The data is in file byte order, the pointer stays valid as long as the buffer.
+		virtual const char *view (size_t len);
+		/// Returns the number of bytes left to read.
+		size_t getRemaining () const
+		{
+			return mSize - mPosition;
+		}
+		/// @copydoc noisepp::utils::InStream::read(T &)
+		template <class T>
+		void read (T &t)
+		{
+			std::memcpy (&t, view(sizeof(T)), sizeof(T));
+			EndianUtils::flipEndian (&t, sizeof(T));
+		}
 		/// Returns a pointer to the buffer.
 		char *getBuffer ()
 		{
@@ -0,0 +1,575 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseJitCompiler.h"
+#include "NoiseSystem.h"
+#include "Noise.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+#	include <dlfcn.h>
+#endif
+
+namespace noisepp
+{
+namespace utils
+{
+
+namespace
+{
+
+/// Version of the generated code, part of the cache key.
+const int JIT_VERSION = 1;
+/// Header included by the generated code.
+const char *JIT_HEADER = "NoiseExpression.h";
+
+/// Adds the contents of a header and of all headers it includes with quotes to a hash.
+/// The headers are searched in the include directories, headers which aren't found there are skipped.
+void addHeader (GraphHash &hash, const std::vector<std::string> &directories, const std::string &name, std::set<std::string> &added)
+{
+	if (!added.insert (name).second)
+		return;
+	std::vector<std::string> includes;
+	for (std::vector<std::string>::const_iterator it=directories.begin();it!=directories.end();++it)
+	{
+		std::string filename = *it;
+		if (!filename.empty() && filename[filename.size()-1] != '/' && filename[filename.size()-1] != '\\')
+			filename += '/';
+		filename += name;
+		std::ifstream file(filename.c_str (), std::ios::binary);
+		if (!file)
+			continue;
+		hash.add (name.data (), name.size ());
+		hash.addInt (0);
+		std::string line;
+		while (std::getline (file, line))
+		{
+			hash.add (line.data (), line.size ());
+			hash.addInt (0);
+			// conditional includes are followed as well, which at worst adds headers that aren't used
+			const size_t directive = line.find ("#include");
+			if (directive == std::string::npos)
+				continue;
+			const size_t begin = line.find ('"', directive);
+			const size_t end = (begin == std::string::npos) ? begin : line.find ('"', begin+1);
+			if (end != std::string::npos)
+				includes.push_back (line.substr (begin+1, end-begin-1));
+		}
+		break;
+	}
+	for (std::vector<std::string>::const_iterator it=includes.begin();it!=includes.end();++it)
+		addHeader (hash, directories, *it, added);
+}
+
+/// Returns true if the path can be passed to the shell in double quotes.
+bool isQuotable (const std::string &path)
+{
+	return path.find_first_of ("\"$`\\") == std::string::npos;
+}
+
+typedef unsigned (*JitRealSizeFunction) ();
+typedef void (*JitValuesFunction2D) (const Real *x, const Real *y, Real *values, size_t count);
+typedef void (*JitValuesFunction3D) (const Real *x, const Real *y, const Real *z, Real *values, size_t count);
+
+/// Pipeline element calling the compiled code of a module graph.
+class JitElement2D : public PipelineElement2D
+{
+	private:
+		JitValuesFunction2D mValues;
+
+	public:
+		JitElement2D (JitValuesFunction2D values, const Interval &range) : mValues(values)
+		{
+			mRange = range;
+		}
+		virtual bool checkColumnar () const
+		{
+			return true;
+		}
+		virtual void getValues (const Real *x, const Real *y, Real *values, size_t count, Cache *cache) const
+		{
+			mValues (x, y, values, count);
+		}
+		virtual Real getValue (Real x, Real y, Cache *cache) const
+		{
+			Real value;
+			mValues (&x, &y, &value, 1);
+			return value;
+		}
+};
+
+/// Pipeline element calling the compiled code of a module graph.
+class JitElement3D : public PipelineElement3D
+{
+	private:
+		JitValuesFunction3D mValues;
+
+	public:
+		JitElement3D (JitValuesFunction3D values, const Interval &range) : mValues(values)
+		{
+			mRange = range;
+		}
+		virtual bool checkColumnar () const
+		{
+			return true;
+		}
+		virtual void getValues (const Real *x, const Real *y, const Real *z, Real *values, size_t count, Cache *cache) const
+		{
+			mValues (x, y, z, values, count);
+		}
+		virtual Real getValue (Real x, Real y, Real z, Cache *cache) const
+		{
+			Real value;
+			mValues (&x, &y, &z, &value, 1);
+			return value;
+		}
+};
+
+std::string formatReal (Real v)
+{
+	std::ostringstream s;
+	s.precision (17);
+	s << "Real(" << double(v) << ")";
+	return s.str ();
+}
+
+std::string formatInt (int v)
+{
+	std::ostringstream s;
+	s << v;
+	return s.str ();
+}
+
+/// Returns the instantiation of a class template, keeping nested closers apart.
+std::string formatTemplate (const std::string &name, const std::string &arguments)
+{
+	if (arguments[arguments.size()-1] == '>')
+		return name + "<" + arguments + " >";
+	return name + "<" + arguments + ">";
+}
+
+bool isPointTransform (const Module *module)
+{
+	const ModuleTypeId type = module->getType();
+	return (type == MODULE_SCALEPOINT || type == MODULE_TRANSLATEPOINT || type == MODULE_TRANSFORMPOINT);
+}
+
+/// Translates a module graph into the type and the construction of a static expression.
+class SourceGenerator
+{
+	private:
+		int mSeed;
+
+		bool addSources (const Module *module, size_t count, std::string *types, std::string *exprs)
+		{
+			for (size_t i=0;i<count;++i)
+			{
+				const Module *source = module->getSourceModule(i);
+				if (!source || !addModule (source, types[i], exprs[i]))
+					return false;
+			}
+			return true;
+		}
+		bool addSingleSource (const Module *module, const char *typeName, const char *function, const std::string &params, std::string &type, std::string &expr)
+		{
+			std::string sourceType, sourceExpr;
+			if (!addSources (module, 1, &sourceType, &sourceExpr))
+				return false;
+			type = formatTemplate (typeName, sourceType);
+			expr = std::string(function) + " (" + sourceExpr + params + ")";
+			return true;
+		}
+		bool addDualSource (const Module *module, const char *op, const char *function, std::string &type, std::string &expr)
+		{
+			std::string types[2], exprs[2];
+			if (!addSources (module, 2, types, exprs))
+				return false;
+			type = formatTemplate ("BinaryExpression", std::string(op) + ", " + types[0] + ", " + types[1]);
+			expr = std::string(function) + " (" + exprs[0] + ", " + exprs[1] + ")";
+			return true;
+		}
+		/// Adds a chain of point transforms folded into one matrix like the pipeline does.
+		bool addPointTransform (const PointTransformModule *module, std::string &type, std::string &expr)
+		{
+			TransformMatrix matrix;
+			module->getTransform (matrix);
+			const Module *source = module->getSourceModule(0);
+			while (source && isPointTransform(source))
+			{
+				const PointTransformModule *transformModule = static_cast<const PointTransformModule*>(source);
+				TransformMatrix inner;
+				transformModule->getTransform (inner);
+				matrix = inner * matrix;
+				source = transformModule->getSourceModule(0);
+			}
+			if (!source || !addModule (source, type, expr))
+				return false;
+			const Real *m = matrix.m;
+			// rotations and shears aren't covered by the expressions
+			if (m[1] != Real(0.0) || m[2] != Real(0.0) || m[4] != Real(0.0) || m[6] != Real(0.0) || m[8] != Real(0.0) || m[9] != Real(0.0))
+				return false;
+			// the pipeline calculates x*scale+translation
+			if (m[3] != Real(0.0) || m[7] != Real(0.0) || m[11] != Real(0.0))
+			{
+				type = formatTemplate ("TranslatePointExpression", type);
+				expr = "translatePoint (" + expr + ", " + formatReal (m[3]) + ", " + formatReal (m[7]) + ", " + formatReal (m[11]) + ")";
+			}
+			if (m[0] != Real(1.0) || m[5] != Real(1.0) || m[10] != Real(1.0))
+			{
+				type = formatTemplate ("ScalePointExpression", type);
+				expr = "scalePoint (" + expr + ", " + formatReal (m[0]) + ", " + formatReal (m[5]) + ", " + formatReal (m[10]) + ")";
+			}
+			return true;
+		}
+		std::string formatPerlin (const PerlinModuleBase *module)
+		{
+			return " ().setFrequency (" + formatReal (module->getFrequency ()) + ").setSeed (" + formatInt (module->getSeed () + mSeed) +
+				").setLacunarity (" + formatReal (module->getLacunarity ()) + ").setPersistence (" + formatReal (module->getPersistence ()) +
+				").setScale (" + formatReal (module->getScale ()) + ")";
+		}
+
+	public:
+		SourceGenerator (int seed) : mSeed(seed)
+		{
+		}
+		bool addModule (const Module *module, std::string &type, std::string &expr)
+		{
+			switch (module->getType ())
+			{
+				case MODULE_PERLIN:
+				case MODULE_BILLOW:
+				{
+					const PerlinModuleBase *m = static_cast<const PerlinModuleBase*>(module);
+					if (m->getOctaveCount () < 1)
+						return false;
+					const std::string params = formatInt (m->getOctaveCount ()) + ", " + formatInt (m->getQuality ());
+					if (module->getType () == MODULE_PERLIN)
+					{
+						type = formatTemplate ("PerlinExpression", params);
+						expr = formatTemplate ("perlin", params) + formatPerlin (m);
+					}
+					else
+					{
+						type = formatTemplate ("BillowExpression", params);
+						expr = formatTemplate ("billow", params) + formatPerlin (m);
+					}
+					return true;
+				}
+				case MODULE_RIDGEDMULTI:
+				{
+					const RidgedMultiModule *m = static_cast<const RidgedMultiModule*>(module);
+					if (m->getOctaveCount () < 1)
+						return false;
+					const std::string params = formatInt (m->getOctaveCount ()) + ", " + formatInt (m->getQuality ());
+					type = formatTemplate ("RidgedMultiExpression", params);
+					expr = formatTemplate ("ridgedMulti", params) + " ().setFrequency (" + formatReal (m->getFrequency ()) +
+						").setSeed (" + formatInt (m->getSeed () + mSeed) + ").setLacunarity (" + formatReal (m->getLacunarity ()) +
+						").setExponent (" + formatReal (m->getExponent ()) + ").setOffset (" + formatReal (m->getOffset ()) +
+						").setGain (" + formatReal (m->getGain ()) + ").setScale (" + formatReal (m->getScale ()) + ")";
+					return true;
+				}
+				case MODULE_CONSTANT:
+					type = "ConstantExpression";
+					expr = "constant (" + formatReal (static_cast<const ConstantModule*>(module)->getValue ()) + ")";
+					return true;
+				case MODULE_ABSOLUTE:
+					return addSingleSource (module, "AbsoluteExpression", "absolute", "", type, expr);
+				case MODULE_INVERT:
+					return addSingleSource (module, "InvertExpression", "invert", "", type, expr);
+				case MODULE_CLAMP:
+				{
+					const ClampModule *m = static_cast<const ClampModule*>(module);
+					return addSingleSource (module, "ClampExpression", "clamp", ", " + formatReal (m->getLowerBound ()) + ", " + formatReal (m->getUpperBound ()), type, expr);
+				}
+				case MODULE_EXPONENT:
+				{
+					const ExponentModule *m = static_cast<const ExponentModule*>(module);
+					return addSingleSource (module, "ExponentExpression", "exponent", ", " + formatReal (m->getExponent ()), type, expr);
+				}
+				case MODULE_SCALEBIAS:
+				{
+					const ScaleBiasModule *m = static_cast<const ScaleBiasModule*>(module);
+					return addSingleSource (module, "ScaleBiasExpression", "scaleBias", ", " + formatReal (m->getScale ()) + ", " + formatReal (m->getBias ()), type, expr);
+				}
+				case MODULE_TURBULENCE:
+				{
+					const TurbulenceModule *m = static_cast<const TurbulenceModule*>(module);
+					if (m->getRoughness () < 1)
+						return false;
+					const std::string params = formatInt (m->getRoughness ()) + ", " + formatInt (m->getQuality ());
+					std::string sourceType, sourceExpr;
+					if (!addSources (module, 1, &sourceType, &sourceExpr))
+						return false;
+					type = formatTemplate ("TurbulenceExpression", sourceType + ", " + params);
+					expr = formatTemplate ("turbulence", params) + " (" + sourceExpr + ", " + formatReal (m->getPower ()) + ").setSeed (" +
+						formatInt (m->getSeed () + mSeed) + ").setFrequency (" + formatReal (m->getFrequency ()) + ")";
+					return true;
+				}
+				case MODULE_ADDITION:
+					return addDualSource (module, "AdditionOperator", "addition", type, expr);
+				case MODULE_MULTIPLY:
+					return addDualSource (module, "MultiplyOperator", "multiply", type, expr);
+				case MODULE_MAXIMUM:
+					return addDualSource (module, "MaximumOperator", "maximum", type, expr);
+				case MODULE_MINIMUM:
+					return addDualSource (module, "MinimumOperator", "minimum", type, expr);
+				case MODULE_POWER:
+					return addDualSource (module, "PowerOperator", "power", type, expr);
+				case MODULE_BLEND:
+				{
+					std::string types[3], exprs[3];
+					if (!addSources (module, 3, types, exprs))
+						return false;
+					type = formatTemplate ("BlendExpression", types[0] + ", " + types[1] + ", " + types[2]);
+					expr = "blend (" + exprs[0] + ", " + exprs[1] + ", " + exprs[2] + ")";
+					return true;
+				}
+				case MODULE_SELECT:
+				{
+					const SelectModule *m = static_cast<const SelectModule*>(module);
+					std::string types[3], exprs[3];
+					if (!addSources (module, 3, types, exprs))
+						return false;
+					type = formatTemplate ("SelectExpression", types[0] + ", " + types[1] + ", " + types[2]);
+					expr = "select (" + exprs[0] + ", " + exprs[1] + ", " + exprs[2] + ", " + formatReal (m->getLowerBound ()) + ", " +
+						formatReal (m->getUpperBound ()) + ", " + formatReal (m->getEdgeFalloff ()) + ")";
+					return true;
+				}
+				case MODULE_SCALEPOINT:
+				case MODULE_TRANSLATEPOINT:
+				case MODULE_TRANSFORMPOINT:
+					return addPointTransform (static_cast<const PointTransformModule*>(module), type, expr);
+				default:
+					return false;
+			}
+		}
+};
+
+};
+
+JitCompiler::JitCompiler (const std::string &directory) : mDirectory(directory), mCompiler("c++"), mFlags("-O3 -march=native")
+{
+	if (!mDirectory.empty() && mDirectory[mDirectory.size()-1] != '/' && mDirectory[mDirectory.size()-1] != '\\')
+		mDirectory += '/';
+}
+
+bool JitCompiler::isSupported (const Module &module)
+{
+	std::string type, expr;
+	SourceGenerator generator(0);
+	return generator.addModule (&module, type, expr);
+}
+
+bool JitCompiler::generateSource (const Module &module, int seed, std::string &source)
+{
+	std::string type, expr;
+	SourceGenerator generator(seed);
+	if (!generator.addModule (&module, type, expr))
+		return false;
+
+	std::ostringstream s;
+	s << "// Generated by noisepp::utils::JitCompiler\n";
+	s << "#define NOISEPP_DOUBLE_PRECISION " << NOISEPP_DOUBLE_PRECISION << "\n";
+	s << "#define NOISEPP_MIXED_PRECISION " << NOISEPP_MIXED_PRECISION << "\n";
+	s << "#define NOISEPP_ENABLE_THREADS 0\n";
+	s << "#include \"" << JIT_HEADER << "\"\n\n";
+	s << "using namespace noisepp;\n";
+	s << "using namespace noisepp::utils;\n\n";
+	s << "typedef " << type << " GraphExpression;\n\n";
+	s << "static const GraphExpression graph = " << expr << ";\n\n";
+	s << "extern \"C\"\n{\n\n";
+	s << "unsigned noisepp_jit_real_size ()\n{\n\treturn sizeof(Real);\n}\n\n";
+	s << "void noisepp_jit_values2d (const Real *x, const Real *y, Real *values, size_t count)\n{\n";
+	s << "\tfor (size_t i=0;i<count;++i)\n\t\tvalues[i] = graph.getValue (x[i], y[i]);\n}\n\n";
+	s << "void noisepp_jit_values3d (const Real *x, const Real *y, const Real *z, Real *values, size_t count)\n{\n";
+	s << "\tfor (size_t i=0;i<count;++i)\n\t\tvalues[i] = graph.getValue (x[i], y[i], z[i]);\n}\n\n";
+	s << "}\n";
+	source = s.str ();
+	return true;
+}
+
+GraphHash::Value JitCompiler::calcKey (const Module &module, int seed) const
+{
+	GraphHash hash;
+	hash.addModule (module);
+	hash.addInt (seed);
+	hash.addInt (JIT_VERSION);
+	hash.addInt (int(sizeof(Real)));
+	hash.addInt (NOISEPP_MIXED_PRECISION);
+	hash.add (mCompiler.data (), mCompiler.size ());
+	hash.addInt (0);
+	hash.add (mFlags.data (), mFlags.size ());
+	// the headers of an other library version would compile the graph differently
+	std::set<std::string> headers;
+	addHeader (hash, mIncludeDirectories, JIT_HEADER, headers);
+	return hash.getValue ();
+}
+
+std::string JitCompiler::getFilename (GraphHash::Value key) const
+{
+	char name[32];
+	std::sprintf (name, "%08x%08x.so", unsigned(key >> 32), unsigned(key & 0xffffffffULL));
+	return mDirectory + name;
+}
+
+bool JitCompiler::build (const std::string &source, const std::string &filename)
+{
+	// the paths are quoted for the shell, which still expands some characters inside quotes
+	if (!isQuotable (filename))
+	{
+		mLastError = "unsupported characters in path " + filename;
+		return false;
+	}
+	for (std::vector<std::string>::const_iterator it=mIncludeDirectories.begin();it!=mIncludeDirectories.end();++it)
+	{
+		if (!isQuotable (*it))
+		{
+			mLastError = "unsupported characters in path " + *it;
+			return false;
+		}
+	}
+	// other processes may build the same key at the same time
+	const std::string tempname = System::getTempFilename (filename);
+	const std::string sourcename = tempname + ".cpp";
+	const std::string logname = tempname + ".log";
+	{
+		std::ofstream file(sourcename.c_str ());
+		file << source;
+		if (!file)
+		{
+			mLastError = "can't write " + sourcename;
+			return false;
+		}
+	}
+	std::string command = mCompiler + " " + mFlags + " -shared -fPIC";
+	for (std::vector<std::string>::const_iterator it=mIncludeDirectories.begin();it!=mIncludeDirectories.end();++it)
+		command += " -I\"" + *it + "\"";
+	command += " -o \"" + tempname + "\" \"" + sourcename + "\" > \"" + logname + "\" 2>&1";
+	const int result = std::system (command.c_str ());
+	if (result != 0)
+	{
+		std::ifstream log(logname.c_str ());
+		std::ostringstream s;
+		s << command << "\n" << log.rdbuf ();
+		mLastError = s.str ();
+		std::remove (tempname.c_str ());
+		std::remove (sourcename.c_str ());
+		std::remove (logname.c_str ());
+		return false;
+	}
+	std::remove (sourcename.c_str ());
+	std::remove (logname.c_str ());
+	if (std::rename (tempname.c_str (), filename.c_str ()) != 0)
+	{
+		// an other process may have stored the same key in the meantime
+		std::remove (filename.c_str ());
+		if (std::rename (tempname.c_str (), filename.c_str ()) != 0)
+		{
+			std::remove (tempname.c_str ());
+			mLastError = "can't write " + filename;
+			return false;
+		}
+	}
+	return true;
+}
+
+void *JitCompiler::load (const Module &module, int seed, const char *symbol)
+{
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+	std::string source;
+	if (!generateSource (module, seed, source))
+	{
+		mLastError = "module graph not supported";
+		return NULL;
+	}
+	const std::string filename = getFilename (calcKey (module, seed));
+	void *library = dlopen (filename.c_str (), RTLD_NOW | RTLD_LOCAL);
+	if (!library)
+	{
+		if (!build (source, filename))
+			return NULL;
+		library = dlopen (filename.c_str (), RTLD_NOW | RTLD_LOCAL);
+		if (!library)
+		{
+			mLastError = dlerror ();
+			return NULL;
+		}
+	}
+	JitRealSizeFunction realSize = reinterpret_cast<JitRealSizeFunction>(dlsym (library, "noisepp_jit_real_size"));
+	void *function = dlsym (library, symbol);
+	if (!realSize || realSize () != sizeof(Real) || !function)
+	{
+		mLastError = "invalid library " + filename;
+		dlclose (library);
+		return NULL;
+	}
+	mLibraries.push_back (library);
+	return function;
+#else
+	mLastError = "not supported on this platform";
+	return NULL;
+#endif
+}
+
+ElementID JitCompiler::addToPipeline (const Module &module, Pipeline2D *pipe)
+{
+	NoiseAssert (pipe != NULL, pipe);
+	JitValuesFunction2D values = reinterpret_cast<JitValuesFunction2D>(load (module, pipe->getSeed (), "noisepp_jit_values2d"));
+	if (!values)
+		return module.addToPipeline (pipe);
+	// the range of the interpreted graph
+	Pipeline2D interpreted;
+	interpreted.setSeed (pipe->getSeed ());
+	const Interval range = interpreted.getElement (module.addToPipeline (&interpreted))->getRange ();
+	return pipe->addElement (&module, new JitElement2D(values, range));
+}
+
+ElementID JitCompiler::addToPipeline (const Module &module, Pipeline3D *pipe)
+{
+	NoiseAssert (pipe != NULL, pipe);
+	JitValuesFunction3D values = reinterpret_cast<JitValuesFunction3D>(load (module, pipe->getSeed (), "noisepp_jit_values3d"));
+	if (!values)
+		return module.addToPipeline (pipe);
+	// the range of the interpreted graph
+	Pipeline3D interpreted;
+	interpreted.setSeed (pipe->getSeed ());
+	const Interval range = interpreted.getElement (module.addToPipeline (&interpreted))->getRange ();
+	return pipe->addElement (&module, new JitElement3D(values, range));
+}
+
+JitCompiler::~JitCompiler ()
+{
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+	for (std::vector<void*>::iterator it=mLibraries.begin();it!=mLibraries.end();++it)
+		dlclose (*it);
+#endif
+}
+
+};
+};
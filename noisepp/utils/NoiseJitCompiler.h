@@ -0,0 +1,133 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEJITCOMPILER_H
+#define NOISEJITCOMPILER_H
+
+#include <string>
+#include <vector>
+
+#include "NoiseGraphHash.h"
+#include "NoisePipeline.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Compiles module graphs into native code at runtime.
+/// The graph is translated into C++ source with all parameters baked in, built from the static expressions of
+/// NoiseExpression.h, compiled into a shared library by the system compiler and loaded as a pipeline element.
+/// The libraries are kept in the cache directory, named after a key built from the hash of the module graph, the
+/// pipeline seed, the Real type, the compiler settings and the headers in the include directories, so each graph is
+/// only compiled once per library version. Cache and include directories containing the characters " $ ` or \ are
+/// rejected, as the shell would interpret them.
+/// Graphs with modules the expressions don't cover (curve, terrace, voronoi, checkerboard and rotating transforms)
+/// fall back to the interpreted pipeline, as do all graphs on platforms without dlopen.
+/// The generated code is a tree, modules shared by several consumers are evaluated once per consumer.
+/// The results can differ in the last bits from the pipeline, as the compiler specializes on the constants and may
+/// contract operations, flags like "-O2 -ffp-contract=off" give the same values.
+/// The libraries stay loaded until the compiler is destroyed, so it has to outlive the pipelines.
+class JitCompiler
+{
+	public:
+		/// Constructor.
+		/// @param directory The cache directory, which has to exist.
+		JitCompiler (const std::string &directory);
+		/// Sets the compiler command, defaults to "c++".
+		void setCompiler (const std::string &compiler)
+		{
+			mCompiler = compiler;
+		}
+		/// Returns the compiler command.
+		const std::string &getCompiler () const
+		{
+			return mCompiler;
+		}
+		/// Sets the compiler flags, defaults to "-O3 -march=native".
+		void setFlags (const std::string &flags)
+		{
+			mFlags = flags;
+		}
+		/// Returns the compiler flags.
+		const std::string &getFlags () const
+		{
+			return mFlags;
+		}
+		/// Adds a directory to the include path of the generated source, which needs the core and utils headers.
+		void addIncludeDirectory (const std::string &directory)
+		{
+			mIncludeDirectories.push_back (directory);
+		}
+		/// Returns the output of the last failed compile or load.
+		const std::string &getLastError () const
+		{
+			return mLastError;
+		}
+		/// Returns true if the module graph can be compiled.
+		static bool isSupported (const Module &module);
+		/// Generates the C++ source of a module graph.
+		/// @param module The module.
+		/// @param seed The master seed of the pipeline.
+		/// @param source Receives the source.
+		/// Returns false if the graph isn't supported.
+		static bool generateSource (const Module &module, int seed, std::string &source);
+		/// Returns the cache key of a module graph.
+		/// The key covers the contents of the headers the generated source includes, which are read from the include
+		/// directories.
+		/// @param module The module.
+		/// @param seed The master seed of the pipeline.
+		GraphHash::Value calcKey (const Module &module, int seed=0) const;
+		/// Returns the file name of the library of the specified key.
+		std::string getFilename (GraphHash::Value key) const;
+		/// Adds the compiled module graph to a pipeline.
+		/// The library is loaded from the cache or compiled and stored. Graphs which can't be compiled are added
+		/// with Module::addToPipeline().
+		/// Returns the element ID.
+		ElementID addToPipeline (const Module &module, Pipeline2D *pipe);
+		/// @copydoc addToPipeline(const Module&,Pipeline2D*)
+		ElementID addToPipeline (const Module &module, Pipeline3D *pipe);
+		/// Destructor, unloads the libraries.
+		~JitCompiler ();
+	protected:
+	private:
+		std::string mDirectory;
+		std::string mCompiler;
+		std::string mFlags;
+		std::vector<std::string> mIncludeDirectories;
+		std::string mLastError;
+		std::vector<void*> mLibraries;
+
+		bool build (const std::string &source, const std::string &filename);
+		void *load (const Module &module, int seed, const char *symbol);
+
+		JitCompiler (const JitCompiler &);
+		JitCompiler &operator= (const JitCompiler &);
+};
+
+};
+};
+
+#endif // NOISEJITCOMPILER_H
@@ -62,19 +62,63 @@ JobQueue::~JobQueue ()
 #if NOISEPP_ENABLE_THREADS
 void ThreadedJobQueue::threadFunction ()
 {
+#if NOISEPP_ENABLE_TRACING
+	TraceRecorder *recorder = NULL;
+	TraceBuffer *trace = NULL;
+	double traceStart = 0, traceEnd = 0;
+#endif
 	threadpp::Mutex::Lock lk(mMutex);
 	while (!mThreadsDone)
 	{
 		if (mJobs.empty())
+		{
+#if NOISEPP_ENABLE_TRACING
+			if (trace)
+				traceStart = recorder->now ();
 			mCond.wait(lk);
+			if (trace && recorder == mTraceRecorder && !mThreadsDone)
+				trace->add ("idle", traceStart, recorder->now ());
+#else
+			mCond.wait(lk);
+#endif
+		}
+#if NOISEPP_ENABLE_TRACING
+		if (recorder != mTraceRecorder)
+		{
+			recorder = mTraceRecorder;
+			trace = recorder ? recorder->createBuffer ("job queue worker") : NULL;
+		}
+#endif
 		if (!mJobs.empty())
 		{
 			Job *job = mJobs.front ();
 			mJobs.pop ();
+#if NOISEPP_ENABLE_TRACING
+			const double queued = mJobTimes.front ();
+			mJobTimes.pop ();
+#endif
 			++mWorkingThreads;
 			lk.unlock ();
+#if NOISEPP_ENABLE_TRACING
+			if (trace)
+				traceStart = recorder->now ();
+			job->execute();
+			if (trace)
+			{
+				traceEnd = recorder->now ();
+				if (queued >= 0)
+					trace->add ("execute", traceStart, traceEnd, "queued_us", traceStart - queued);
+				else
+					trace->add ("execute", traceStart, traceEnd);
+			}
+			lk.lock ();
+			if (trace)
+				trace->add ("lock", traceEnd, recorder->now ());
+			mJobsDoneTimes.push (trace ? traceEnd : -1.0);
+#else
 			job->execute();
 			lk.lock ();
+#endif
 			--mWorkingThreads;
 			mJobsDone.push (job);
 			mMainCond.notifyOne ();
@@ -91,6 +135,10 @@ void *ThreadedJobQueue::threadEntry (void *queue)
 ThreadedJobQueue::ThreadedJobQueue (size_t numberOfThreads) : mThreadsDone(false), mWorkingThreads(0)
 {
 	NoiseAssert (numberOfThreads > 0, numberOfThreads);
+#if NOISEPP_ENABLE_TRACING
+	mTraceRecorder = NULL;
+	mMainTrace = NULL;
+#endif
 	for (size_t i=0;i<numberOfThreads;++i)
 	{
 		mThreads.createThread (threadEntry, this);
@@ -104,13 +152,32 @@ void ThreadedJobQueue::executeJobs ()
 	while (!mJobs.empty() || mWorkingThreads > 0)
 	{
 		if (!mJobs.empty() || mWorkingThreads > 0)
+		{
+#if NOISEPP_ENABLE_TRACING
+			const double waitStart = mMainTrace ? mTraceRecorder->now () : 0;
+			mMainCond.wait(lk);
+			if (mMainTrace)
+				mMainTrace->add ("wait", waitStart, mTraceRecorder->now ());
+#else
 			mMainCond.wait(lk);
+#endif
+		}
 		while (!mJobsDone.empty())
 		{
 			Job *job = mJobsDone.front ();
 			mJobsDone.pop ();
+#if NOISEPP_ENABLE_TRACING
+			const double done = mJobsDoneTimes.front ();
+			mJobsDoneTimes.pop ();
 			lk.unlock ();
+			const double finishStart = mMainTrace ? mTraceRecorder->now () : 0;
 			job->finish ();
+			if (mMainTrace && done >= 0)
+				mMainTrace->add ("finish", finishStart, mTraceRecorder->now (), "latency_us", finishStart - done);
+#else
+			lk.unlock ();
+			job->finish ();
+#endif
 			delete job;
 			lk.lock ();
 		}
@@ -122,7 +189,19 @@ void ThreadedJobQueue::addJob (Job *job)
 	NoiseAssert (job != NULL, job);
 	threadpp::Mutex::Lock lk(mMutex);
 	mJobs.push (job);
+#if NOISEPP_ENABLE_TRACING
+	mJobTimes.push (mTraceRecorder ? mTraceRecorder->now () : -1.0);
+#endif
+}
+
+#if NOISEPP_ENABLE_TRACING
+void ThreadedJobQueue::setTraceRecorder (TraceRecorder *recorder)
+{
+	threadpp::Mutex::Lock lk(mMutex);
+	mTraceRecorder = recorder;
+	mMainTrace = recorder ? recorder->createBuffer ("main") : NULL;
 }
+#endif
 
 ThreadedJobQueue::~ThreadedJobQueue ()
 {
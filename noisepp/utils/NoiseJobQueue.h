@@ -27,6 +27,7 @@
 #define NOISEJOBQUEUE_H
 
 #include "NoisePrerequisites.h"
+#include "NoiseTrace.h"
 
 namespace noisepp
 {
@@ -80,6 +81,13 @@ class ThreadedJobQueue : public JobQueue
 		bool mThreadsDone;
 		unsigned mWorkingThreads;
 
+#if NOISEPP_ENABLE_TRACING
+		TraceRecorder *mTraceRecorder;
+		TraceBuffer *mMainTrace;
+		std::queue<double> mJobTimes;
+		std::queue<double> mJobsDoneTimes;
+#endif
+
 		void threadFunction ();
 		static void *threadEntry (void *queue);
 	public:
@@ -90,6 +98,16 @@ class ThreadedJobQueue : public JobQueue
 		virtual void executeJobs ();
 		/// @copydoc noisepp::utils::JobQueue::addJob()
 		virtual void addJob (Job *job);
+#if NOISEPP_ENABLE_TRACING
+		/// Sets the recorder for the scheduling events or NULL to stop recording.
+		/// The recorder must stay valid while it is set. Don't call this while jobs are executed.
+		void setTraceRecorder (TraceRecorder *recorder);
+		/// Returns the recorder for the scheduling events.
+		TraceRecorder *getTraceRecorder () const
+		{
+			return mTraceRecorder;
+		}
+#endif
 		/// Destructor.
 		virtual ~ThreadedJobQueue ();
 };
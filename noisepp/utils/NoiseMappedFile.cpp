@@ -0,0 +1,304 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseMappedFile.h"
+#include <cstring>
+
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#elif NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#endif
+
+namespace noisepp
+{
+namespace utils
+{
+
+namespace
+{
+
+const char MAPPEDFILE_MAGIC[4] = { 'N', 'P', 'H', 'M' };
+const unsigned MAPPEDFILE_VERSION = 1;
+const unsigned MAPPEDFILE_BYTE_ORDER = 0x01020304;
+
+struct MappedFileHeader
+{
+	char magic[4];
+	unsigned version;
+	int width;
+	int height;
+	int depth;
+	unsigned valueSize;
+	unsigned byteOrder;
+	unsigned reserved;
+};
+
+size_t getPageSize ()
+{
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+	return size_t(sysconf(_SC_PAGESIZE));
+#elif NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+	SYSTEM_INFO siSysInfo;
+	GetSystemInfo(&siSysInfo);
+	return siSysInfo.dwPageSize;
+#endif
+}
+
+};
+
+MappedFile::MappedFile () : mMapping(0), mMappingSize(0), mData(0), mWidth(0), mHeight(0), mDepth(0), mWritable(false),
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+	mFile(INVALID_HANDLE_VALUE), mFileMapping(0)
+#else
+	mFile(-1)
+#endif
+{
+}
+
+bool MappedFile::create (const char *filename, int width, int height, int depth)
+{
+	NoiseAssert (width > 0, width);
+	NoiseAssert (height > 0, height);
+	NoiseAssert (depth > 0, depth);
+	close ();
+	const size_t size = sizeof(MappedFileHeader) + size_t(width) * size_t(height) * size_t(depth) * sizeof(Real);
+	if (!map (filename, size, true))
+		return false;
+
+	MappedFileHeader header;
+	std::memcpy (header.magic, MAPPEDFILE_MAGIC, sizeof(header.magic));
+	header.version = MAPPEDFILE_VERSION;
+	header.width = width;
+	header.height = height;
+	header.depth = depth;
+	header.valueSize = sizeof(Real);
+	header.byteOrder = MAPPEDFILE_BYTE_ORDER;
+	header.reserved = 0;
+	std::memcpy (mMapping, &header, sizeof(header));
+
+	mWidth = width;
+	mHeight = height;
+	mDepth = depth;
+	mData = (Real *)((char *)mMapping + sizeof(MappedFileHeader));
+	return true;
+}
+
+bool MappedFile::open (const char *filename)
+{
+	close ();
+	if (!map (filename, 0, false))
+		return false;
+
+	MappedFileHeader header;
+	bool valid = (mMappingSize >= sizeof(header));
+	if (valid)
+	{
+		std::memcpy (&header, mMapping, sizeof(header));
+		valid = std::memcmp (header.magic, MAPPEDFILE_MAGIC, sizeof(header.magic)) == 0 &&
+			header.version == MAPPEDFILE_VERSION && header.byteOrder == MAPPEDFILE_BYTE_ORDER &&
+			header.valueSize == sizeof(Real) && header.width > 0 && header.height > 0 && header.depth > 0 &&
+			mMappingSize >= sizeof(header) + size_t(header.width) * size_t(header.height) * size_t(header.depth) * sizeof(Real);
+	}
+	if (!valid)
+	{
+		close ();
+		throw ReaderException ("invalid mapped file");
+	}
+
+	mWidth = header.width;
+	mHeight = header.height;
+	mDepth = header.depth;
+	mData = (Real *)((char *)mMapping + sizeof(MappedFileHeader));
+	return true;
+}
+
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+
+bool MappedFile::map (const char *filename, size_t size, bool writable)
+{
+	mFile = ::open (filename, writable ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+	if (mFile < 0)
+		return false;
+	if (writable)
+	{
+		// the file is extended without writing, the system fills it lazily
+		if (ftruncate (mFile, (off_t)size) != 0)
+		{
+			close ();
+			return false;
+		}
+	}
+	else
+	{
+		struct stat st;
+		if (fstat (mFile, &st) != 0 || st.st_size <= 0)
+		{
+			close ();
+			return false;
+		}
+		size = size_t(st.st_size);
+	}
+	void *mapping = mmap (0, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, mFile, 0);
+	if (mapping == MAP_FAILED)
+	{
+		close ();
+		return false;
+	}
+	mMapping = mapping;
+	mMappingSize = size;
+	mWritable = writable;
+	return true;
+}
+
+void MappedFile::flush (const Real *data, size_t count)
+{
+	if (!mMapping || !mWritable || count == 0)
+		return;
+	const size_t pageSize = getPageSize ();
+	const size_t base = (size_t)mMapping;
+	const size_t begin = (size_t)data;
+	const size_t end = (size_t)(data + count);
+	assert (begin >= base && end <= base + mMappingSize);
+	// start the write back of every page touched by the range
+	const size_t first = begin & ~(pageSize - 1);
+	msync ((void *)first, end - first, MS_ASYNC);
+#if defined(__linux__)
+	// on a shared file mapping this only drops the pages from the process, the data stays in the page cache
+	const size_t innerBegin = (begin + pageSize - 1) & ~(pageSize - 1);
+	const size_t innerEnd = end & ~(pageSize - 1);
+	if (innerEnd > innerBegin)
+		madvise ((void *)innerBegin, innerEnd - innerBegin, MADV_DONTNEED);
+#endif
+}
+
+void MappedFile::close ()
+{
+	if (mMapping)
+	{
+		if (mWritable)
+			msync (mMapping, mMappingSize, MS_SYNC);
+		munmap (mMapping, mMappingSize);
+		mMapping = 0;
+	}
+	if (mFile >= 0)
+	{
+		::close (mFile);
+		mFile = -1;
+	}
+	mMappingSize = 0;
+	mData = 0;
+	mWidth = mHeight = mDepth = 0;
+	mWritable = false;
+}
+
+#elif NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+
+bool MappedFile::map (const char *filename, size_t size, bool writable)
+{
+	mFile = CreateFileA (filename, writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, writable ? 0 : FILE_SHARE_READ,
+		NULL, writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (mFile == INVALID_HANDLE_VALUE)
+		return false;
+	if (!writable)
+	{
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx (mFile, &fileSize) || fileSize.QuadPart <= 0)
+		{
+			close ();
+			return false;
+		}
+		size = size_t(fileSize.QuadPart);
+	}
+	// creating a writable mapping extends the file to the mapping size
+	const unsigned long long mappingSize = size;
+	mFileMapping = CreateFileMappingA (mFile, NULL, writable ? PAGE_READWRITE : PAGE_READONLY,
+		DWORD(mappingSize >> 32), DWORD(mappingSize & 0xffffffff), NULL);
+	if (!mFileMapping)
+	{
+		close ();
+		return false;
+	}
+	mMapping = MapViewOfFile (mFileMapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+	if (!mMapping)
+	{
+		close ();
+		return false;
+	}
+	mMappingSize = size;
+	mWritable = writable;
+	return true;
+}
+
+void MappedFile::flush (const Real *data, size_t count)
+{
+	if (!mMapping || !mWritable || count == 0)
+		return;
+	const size_t pageSize = getPageSize ();
+	const size_t begin = (size_t)data;
+	const size_t end = (size_t)(data + count);
+	assert (begin >= (size_t)mMapping && end <= (size_t)mMapping + mMappingSize);
+	const size_t first = begin & ~(pageSize - 1);
+	FlushViewOfFile ((void *)first, end - first);
+}
+
+void MappedFile::close ()
+{
+	if (mMapping)
+	{
+		if (mWritable)
+			FlushViewOfFile (mMapping, 0);
+		UnmapViewOfFile (mMapping);
+		mMapping = 0;
+	}
+	if (mFileMapping)
+	{
+		CloseHandle (mFileMapping);
+		mFileMapping = 0;
+	}
+	if (mFile != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle (mFile);
+		mFile = INVALID_HANDLE_VALUE;
+	}
+	mMappingSize = 0;
+	mData = 0;
+	mWidth = mHeight = mDepth = 0;
+	mWritable = false;
+}
+
+#endif
+
+MappedFile::~MappedFile ()
+{
+	close ();
+}
+
+};
+};
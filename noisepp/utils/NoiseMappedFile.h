@@ -0,0 +1,108 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEMAPPEDFILE_H
+#define NOISEMAPPEDFILE_H
+
+#include "NoisePrerequisites.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Memory-mapped heightmap file.
+/// The file consists of a 32 byte header followed by width*height*depth values of type Real in the byte order of the host.
+/// A builder can write straight into the mapping (see Builder::setDestination(MappedFile&)), which saves
+/// the buffer in RAM and the separate save step. Finished rows are handed to the system while the build runs,
+/// so the pages can be written back and released early.
+class MappedFile
+{
+	public:
+		/// Constructor.
+		MappedFile ();
+		/// Creates a file of the specified size and maps it for writing. An existing file is overwritten.
+		/// Returns false if the file can't be created or mapped.
+		bool create (const char *filename, int width, int height, int depth=1);
+		/// Maps an existing file for reading.
+		/// Returns false if the file can't be opened or mapped, throws a ReaderException if it isn't a valid file
+		/// or was written with a different Real type.
+		bool open (const char *filename);
+		/// Writes back the modified pages and closes the file.
+		void close ();
+		/// Returns true if a file is mapped.
+		bool isOpen () const
+		{
+			return mMapping != 0;
+		}
+		/// Hands the pages covering the specified values to the system for writing back.
+		/// Pages that lie completely within the range are released from the process on systems which support it.
+		void flush (const Real *data, size_t count);
+		/// Returns a pointer to the values.
+		Real *getData () const
+		{
+			return mData;
+		}
+		/// Returns the width.
+		int getWidth () const
+		{
+			return mWidth;
+		}
+		/// Returns the height.
+		int getHeight () const
+		{
+			return mHeight;
+		}
+		/// Returns the depth.
+		int getDepth () const
+		{
+			return mDepth;
+		}
+		/// Destructor.
+		~MappedFile ();
+	protected:
+	private:
+		void *mMapping;
+		size_t mMappingSize;
+		Real *mData;
+		int mWidth, mHeight, mDepth;
+		bool mWritable;
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+		void *mFile;
+		void *mFileMapping;
+#else
+		int mFile;
+#endif
+
+		bool map (const char *filename, size_t size, bool writable);
+
+		MappedFile (const MappedFile &);
+		MappedFile &operator= (const MappedFile &);
+};
+
+};
+};
+
+#endif // NOISEMAPPEDFILE_H
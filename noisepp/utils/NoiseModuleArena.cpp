@@ -0,0 +1,105 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseModuleArena.h"
+#include <cstdlib>
+
+namespace noisepp
+{
+namespace utils
+{
+
+namespace
+{
+
+const size_t ARENA_ALIGNMENT = 16;
+// the block header is padded, so the data of each block starts aligned
+const size_t ARENA_BLOCK_HEADER = ARENA_ALIGNMENT;
+
+};
+
+ModuleArena::ModuleArena (size_t blockSize) : mBlockSize(blockSize), mBlocks(0), mCurrent(0), mRemaining(0), mDestructors(0), mAllocatedSize(0)
+{
+	NoiseAssert (blockSize > 0, blockSize);
+}
+
+void *ModuleArena::allocate (size_t size)
+{
+	size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+	if (size > mRemaining)
+	{
+		// objects bigger than a block get a block of their own
+		const size_t dataSize = (size > mBlockSize) ? size : mBlockSize;
+		void *memory = std::malloc (ARENA_BLOCK_HEADER + dataSize);
+		if (!memory)
+			throw std::bad_alloc ();
+		Block *block = static_cast<Block *>(memory);
+		block->next = mBlocks;
+		mBlocks = block;
+		mCurrent = static_cast<char *>(memory) + ARENA_BLOCK_HEADER;
+		mRemaining = dataSize;
+	}
+	void *p = mCurrent;
+	mCurrent += size;
+	mRemaining -= size;
+	mAllocatedSize += size;
+	return p;
+}
+
+void ModuleArena::addDestructor (void *object, void (*destroy) (void *object))
+{
+	Destructor *destructor = static_cast<Destructor *>(allocate (sizeof(Destructor)));
+	destructor->next = mDestructors;
+	destructor->object = object;
+	destructor->destroy = destroy;
+	mDestructors = destructor;
+}
+
+void ModuleArena::clear ()
+{
+	// destroys the objects in reverse order of creation
+	for (Destructor *destructor=mDestructors;destructor;destructor=destructor->next)
+	{
+		destructor->destroy (destructor->object);
+	}
+	mDestructors = 0;
+	while (mBlocks)
+	{
+		Block *next = mBlocks->next;
+		std::free (mBlocks);
+		mBlocks = next;
+	}
+	mCurrent = 0;
+	mRemaining = 0;
+	mAllocatedSize = 0;
+}
+
+ModuleArena::~ModuleArena ()
+{
+	clear ();
+}
+
+};
+};
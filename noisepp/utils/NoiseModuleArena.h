@@ -0,0 +1,101 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISEMODULEARENA_H
+#define NOISEMODULEARENA_H
+
+#include <new>
+#include "NoisePrerequisites.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Arena for allocating modules.
+/// Objects are placed one after another in large blocks. Clearing the arena runs the destructors
+/// and frees the blocks at once instead of freeing every object on its own.
+/// The arena isn't thread safe, use one arena per thread.
+class ModuleArena
+{
+	public:
+		/// Constructor.
+		/// @param blockSize The size of the blocks in bytes.
+		ModuleArena (size_t blockSize=16*1024);
+		/// Constructs an object of the specified type in the arena.
+		/// The object is destroyed when the arena is cleared.
+		template <class T>
+		T *create ()
+		{
+			T *object = new (allocate (sizeof(T))) T;
+			addDestructor (object, &destroy<T>);
+			return object;
+		}
+		/// Allocates raw memory, 16 byte aligned. The memory is released when the arena is cleared.
+		void *allocate (size_t size);
+		/// Destroys all objects and frees the memory.
+		void clear ();
+		/// Returns the number of bytes allocated from the arena.
+		size_t getAllocatedSize () const
+		{
+			return mAllocatedSize;
+		}
+		/// Destructor.
+		~ModuleArena ();
+	protected:
+	private:
+		struct Block
+		{
+			Block *next;
+		};
+		struct Destructor
+		{
+			Destructor *next;
+			void *object;
+			void (*destroy) (void *object);
+		};
+
+		size_t mBlockSize;
+		Block *mBlocks;
+		char *mCurrent;
+		size_t mRemaining;
+		Destructor *mDestructors;
+		size_t mAllocatedSize;
+
+		void addDestructor (void *object, void (*destroy) (void *object));
+		template <class T>
+		static void destroy (void *object)
+		{
+			static_cast<T *>(object)->~T();
+		}
+
+		ModuleArena (const ModuleArena &);
+		ModuleArena &operator= (const ModuleArena &);
+};
+
+};
+};
+
+#endif // NOISEMODULEARENA_H
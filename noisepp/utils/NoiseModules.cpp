@@ -216,6 +216,22 @@ void TranslatePointModule::read (utils::InStream &s)
 	mTranslationZ = static_cast<Real>(s.readDouble ());
 }
 
+void TransformPointModule::write (utils::OutStream &s) const
+{
+	for (int i=0;i<12;++i)
+	{
+		s.writeDouble (mMatrix.m[i]);
+	}
+}
+
+void TransformPointModule::read (utils::InStream &s)
+{
+	for (int i=0;i<12;++i)
+	{
+		mMatrix.m[i] = static_cast<Real>(s.readDouble ());
+	}
+}
+
 void TurbulenceModule::write (utils::OutStream &s) const
 {
 	s.writeDouble (mPower);
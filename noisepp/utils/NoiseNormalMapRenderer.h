@@ -0,0 +1,53 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISENORMALMAPRENDERER_H
+#define NOISENORMALMAPRENDERER_H
+
+#include "NoiseHeightmapRenderer.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// Normal map renderer.
+/// Writes the unit normals of a heightmap as RGB, each component mapped from [-1, 1] to [0, 255].
+class NormalMapRenderer : public HeightmapRenderer
+{
+	protected:
+		/// @copydoc noisepp::utils::HeightmapRenderer::shadeSpan()
+		virtual void shadeSpan (const Real *gradientX, const Real *gradientY, int count, unsigned char *buffer, PixelFormat format) const;
+		/// Normal maps need a colour format.
+		virtual bool isFormatSupported (PixelFormat format) const
+		{
+			return Image::isColourFormat (format);
+		}
+};
+
+};
+};
+
+#endif // NOISENORMALMAPRENDERER_H
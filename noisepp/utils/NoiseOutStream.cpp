@@ -26,8 +26,11 @@
 #include <cassert>
 #include "NoiseOutStream.h"
 #include "NoiseEndianUtils.h"
+#include "NoisePrerequisites.h"
+#include <new>
 
 #define BLOCK_SIZE 1024
+#define FILE_BUFFER_SIZE (1024*1024)
 
 namespace noisepp
 {
@@ -42,17 +45,23 @@ OutStream::~OutStream()
 {
 }
 
-FileOutStream::FileOutStream ()
+FileOutStream::FileOutStream () : mBuffer(FILE_BUFFER_SIZE), mBufferPosition(0)
 {
 }
 
-FileOutStream::FileOutStream(const std::string &filename)
+FileOutStream::FileOutStream(const std::string &filename) : mBuffer(FILE_BUFFER_SIZE), mBufferPosition(0)
 {
 	open (filename);
 }
 
+FileOutStream::~FileOutStream()
+{
+	flush ();
+}
+
 bool FileOutStream::open (const std::string &filename)
 {
+	flush ();
 	mFile.open (filename.c_str(), std::ios::binary);
 	return mFile.is_open ();
 }
@@ -64,21 +73,52 @@ bool FileOutStream::isOpen ()
 
 void FileOutStream::close ()
 {
+	flush ();
 	mFile.close ();
 }
 
+void FileOutStream::flush ()
+{
+	if (mBufferPosition > 0)
+	{
+		mFile.write (&mBuffer[0], (std::streamsize)mBufferPosition);
+		mBufferPosition = 0;
+	}
+}
+
+void FileOutStream::setBufferSize (size_t size)
+{
+	flush ();
+	mBuffer.resize (size);
+}
+
 void FileOutStream::write (const void *buffer, size_t len)
 {
-	mFile.write ((const char*)buffer, (std::streamsize)len);
+	if (mBufferPosition+len <= mBuffer.size())
+	{
+		std::memcpy (&mBuffer[mBufferPosition], buffer, len);
+		mBufferPosition += len;
+		return;
+	}
+	flush ();
+	// blocks that don't fit into the buffer go straight to the file
+	if (len >= mBuffer.size())
+		mFile.write ((const char*)buffer, (std::streamsize)len);
+	else
+	{
+		std::memcpy (&mBuffer[0], buffer, len);
+		mBufferPosition = len;
+	}
 }
 
 size_t FileOutStream::tell ()
 {
-	return mFile.tellp ();
+	return size_t(mFile.tellp ()) + mBufferPosition;
 }
 
 void FileOutStream::seek (size_t pos)
 {
+	flush ();
 	mFile.seekp ((std::streamoff)pos);
 }
 
@@ -101,14 +141,51 @@ void MemoryOutStream::clear ()
 	mPosition = mSize = mRealSize = 0;
 }
 
+void MemoryOutStream::grow (size_t capacity)
+{
+	// at least double the buffer
+	size_t size = mRealSize * 2;
+	if (size < BLOCK_SIZE)
+		size = BLOCK_SIZE;
+	if (size < capacity)
+		size = capacity;
+	reserve (size);
+}
+
+void MemoryOutStream::reserve (size_t capacity)
+{
+	if (capacity <= mRealSize)
+		return;
+	char *buffer = (char *)std::realloc (mBuffer, capacity);
+	if (!buffer)
+		throw std::bad_alloc ();
+	mBuffer = buffer;
+	mRealSize = capacity;
+}
+
+void MemoryOutStream::adopt (char *buffer, size_t size, size_t capacity)
+{
+	NoiseAssert (size <= capacity, size);
+	NoiseAssert (buffer != NULL || capacity == 0, buffer);
+	clear ();
+	mBuffer = buffer;
+	mPosition = mSize = size;
+	mRealSize = capacity;
+}
+
+char *MemoryOutStream::release ()
+{
+	char *buffer = mBuffer;
+	mBuffer = NULL;
+	mPosition = mSize = mRealSize = 0;
+	return buffer;
+}
+
 void MemoryOutStream::write (const void *buffer, size_t len)
 {
 	assert (len > 0);
-	if (mPosition+len > mRealSize || mBuffer == NULL)
-	{
-		mRealSize += BLOCK_SIZE;
-		mBuffer = (char *)std::realloc (mBuffer, mRealSize);
-	}
+	if (mPosition+len > mRealSize)
+		grow (mPosition+len);
 	std::memcpy (mBuffer+mPosition, buffer, len);
 	mPosition += len;
 	if (mPosition > mSize)
@@ -30,6 +30,7 @@
 #include <cstring>
 #include <string>
 #include <fstream>
+#include <vector>
 
 #include "NoiseEndianUtils.h"
 
@@ -75,10 +76,13 @@ class OutStream
 };
 
 /// Stream for writing to files.
+/// Writes are collected in a large buffer and handed to the file in blocks, so writing many small values is cheap.
 class FileOutStream : public OutStream
 {
 	private:
 		std::ofstream mFile;
+		std::vector<char> mBuffer;
+		size_t mBufferPosition;
 	public:
 		/// Constructor.
 		FileOutStream();
@@ -93,6 +97,13 @@ class FileOutStream : public OutStream
 		bool isOpen ();
 		/// Close the current file.
 		void close ();
+		/// Writes the buffered data to the file.
+		void flush ();
+		/// Sets the size of the write buffer in bytes (default 1 MiB).
+		/// Passing 0 disables the buffer.
+		void setBufferSize (size_t size);
+		/// Destructor.
+		virtual ~FileOutStream();
 		/// @copydoc noisepp::utils::OutStream::write(T)
 		template <class T>
 		void write (T t)
@@ -109,16 +120,34 @@ class FileOutStream : public OutStream
 };
 
 /// Stream for writing to memory.
+/// The buffer grows geometrically, so writing n bytes takes amortized O(n) time.
 class MemoryOutStream : public OutStream
 {
 	private:
 		char *mBuffer;
 		size_t mPosition, mSize, mRealSize;
+
+		void grow (size_t capacity);
 	public:
 		/// Constructor.
 		MemoryOutStream ();
 		/// Clears the buffer.
 		void clear ();
+		/// Makes sure the buffer can hold at least the specified number of bytes without growing.
+		void reserve (size_t capacity);
+		/// Returns the number of bytes the buffer can hold without growing.
+		size_t getCapacity () const
+		{
+			return mRealSize;
+		}
+		/// Takes ownership of a buffer allocated with std::malloc(), the previous buffer is freed.
+		/// Writing continues at the end of the data.
+		/// @param buffer The buffer.
+		/// @param size The number of bytes of data in the buffer.
+		/// @param capacity The allocated size of the buffer.
+		void adopt (char *buffer, size_t size, size_t capacity);
+		/// Hands the buffer to the caller, who has to free it with std::free(). The stream is empty afterwards.
+		char *release ();
 		/// Returns a pointer to the buffer.
 		char *getBuffer ()
 		{
@@ -134,7 +163,12 @@ class MemoryOutStream : public OutStream
 		void write (T t)
 		{
 			EndianUtils::flipEndian (&t, sizeof(T));
-			write (&t, sizeof(T));
+			if (mPosition+sizeof(T) > mRealSize)
+				grow (mPosition+sizeof(T));
+			std::memcpy (mBuffer+mPosition, &t, sizeof(T));
+			mPosition += sizeof(T);
+			if (mPosition > mSize)
+				mSize = mPosition;
 		}
 		/// Destructor.
 		virtual ~MemoryOutStream ();
@@ -34,11 +34,16 @@ namespace noisepp
 namespace utils
 {
 
-Reader::Reader (InStream &stream) : mStream(stream), mModuleCount(0)
+Reader::Reader (InStream &stream, ModuleArena *arena) : mStream(stream), mModuleCount(0), mArena(arena)
 {
 	unsigned char ver;
 	stream.read (ver);
-	if (ver != NOISE_FILE_VERSION)
+	if (ver == 2)
+	{
+		readVersion2 ();
+		return;
+	}
+	if (ver != 1)
 		throw ReaderException ("Input file has wrong version");
 	stream.read (mModuleCount);
 	for (unsigned short i=0;i<mModuleCount;++i)
@@ -51,88 +56,171 @@ Reader::Reader (InStream &stream) : mStream(stream), mModuleCount(0)
 	}
 }
 
+void Reader::readVersion2 ()
+{
+	// the rest of the header
+	unsigned char header[NOISE_FILE_V2_HEADER_SIZE];
+	header[0] = 2;
+	mStream.read (header+1, NOISE_FILE_V2_HEADER_SIZE-1);
+	const size_t size = FileFormat::readLE32 (header+4);
+	const unsigned moduleCount = FileFormat::readLE32 (header+8);
+	const size_t sourceCount = FileFormat::readLE32 (header+12);
+	const size_t paramOffset = FileFormat::readLE32 (header+16);
+	const size_t paramSize = FileFormat::readLE32 (header+20);
+	const size_t tableOffset = NOISE_FILE_V2_HEADER_SIZE;
+	const size_t sourceOffset = tableOffset + size_t(moduleCount) * NOISE_FILE_V2_MODULE_SIZE;
+	if (moduleCount == 0 || moduleCount > 0xffff || sourceOffset + sourceCount * 4 > paramOffset ||
+		paramOffset + paramSize != size)
+		throw ReaderException ("Invalid file header");
+	mModuleCount = (unsigned short)moduleCount;
+
+	// the remaining data in one block, streams over memory hand it out without copying
+	const size_t remaining = size - NOISE_FILE_V2_HEADER_SIZE;
+	std::vector<char> buffer;
+	const char *view = mStream.view (remaining);
+	if (!view)
+	{
+		buffer.resize (remaining);
+		mStream.read (&buffer[0], remaining);
+		view = &buffer[0];
+	}
+	// the offsets in the file count from its start, the block starts after the header
+	const unsigned char *table = (const unsigned char *)view;
+	const unsigned char *sources = table + (sourceOffset - tableOffset);
+	const unsigned char *params = table + (paramOffset - tableOffset);
+
+	mModules.reserve (mModuleCount);
+	for (unsigned i=0;i<moduleCount;++i)
+	{
+		const unsigned char *entry = table + i*NOISE_FILE_V2_MODULE_SIZE;
+		const unsigned short typeID = FileFormat::readLE16 (entry);
+		const size_t offset = FileFormat::readLE32 (entry+8);
+		const size_t length = FileFormat::readLE32 (entry+12);
+		if (offset + length > paramSize)
+			throw ReaderException ("Invalid module parameters");
+		Module *module = createModule (typeID);
+		if (!module)
+			throw ReaderException ("Invalid module type ID");
+		mModules.push_back (module);
+		MemoryInStream stream;
+		stream.open (const_cast<char *>((const char *)params + offset), length);
+		module->read (stream);
+		if (stream.getRemaining ())
+			throw ReaderException ("Invalid module parameters");
+	}
+	for (unsigned i=0;i<moduleCount;++i)
+	{
+		const unsigned char *entry = table + i*NOISE_FILE_V2_MODULE_SIZE;
+		Module *module = mModules[i];
+		const size_t count = FileFormat::readLE16 (entry+2);
+		const size_t firstSource = FileFormat::readLE32 (entry+4);
+		if (count != module->getSourceModuleCount() || firstSource + count > sourceCount)
+			throw ReaderException ("Wrong child attribute");
+		for (size_t j=0;j<count;++j)
+		{
+			const unsigned childID = FileFormat::readLE32 (sources + (firstSource+j)*4);
+			if (childID >= moduleCount)
+				throw ReaderException ("Wrong child attribute");
+			Module *child = getModule ((unsigned short)childID);
+			if (!child)
+				throw ReaderException ("Wrong child attribute");
+			module->setSourceModule (j, child);
+		}
+	}
+}
+
 void Reader::readModule ()
 {
 	unsigned short typeID;
 	mStream.read (typeID);
+	Module *module = createModule (typeID);
+	if (!module)
+		throw ReaderException ("Invalid module type ID");
+	assert (module->getType() == typeID);
+	module->read (mStream);
+	mModules.push_back (module);
+}
+
+Module *Reader::createModule (unsigned short typeID)
+{
 	Module *module = NULL;
 	switch (typeID)
 	{
 		case MODULE_PERLIN:
-			module = new PerlinModule;
+			module = construct<PerlinModule> ();
 			break;
 		case MODULE_BILLOW:
-			module = new BillowModule;
+			module = construct<BillowModule> ();
 			break;
 		case MODULE_ADDITION:
-			module = new AdditionModule;
+			module = construct<AdditionModule> ();
 			break;
 		case MODULE_ABSOLUTE:
-			module = new AbsoluteModule;
+			module = construct<AbsoluteModule> ();
 			break;
 		case MODULE_BLEND:
-			module = new BlendModule;
+			module = construct<BlendModule> ();
 			break;
 		case MODULE_CHECKERBOARD:
-			module = new CheckerboardModule;
+			module = construct<CheckerboardModule> ();
 			break;
 		case MODULE_CLAMP:
-			module = new ClampModule;
+			module = construct<ClampModule> ();
 			break;
 		case MODULE_CONSTANT:
-			module = new ConstantModule;
+			module = construct<ConstantModule> ();
 			break;
 		case MODULE_CURVE:
-			module = new CurveModule;
+			module = construct<CurveModule> ();
 			break;
 		case MODULE_EXPONENT:
-			module = new ExponentModule;
+			module = construct<ExponentModule> ();
 			break;
 		case MODULE_INVERT:
-			module = new InvertModule;
+			module = construct<InvertModule> ();
 			break;
 		case MODULE_MAXIMUM:
-			module = new MaximumModule;
+			module = construct<MaximumModule> ();
 			break;
 		case MODULE_MINIMUM:
-			module = new MinimumModule;
+			module = construct<MinimumModule> ();
 			break;
 		case MODULE_MULTIPLY:
-			module = new MultiplyModule;
+			module = construct<MultiplyModule> ();
 			break;
 		case MODULE_POWER:
-			module = new PowerModule;
+			module = construct<PowerModule> ();
 			break;
 		case MODULE_RIDGEDMULTI:
-			module = new RidgedMultiModule;
+			module = construct<RidgedMultiModule> ();
 			break;
 		case MODULE_SCALEBIAS:
-			module = new ScaleBiasModule;
+			module = construct<ScaleBiasModule> ();
 			break;
 		case MODULE_SELECT:
-			module = new SelectModule;
+			module = construct<SelectModule> ();
 			break;
 		case MODULE_SCALEPOINT:
-			module = new ScalePointModule;
+			module = construct<ScalePointModule> ();
 			break;
 		case MODULE_TURBULENCE:
-			module = new TurbulenceModule;
+			module = construct<TurbulenceModule> ();
 			break;
 		case MODULE_TERRACE:
-			module = new TerraceModule;
+			module = construct<TerraceModule> ();
 			break;
 		case MODULE_TRANSLATEPOINT:
-			module = new TranslatePointModule;
+			module = construct<TranslatePointModule> ();
 			break;
 		case MODULE_VORONOI:
-			module = new VoronoiModule;
+			module = construct<VoronoiModule> ();
+			break;
+		case MODULE_TRANSFORMPOINT:
+			module = construct<TransformPointModule> ();
 			break;
 	}
-	if (!module)
-		throw ReaderException ("Invalid module type ID");
-	assert (module->getType() == typeID);
-	module->read (mStream);
-	mModules.push_back (module);
+	assert (!module || module->getType() == typeID);
+	return module;
 }
 
 void Reader::readModuleRel (Module *module)
@@ -158,9 +246,12 @@ Module *Reader::getModule (unsigned short id)
 
 Reader::~Reader ()
 {
-	for (ModuleVector::iterator it=mModules.begin();it!=mModules.end();++it)
+	if (!mArena)
 	{
-		delete *it;
+		for (ModuleVector::iterator it=mModules.begin();it!=mModules.end();++it)
+		{
+			delete *it;
+		}
 	}
 	mModules.clear ();
 }
@@ -30,6 +30,7 @@
 
 #include "NoiseModule.h"
 #include "NoiseInStream.h"
+#include "NoiseModuleArena.h"
 
 namespace noisepp
 {
@@ -37,6 +38,8 @@ namespace utils
 {
 
 /// Class for reading a pipeline from a stream or file.
+/// Reads version 1 and 2 files. Version 2 files are read with a single read() call,
+/// or without copying at all from a MemoryInStream (e.g. over a memory-mapped file).
 class Reader
 {
 	private:
@@ -46,13 +49,25 @@ class Reader
 
 		typedef std::vector<Module*> ModuleVector;
 		ModuleVector mModules;
+		ModuleArena *mArena;
 
 		void readModule ();
 		void readModuleRel (Module *module);
+		void readVersion2 ();
+		Module *createModule (unsigned short typeID);
+		template <class T>
+		Module *construct ()
+		{
+			if (mArena)
+				return mArena->create<T> ();
+			return new T;
+		}
 	public:
 		/// Constructor.
 		/// @param stream A reference to the stream to read from.
-		Reader (InStream &stream);
+		/// @param arena If not NULL, the modules are constructed in this arena and belong to it
+		/// instead of the reader, so they stay valid until the arena is cleared.
+		Reader (InStream &stream, ModuleArena *arena=0);
 		/// Destructor.
 		~Reader ();
 		/// Returns a pointer to the module with the specified ID or NULL if it does not exist.
@@ -30,8 +30,11 @@
 #	include "NoiseThreadedPipeline.h"
 #endif
 
+#include <cstdio>
+
 #if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
 #	include <unistd.h>
+#	include <pthread.h>
 #elif NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
 #	define WIN32_LEAN_AND_MEAN
 #	include <windows.h>
@@ -55,6 +58,17 @@ int System::calculateNumberOfCPUs()
 #endif
 }
 
+std::string System::getTempFilename (const std::string &filename)
+{
+	char suffix[64];
+#if NOISEPP_PLATFORM == NOISEPP_PLATFORM_UNIX
+	std::sprintf (suffix, ".%lu.%lx.tmp", (unsigned long)getpid(), (unsigned long)pthread_self());
+#elif NOISEPP_PLATFORM == NOISEPP_PLATFORM_WINDOWS
+	std::sprintf (suffix, ".%lu.%lu.tmp", (unsigned long)GetCurrentProcessId(), (unsigned long)GetCurrentThreadId());
+#endif
+	return filename + suffix;
+}
+
 int System::getNumberOfCPUs()
 {
 	return mNumberOfCPUs;
@@ -26,6 +26,8 @@
 #ifndef NOISESYSTEM_H
 #define NOISESYSTEM_H
 
+#include <string>
+
 #include "NoisePipeline.h"
 #include "NoiseJobQueue.h"
 
@@ -48,6 +50,9 @@ class System
 		static Pipeline3D *createOptimalPipeline3D ();
 		/// Creates an optimal job queue using as many threads as there are CPU cores avaible.
 		static JobQueue *createOptimalJobQueue ();
+		/// Returns a temporary file name for writing the specified file, unique to the calling process and thread.
+		/// Files are written under this name and renamed when complete, so concurrent writers don't clobber each other.
+		static std::string getTempFilename (const std::string &filename);
 	protected:
 	private:
 		static int mNumberOfCPUs;
@@ -0,0 +1,167 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "NoiseTileCache.h"
+#include "NoiseInStream.h"
+#include "NoiseOutStream.h"
+#include "NoiseFileFormat.h"
+#include "NoiseSystem.h"
+#include <cstdio>
+
+namespace noisepp
+{
+namespace utils
+{
+
+namespace
+{
+
+const char TILECACHE_MAGIC[4] = { 'N', 'P', 'T', 'C' };
+const unsigned TILECACHE_VERSION = 1;
+const size_t TILECACHE_HEADER_SIZE = 32;
+
+void writeHeader (unsigned char *header, GraphHash::Value key, size_t count)
+{
+	const unsigned long long count64 = count;
+	std::memcpy (header, TILECACHE_MAGIC, sizeof(TILECACHE_MAGIC));
+	FileFormat::writeLE32 (header+4, TILECACHE_VERSION);
+	FileFormat::writeLE32 (header+8, unsigned(sizeof(Real)));
+	FileFormat::writeLE32 (header+12, 0);
+	FileFormat::writeLE32 (header+16, unsigned(count64 & 0xffffffffULL));
+	FileFormat::writeLE32 (header+20, unsigned(count64 >> 32));
+	FileFormat::writeLE32 (header+24, unsigned(key & 0xffffffffULL));
+	FileFormat::writeLE32 (header+28, unsigned(key >> 32));
+}
+
+};
+
+TileCache::TileCache (const std::string &directory) : mDirectory(directory)
+{
+	if (!mDirectory.empty() && mDirectory[mDirectory.size()-1] != '/' && mDirectory[mDirectory.size()-1] != '\\')
+		mDirectory += '/';
+}
+
+GraphHash::Value TileCache::calcKey (const PlaneBuilder2D &builder, const Module &module, int seed)
+{
+	GraphHash hash;
+	hash.addModule (module);
+	hash.addInt (seed);
+	hash.addInt (builder.getWidth ());
+	hash.addInt (builder.getHeight ());
+	hash.addReal (builder.getLowerBoundX ());
+	hash.addReal (builder.getLowerBoundY ());
+	hash.addReal (builder.getUpperBoundX ());
+	hash.addReal (builder.getUpperBoundY ());
+	hash.addInt (builder.isSeamless () ? 1 : 0);
+	return hash.getValue ();
+}
+
+std::string TileCache::getFilename (GraphHash::Value key) const
+{
+	char name[32];
+	std::sprintf (name, "%08x%08x.tile", unsigned(key >> 32), unsigned(key & 0xffffffffULL));
+	return mDirectory + name;
+}
+
+bool TileCache::load (GraphHash::Value key, Real *dest, size_t count) const
+{
+	NoiseAssert (dest != NULL, dest);
+	FileInStream stream(getFilename (key));
+	if (!stream.isOpen ())
+		return false;
+	unsigned char header[TILECACHE_HEADER_SIZE];
+	unsigned char expected[TILECACHE_HEADER_SIZE];
+	writeHeader (expected, key, count);
+	try
+	{
+		stream.read (header, sizeof(header));
+		if (std::memcmp (header, expected, sizeof(header)) != 0)
+			return false;
+		stream.read (dest, count * sizeof(Real));
+	}
+	catch (std::exception &)
+	{
+		return false;
+	}
+	// truncated files
+	return stream.tell () == TILECACHE_HEADER_SIZE + count * sizeof(Real);
+}
+
+bool TileCache::store (GraphHash::Value key, const Real *data, size_t count) const
+{
+	NoiseAssert (data != NULL, data);
+	const std::string filename = getFilename (key);
+	const std::string tempname = System::getTempFilename (filename);
+	{
+		FileOutStream stream;
+		if (!stream.open (tempname))
+			return false;
+		unsigned char header[TILECACHE_HEADER_SIZE];
+		writeHeader (header, key, count);
+		stream.write (header, sizeof(header));
+		stream.write (data, count * sizeof(Real));
+		const bool complete = (stream.tell () == TILECACHE_HEADER_SIZE + count * sizeof(Real));
+		stream.close ();
+		if (!complete)
+		{
+			std::remove (tempname.c_str ());
+			return false;
+		}
+	}
+	if (std::rename (tempname.c_str (), filename.c_str ()) != 0)
+	{
+		// an other process may have stored the same key in the meantime
+		std::remove (filename.c_str ());
+		if (std::rename (tempname.c_str (), filename.c_str ()) != 0)
+		{
+			std::remove (tempname.c_str ());
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TileCache::build (PlaneBuilder2D &builder)
+{
+	const Module *module = builder.getModule ();
+	Real *dest = builder.getDestination ();
+	NoiseAssert (module != NULL, module);
+	NoiseAssert (dest != NULL, dest);
+	if (builder.hasGradientDestination ())
+	{
+		builder.build ();
+		return false;
+	}
+	const GraphHash::Value key = calcKey (builder, *module);
+	const size_t count = size_t(builder.getWidth ()) * size_t(builder.getHeight ());
+	if (load (key, dest, count))
+		return true;
+	builder.build ();
+	store (key, dest, count);
+	return false;
+}
+
+};
+};
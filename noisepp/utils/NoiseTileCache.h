@@ -0,0 +1,76 @@
+// Noise++ Library
+// Copyright (c) 2008, Urs C. Hanselmann
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice,
+//      this list of conditions and the following disclaimer in the documentation
+//      and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NOISETILECACHE_H
+#define NOISETILECACHE_H
+
+#include <string>
+
+#include "NoiseGraphHash.h"
+#include "NoiseBuilders.h"
+
+namespace noisepp
+{
+namespace utils
+{
+
+/// On-disk cache for built planes.
+/// Each result is stored in a file of its own in the cache directory, named after a key built from the hash of the
+/// module graph, the pipeline seed, the output size and the bounds. Identical requests are loaded from disk
+/// instead of being built again. The files hold Real values, so caches aren't shared between precisions.
+class TileCache
+{
+	public:
+		/// Constructor.
+		/// @param directory The cache directory, which has to exist.
+		TileCache (const std::string &directory);
+		/// Returns the cache key of a plane builder.
+		/// @param builder The builder, the size, bounds and seamless setting are part of the key.
+		/// @param module The source module.
+		/// @param seed The master seed of the pipeline the plane is built with.
+		static GraphHash::Value calcKey (const PlaneBuilder2D &builder, const Module &module, int seed=0);
+		/// Returns the file name of the specified key.
+		std::string getFilename (GraphHash::Value key) const;
+		/// Loads the values of the specified key.
+		/// Returns false if the cache doesn't hold the key with the specified number of values.
+		bool load (GraphHash::Value key, Real *dest, size_t count) const;
+		/// Stores the values of the specified key.
+		/// The file is written under a temporary name unique to the process and thread and renamed, so readers never see
+		/// partial files and concurrent writers don't truncate each other.
+		/// Returns false if the file can't be written.
+		bool store (GraphHash::Value key, const Real *data, size_t count) const;
+		/// Loads the plane from the cache or builds and stores it.
+		/// Builders with a gradient destination are always built without the cache.
+		/// Returns true if the plane was loaded from the cache.
+		bool build (PlaneBuilder2D &builder);
+	protected:
+	private:
+		std::string mDirectory;
+};
+
+};
+};
+
+#endif // NOISETILECACHE_H
@@ -30,18 +30,27 @@
 #error "Please set NOISEPP_ENABLE_UTILS to 1"
 #endif
 
-#define NOISE_FILE_VERSION 1
-
+#include "NoiseFileFormat.h"
 #include "NoiseEndianUtils.h"
 #include "NoiseInStream.h"
 #include "NoiseOutStream.h"
 #include "NoiseWriter.h"
 #include "NoiseReader.h"
+#include "NoiseBatchReader.h"
 #include "NoiseColourValue.h"
 #include "NoiseImage.h"
 #include "NoiseSystem.h"
 #include "NoiseJobQueue.h"
 #include "NoiseGradientRenderer.h"
+#include "NoiseHeightmapRenderer.h"
+#include "NoiseNormalMapRenderer.h"
+#include "NoiseHillshadeRenderer.h"
+#include "NoiseHeightmapExporter.h"
+#include "NoiseMappedFile.h"
 #include "NoiseBuilders.h"
+#include "NoiseGraphHash.h"
+#include "NoiseTileCache.h"
+#include "NoiseExpression.h"
+#include "NoiseJitCompiler.h"
 
 #endif // NOISEUTILS_H
@@ -85,13 +85,20 @@ void Writer::writeModuleRel (const Module *module)
 	}
 }
 
-void Writer::writePipeline ()
+void Writer::writePipeline (unsigned char version)
 {
 	NoiseAssert (!mModuleVec.empty(), mModuleVec);
 	NoiseAssert (mModuleCount == mModules.size(), mModuleCount);
 	NoiseAssert (mModuleCount == mModuleVec.size(), mModuleCount);
+	NoiseAssert (version == 1 || version == 2, version);
 
-	unsigned char ver = NOISE_FILE_VERSION;
+	if (version == 2)
+	{
+		writePipelineVersion2 ();
+		return;
+	}
+
+	unsigned char ver = 1;
 	mStream.write (ver);
 	mStream.write (mModuleCount);
 	// writing module properties
@@ -102,5 +109,63 @@ void Writer::writePipeline ()
 		writeModuleRel(*it);
 }
 
+void Writer::writePipelineVersion2 ()
+{
+	// the module fields are serialized first, they are stored as they are in the parameter block
+	MemoryOutStream params;
+	std::vector<unsigned> paramOffsets;
+	std::vector<unsigned> paramSizes;
+	size_t sourceCount = 0;
+	for (ModuleVector::iterator it=mModuleVec.begin();it!=mModuleVec.end();++it)
+	{
+		const size_t offset = params.tell ();
+		(*it)->write (params);
+		paramOffsets.push_back (unsigned(offset));
+		paramSizes.push_back (unsigned(params.tell() - offset));
+		// every module starts 8 byte aligned
+		const char padding[8] = {0};
+		if (params.tell() % 8)
+			params.write (padding, 8 - params.tell() % 8);
+		sourceCount += (*it)->getSourceModuleCount ();
+	}
+
+	const size_t tableOffset = NOISE_FILE_V2_HEADER_SIZE;
+	const size_t sourceOffset = tableOffset + size_t(mModuleCount) * NOISE_FILE_V2_MODULE_SIZE;
+	const size_t paramOffset = (sourceOffset + sourceCount * 4 + 7) & ~size_t(7);
+	const size_t size = paramOffset + params.getBufferSize ();
+	std::vector<unsigned char> data(size, 0);
+
+	// header
+	data[0] = 2;
+	FileFormat::writeLE32 (&data[4], unsigned(size));
+	FileFormat::writeLE32 (&data[8], mModuleCount);
+	FileFormat::writeLE32 (&data[12], unsigned(sourceCount));
+	FileFormat::writeLE32 (&data[16], unsigned(paramOffset));
+	FileFormat::writeLE32 (&data[20], unsigned(params.getBufferSize ()));
+
+	// module table and source indices
+	unsigned firstSource = 0;
+	for (size_t i=0;i<mModuleVec.size();++i)
+	{
+		const Module *module = mModuleVec[i];
+		unsigned char *entry = &data[tableOffset + i*NOISE_FILE_V2_MODULE_SIZE];
+		const unsigned count = unsigned(module->getSourceModuleCount ());
+		FileFormat::writeLE16 (entry, module->getType ());
+		FileFormat::writeLE16 (entry+2, (unsigned short)count);
+		FileFormat::writeLE32 (entry+4, firstSource);
+		FileFormat::writeLE32 (entry+8, paramOffsets[i]);
+		FileFormat::writeLE32 (entry+12, paramSizes[i]);
+		for (unsigned j=0;j<count;++j)
+		{
+			FileFormat::writeLE32 (&data[sourceOffset + (firstSource+j)*4], getModuleID (module->getSourceModule (j)));
+		}
+		firstSource += count;
+	}
+
+	if (params.getBufferSize ())
+		std::memcpy (&data[paramOffset], params.getBuffer (), params.getBufferSize ());
+	mStream.write (&data[0], size);
+}
+
 };
 };
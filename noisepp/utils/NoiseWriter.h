@@ -31,6 +31,7 @@
 
 #include "NoiseModule.h"
 #include "NoiseOutStream.h"
+#include "NoiseFileFormat.h"
 
 namespace noisepp
 {
@@ -52,6 +53,7 @@ class Writer
 
 		void writeModule (const Module *module);
 		void writeModuleRel (const Module *module);
+		void writePipelineVersion2 ();
 	public:
 		/// Constructor.
 		/// @param stream A reference to the stream the output will be written to.
@@ -65,7 +67,9 @@ class Writer
 		unsigned short getModuleID (const Module *module);
 
 		/// Writes the final pipeline to the stream specified in the constructor.
-		void writePipeline ();
+		/// @param version The file format version, 1 writes the module fields one by one,
+		/// 2 writes a flat little-endian block that is loaded with a single read (see Reader).
+		void writePipeline (unsigned char version=NOISE_FILE_VERSION);
 };
 
 };
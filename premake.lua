@@ -13,6 +13,7 @@ dopackage("examples/tutorial5")
 dopackage("examples/tutorial6")
 dopackage("examples/toimage")
 dopackage("examples/test")
+dopackage("examples/benchmark")
 
 function domakeall(cmd, arg)
     os.execute("premake --usetargetpath --target vs2002 --os windows")